@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file           : clock_profile.h
+  * @brief          : En-tête pour les profils d'horloge
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les prototypes des fonctions qui choisissent la
+  * fréquence du cœur parmi quelques profils (HSI seul, PLL intermédiaire,
+  * PLL à 216 MHz avec overdrive), à la compilation (CLOCK_PROFILE_DEFAULT)
+  * ou en cours de fonctionnement. Les diviseurs des timers et le débit de
+  * l'UART suivent automatiquement le profil.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CLOCK_PROFILE_H
+#define __CLOCK_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Profils d'horloge */
+typedef enum {
+  CLOCK_PROFILE_LOW = 0,      // HSI 16 MHz, sans PLL (configuration CubeMX)
+  CLOCK_PROFILE_BALANCED,     // PLL 96 MHz, échelle de tension 3
+  CLOCK_PROFILE_FULL,         // PLL 216 MHz, échelle 1 et overdrive
+  CLOCK_PROFILE_COUNT
+} Clock_Profile;
+
+/* Description d'un profil */
+typedef struct {
+  const char *name;           // Nom (argument de la commande CLOCK)
+  uint32_t sysclkHz;          // Fréquence du cœur (HCLK)
+  uint32_t pclk1Hz;           // Bus APB1 (USART3, TIM2/3/4/12)
+  uint32_t pclk2Hz;           // Bus APB2 (TIM8)
+  uint8_t flashLatency;       // États d'attente de la flash
+  uint8_t voltageScale;       // Échelle de tension du régulateur (1 à 3)
+  bool overdrive;             // Overdrive du régulateur
+} Clock_ProfileInfo;
+
+/* Mesures d'un profil (Clock_Benchmark) */
+typedef struct {
+  uint32_t lineCycles;        // Cycles pour analyser la ligne de référence
+  uint32_t lineLength;        // Octets de la ligne de référence
+  uint32_t isrCycles;         // Latence d'entrée en interruption (minimum, 0 : non servie)
+  uint32_t maxBaud;           // Débit de réception soutenable (bauds)
+} Clock_BenchResult;
+
+/* Charge mesurée par Clock_Benchmark (une exécution) */
+typedef void (*Clock_Workload)(void);
+
+/* Exported constants --------------------------------------------------------*/
+/* Profil appliqué au démarrage */
+#ifndef CLOCK_PROFILE_DEFAULT
+#define CLOCK_PROFILE_DEFAULT   CLOCK_PROFILE_LOW
+#endif
+
+/* Caches L1 et accélérateur ART de la flash (1 : activés au démarrage) */
+#ifndef CLOCK_USE_ICACHE
+#define CLOCK_USE_ICACHE        1
+#endif
+#ifndef CLOCK_USE_DCACHE
+#define CLOCK_USE_DCACHE        1
+#endif
+#ifndef CLOCK_USE_ART
+#define CLOCK_USE_ART           1
+#endif
+
+#define CLOCK_BENCH_RUNS        64      // Exécutions de la charge par profil
+#define CLOCK_BENCH_ISR_SAMPLES 16      // Mesures de latence par profil
+#define CLOCK_BENCH_ISR_TIMEOUT 1000000u // Attente maximale de la sonde (cycles)
+
+/* Interruption mise en attente par logiciel pour mesurer la latence
+ * (vecteur EXTI0 : aucune ligne EXTI n'est configurée) */
+#define CLOCK_PROBE_IRQn        EXTI0_IRQn
+
+/* Accélérateurs actifs (Clock_GetAccelerators) */
+#define CLOCK_ACCEL_ICACHE      (1u << 0)
+#define CLOCK_ACCEL_DCACHE      (1u << 1)
+#define CLOCK_ACCEL_ART         (1u << 2)
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Clock_Init(void);
+bool Clock_SetProfile(Clock_Profile profile);
+Clock_Profile Clock_GetProfile(void);
+const Clock_ProfileInfo* Clock_GetInfo(Clock_Profile profile);
+bool Clock_FindProfile(const char *name, Clock_Profile *profile);
+uint32_t Clock_GetTimerClock(const TIM_TypeDef *instance);
+uint32_t Clock_GetAccelerators(void);
+bool Clock_Benchmark(Clock_Workload workload, uint32_t lineLength,
+                     Clock_BenchResult results[CLOCK_PROFILE_COUNT]);
+void Clock_IsrProbe(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CLOCK_PROFILE_H */
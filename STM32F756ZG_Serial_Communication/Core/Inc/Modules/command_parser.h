@@ -27,11 +27,15 @@ extern "C" {
 #define MAX_COMMAND_LENGTH 64
 #define MAX_ARGS 5
 #define COMMAND_BUFFER_SIZE   64      // Taille maximale du buffer de commande
+#define COMMAND_QUEUE_DEPTH   8       // Cases de la file (DEPTH - 1 commandes en attente)
+#define COMMAND_MAX_SEQUENCE  65535   // Plus grand numéro de séquence "#n" accepté
+#define COMMAND_MAX_NUMBER    65535   // Plus grand nombre accepté dans une commande
 
 /* Exported functions prototypes ---------------------------------------------*/
 void Command_Parser_Init(void);
 void Command_Parser_ProcessCommands(void);
 void Command_Parser_ProcessChar(char c);
+void Command_Parser_ProcessBuffer(const uint8_t* data, uint16_t length);
 
 #ifdef __cplusplus
 }
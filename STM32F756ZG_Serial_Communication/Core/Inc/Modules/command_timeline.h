@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file           : command_timeline.h
+  * @brief          : En-tête pour la programmation de commandes dans le temps
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les prototypes de la ligne de temps des commandes
+  * programmées (commande AT) : chaque commande attend son échéance, en
+  * ticks de la base de temps (Timer_GetTicks), et est exécutée depuis le
+  * timer logiciel de la ligne de temps.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __COMMAND_TIMELINE_H
+#define __COMMAND_TIMELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "Modules/command_parser.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define TIMELINE_DEPTH        32     // Commandes programmées au plus
+
+/* Exported types ------------------------------------------------------------*/
+/* Exécution d'une commande arrivée à échéance (texte en majuscules, sans
+ * numéro de séquence) ; retourne false si la commande a échoué */
+typedef bool (*Timeline_Handler)(const char *command);
+
+/* Compteurs de la ligne de temps (commande STATS) */
+typedef struct {
+  uint32_t executed;          // Commandes exécutées avec succès
+  uint32_t failed;            // Commandes exécutées en erreur
+  uint32_t maxLateMs;         // Plus grand retard sur l'échéance (ms)
+} Timeline_Stats;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Timeline_Init(Timeline_Handler handler);
+bool Timeline_Add(uint32_t due, bool held, const char *command);
+uint8_t Timeline_Go(void);
+void Timeline_Clear(void);
+uint8_t Timeline_GetCount(void);
+uint8_t Timeline_GetHeldCount(void);
+bool Timeline_GetNext(uint32_t *due);
+void Timeline_GetStats(Timeline_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __COMMAND_TIMELINE_H */
@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file           : dma_player.h
+  * @brief          : En-tête pour la lecture des chenillards par DMA
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les prototypes des fonctions qui jouent une table de
+  * mots BSRR sur le port des LED sans intervention du processeur : chaque
+  * débordement de TIM8 déclenche un transfert DMA2 (Stream1, Channel 7) de
+  * l'étape suivante vers GPIOB->BSRR, en mode circulaire.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DMA_PLAYER_H
+#define __DMA_PLAYER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Cadence du compteur de TIM8 : la plus basse que le prédiviseur (16 bits)
+ * atteigne encore avec TIM8 à 216 MHz */
+#define DMA_PLAYER_TICK_HZ        4000
+#define DMA_PLAYER_TICKS_PER_MS   (DMA_PLAYER_TICK_HZ / 1000)
+/* Étape la plus longue que le registre ARR (16 bits) puisse compter */
+#define DMA_PLAYER_MAX_PERIOD_MS  (65536 / DMA_PLAYER_TICKS_PER_MS)
+
+/* Exported functions prototypes ---------------------------------------------*/
+bool DMA_Player_Start(const uint32_t *words, uint8_t length,
+                      volatile uint32_t *target, uint32_t periodMs);
+void DMA_Player_Stop(void);
+bool DMA_Player_SetPeriod(uint32_t periodMs);
+bool DMA_Player_IsRunning(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DMA_PLAYER_H */
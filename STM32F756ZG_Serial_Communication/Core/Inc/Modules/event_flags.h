@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file           : event_flags.h
+  * @brief          : En-tête pour les événements de la boucle principale
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les prototypes des fonctions qui réveillent la boucle
+  * principale : les interruptions publient des événements (un bit chacun),
+  * la boucle dort en WFI tant qu'aucun n'est en attente. Des compteurs
+  * mesurent les réveils et le temps passé éveillé (cycles DWT).
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __EVENT_FLAGS_H
+#define __EVENT_FLAGS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Numéro de chaque événement (indice de Event_Stats.posted) */
+#define EVENT_ID_TIMER    0         // Échéance d'un timer logiciel atteinte (TIM2)
+#define EVENT_ID_UART_RX  1         // Octets reçus publiés (USART3)
+#define EVENT_COUNT       2         // Nombre de types d'événements
+
+/* Bits des événements */
+#define EVENT_TIMER     (1u << EVENT_ID_TIMER)
+#define EVENT_UART_RX   (1u << EVENT_ID_UART_RX)
+
+/* Exported types ------------------------------------------------------------*/
+/* Compteurs depuis Event_Init ou le dernier Event_ResetStats */
+typedef struct {
+  uint32_t wakeups;               // Sorties de WFI (toute interruption)
+  uint32_t dispatches;            // Passages de la boucle (au moins un événement)
+  uint32_t posted[EVENT_COUNT];   // Événements publiés, par type
+  uint64_t totalCycles;           // Cycles écoulés
+  uint64_t awakeCycles;           // Cycles hors WFI
+  uint32_t cyclesPerMs;           // Cycles par milliseconde (horloge du cœur)
+  uint32_t maxLoopUs;             // Plus long passage de la boucle (µs, depuis Event_Init)
+} Event_Stats;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Event_Init(void);
+void Event_Post(uint32_t events);
+uint32_t Event_Wait(void);
+void Event_GetStats(Event_Stats *stats);
+void Event_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EVENT_FLAGS_H */
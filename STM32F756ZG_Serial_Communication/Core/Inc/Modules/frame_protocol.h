@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file           : frame_protocol.h
+  * @brief          : En-tête pour le protocole de commandes binaire
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient le format des trames binaires, les codes d'opération
+  * et les prototypes du décodeur et de l'encodeur de trames.
+  * 
+  * Format d'une trame (octets) :
+  *   SYNC (0xA5) | OPCODE | LONGUEUR | DONNEES[LONGUEUR] | CRC16 (MSB, LSB)
+  * Le CRC-16/CCITT (polynôme 0x1021, valeur initiale 0xFFFF) porte sur
+  * OPCODE, LONGUEUR et DONNEES. La réponse à une trame reprend son code
+  * d'opération avec le bit FRAME_REPLY_FLAG, le premier octet de données
+  * étant le code de statut.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __FRAME_PROTOCOL_H
+#define __FRAME_PROTOCOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define FRAME_SYNC          0xA5    // Octet de début de trame
+#define FRAME_MAX_PAYLOAD   32      // Taille maximale des données
+#define FRAME_OVERHEAD      5       // SYNC, OPCODE, LONGUEUR et CRC
+#define FRAME_MAX_SIZE      (FRAME_MAX_PAYLOAD + FRAME_OVERHEAD)
+#define FRAME_REPLY_FLAG    0x80    // Bit ajouté au code d'opération des réponses
+
+/* Codes d'opération (hôte vers carte) */
+#define FRAME_OP_LED        0x01    // [led (1-3), état (0/1)]
+#define FRAME_OP_PATTERN    0x02    // [chenillard (1-3)]
+#define FRAME_OP_FREQ       0x03    // [fréquence (1 : 500MS, 2 : 1S, 3 : 3S)] ou [période ms (16 bits, poids fort en tête)]
+#define FRAME_OP_STOP       0x04    // []
+#define FRAME_OP_STATUS     0x05    // [] -> [statut, LED1, LED2, LED3, chenillard, fréquence (0 : libre), période ms (16 bits)]
+#define FRAME_OP_LEDS       0x06    // [masque (bit 0 : LED1)] : toutes les LED en une fois
+#define FRAME_OP_PATDEF     0x07    // [chenillard, masque étape 1, ...] : chargement en RAM
+#define FRAME_OP_PLAYBACK   0x08    // [lecture (0 : CPU, 1 : DMA)]
+#define FRAME_OP_DIM        0x09    // [led (1-3), niveau (0-255)]
+#define FRAME_OP_FADE       0x0A    // [led (1-3), niveau (0-255), durée ms (16 bits, poids fort en tête)]
+#define FRAME_OP_PATFADE    0x0B    // [fondu des étapes (0/1)]
+#define FRAME_OP_ASCII      0x7F    // [] : retour à la console ASCII
+#define FRAME_OP_NAK        0x80    // Réponse à une trame corrompue (code 0x00 réservé)
+
+/* Codes de statut (premier octet des réponses) */
+#define FRAME_STATUS_OK         0x00
+#define FRAME_STATUS_CRC        0x01    // CRC invalide
+#define FRAME_STATUS_OPCODE     0x02    // Code d'opération inconnu
+#define FRAME_STATUS_LENGTH     0x03    // Longueur des données invalide
+#define FRAME_STATUS_ARGUMENT   0x04    // Argument hors limites
+#define FRAME_STATUS_FAILED     0x05    // Commande refusée (ex. chenillard actif)
+
+/* Exported types ------------------------------------------------------------*/
+/* Résultat du décodage d'un octet */
+typedef enum {
+  FRAME_INCOMPLETE = 0,   // Trame en cours (ou attente de SYNC)
+  FRAME_COMPLETE,         // Trame valide disponible dans le décodeur
+  FRAME_BAD_CRC           // Trame complète mais corrompue
+} Frame_Result;
+
+/* Décodeur de trames, alimenté octet par octet */
+typedef struct {
+  uint8_t state;                      // Position dans la trame
+  uint8_t opcode;                     // Code d'opération reçu
+  uint8_t length;                     // Longueur annoncée des données
+  uint8_t received;                   // Octets de données reçus
+  uint16_t crc;                       // CRC calculé au fil de l'eau
+  uint16_t frameCrc;                  // CRC reçu
+  uint8_t payload[FRAME_MAX_PAYLOAD]; // Données reçues
+} Frame_Decoder;
+
+/* Exported functions prototypes ---------------------------------------------*/
+uint16_t Frame_Crc16_Update(uint16_t crc, uint8_t byte);
+void Frame_Decoder_Reset(Frame_Decoder *decoder);
+Frame_Result Frame_Decoder_Feed(Frame_Decoder *decoder, uint8_t byte);
+size_t Frame_Encode(uint8_t opcode, const uint8_t *payload, uint8_t length, uint8_t *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FRAME_PROTOCOL_H */
@@ -37,6 +37,17 @@ typedef enum {
 #define LED_OFF     0
 #define LED_ERROR   2      // Valeur d'erreur pour les fonctions LED
 
+/* Masques d'état (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3) */
+#define LED_MASK(n)   (1u << ((n) - 1))
+#define LED_MASK_ALL  ((1u << LED_COUNT) - 1)
+
+/* Luminosité (PWM de TIM3, TIM4 et TIM12) */
+#define LED_LEVEL_MAX     255     // Niveau d'une LED allumée (0 : éteinte)
+#define LED_PWM_BITS      10      // Résolution du rapport cyclique après correction gamma
+#define LED_PWM_MAX       ((1u << LED_PWM_BITS) - 1)  // Période des timers PWM (ARR)
+#define LED_FADE_STEP_MS  5       // Intervalle de mise à jour des fondus
+#define LED_FADE_MAX_MS   60000   // Durée maximale d'un fondu
+
 /* Exported functions prototypes ---------------------------------------------*/
 void LED_Controller_Init(void);
 bool LED_SetState(uint8_t ledNumber, LED_State state);
@@ -44,6 +55,15 @@ LED_State LED_GetState(uint8_t ledNumber);
 bool LED_Toggle(uint8_t ledNumber);
 bool LED_IsValidNumber(uint8_t ledNumber);
 void LED_ForceState(uint8_t ledNumber, LED_State state); // Prototype ajouté (non statique)
+void LED_ForceMask(uint32_t mask);
+bool LED_SetMask(uint32_t mask);
+uint32_t LED_GetMask(void);
+uint32_t LED_MaskToBsrr(uint32_t mask);
+volatile uint32_t* LED_GetBsrrAddress(void);
+bool LED_SetLevel(uint8_t ledNumber, uint8_t level);
+uint8_t LED_GetLevel(uint8_t ledNumber);
+bool LED_Fade(uint8_t ledNumber, uint8_t level, uint32_t durationMs);
+void LED_FadeMask(uint32_t mask, uint32_t durationMs);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file           : memory_sections.h
+  * @brief          : Placement du code et des données dans les mémoires
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les attributs qui placent le code critique et les
+  * données chaudes dans les mémoires couplées au cœur, sans état d'attente,
+  * et les buffers DMA dans une zone non cachée (voir STM32F756ZGTX_FLASH.ld
+  * et MPU_Config) :
+  * - ITCM_CODE : fonction copiée en ITCM-RAM (16 Ko en 0x00000000) au
+  *   démarrage, exécutée sans passer par la flash ni le cache ;
+  * - DTCM_DATA : variable en DTCM (64 Ko en 0x20000000), initialisée au
+  *   démarrage comme .data ;
+  * - DMA_BUFFER : variable en SRAM2 (16 Ko en 0x2004C000), que le MPU
+  *   déclare non cachable : le DMA et le cœur y voient toujours les mêmes
+  *   octets, sans nettoyage ni invalidation du cache de données. Mise à
+  *   zéro au démarrage comme .bss.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MEMORY_SECTIONS_H
+#define __MEMORY_SECTIONS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Zones du STM32F756 */
+#define MEMORY_ITCM_BASE        0x00000000u
+#define MEMORY_ITCM_SIZE        (16u * 1024u)
+#define MEMORY_DTCM_BASE        0x20000000u
+#define MEMORY_DTCM_SIZE        (64u * 1024u)
+#define MEMORY_DMA_BASE         0x2004C000u     // SRAM2
+#define MEMORY_DMA_SIZE         (16u * 1024u)
+
+/* Exported macro ------------------------------------------------------------*/
+#define ITCM_CODE   __attribute__((section(".itcm_text"), noinline))
+#define DTCM_DATA   __attribute__((section(".dtcm_data")))
+#define DMA_BUFFER  __attribute__((section(".dma_buffer"), aligned(32)))
+
+/* Adresse dans une zone (vérification du placement à l'exécution) */
+#define MEMORY_IN(address, base, size) \
+  ((uintptr_t)(address) - (uintptr_t)(base) < (uintptr_t)(size))
+#define MEMORY_IN_ITCM(address)  MEMORY_IN(address, MEMORY_ITCM_BASE, MEMORY_ITCM_SIZE)
+#define MEMORY_IN_DTCM(address)  MEMORY_IN(address, MEMORY_DTCM_BASE, MEMORY_DTCM_SIZE)
+#define MEMORY_IN_DMA(address)   MEMORY_IN(address, MEMORY_DMA_BASE, MEMORY_DMA_SIZE)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEMORY_SECTIONS_H */
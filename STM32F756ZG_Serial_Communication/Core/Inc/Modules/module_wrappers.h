@@ -13,12 +13,20 @@
 extern "C" {
 #endif
 
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
 /* Prototypes des fonctions -------------------------------------------------*/
 void LED_Init(void);
 void PATTERN_Init(void);
+void CLOCK_Init(void);
+void EVENT_Init(void);
+void PROFILE_Init(void);
+uint32_t EVENT_Wait(void);
 void TIMER_Init(void);
 void COMMAND_Init(void);
 void COMMAND_Process(void);
+void TIMER_Process(void);
 void PATTERN_Process(void);
 
 #ifdef __cplusplus
@@ -24,9 +24,25 @@ extern "C" {
 #include <stdbool.h>
 
 /* Exported constants --------------------------------------------------------*/
-#define PATTERN_COUNT 3
+/* Catalogue : chenillards prédéfinis (flash) puis emplacements chargés par
+ * l'UART (RAM). Le nombre d'entrées s'obtient par Pattern_GetCount(). */
+#define PATTERN_BUILTIN_COUNT 3      // Chenillards prédéfinis (PAT1 à PAT3)
+#define PATTERN_USER_SLOTS    4      // Emplacements chargés (PAT4 à PAT7)
+#define PATTERN_MAX_STEPS     32     // Étapes par chenillard chargé
 
-/* Définition des types de chenillard */
+/* Programmes : un emplacement chargé peut recevoir du bytecode, exécuté par
+ * la machine virtuelle des chenillards (Pattern_DefineProgram) */
+#define PATTERN_PROGRAM_SIZE  128    // Octets de bytecode par emplacement
+#define PATTERN_VM_INSN_SIZE  4      // Octets par instruction : code, a, b, c
+#define PATTERN_VM_REGISTERS  8      // Registres r0 à r7 (16 bits, puissance de 2)
+#define PATTERN_VM_BUDGET     64     // Instructions exécutées au plus par étape
+
+/* Période des étapes réglable par Pattern_SetPeriod (FREQ <ms>) */
+#define PATTERN_PERIOD_MIN_MS 1
+#define PATTERN_PERIOD_MAX_MS 60000
+
+/* Définition des types de chenillard (numéro dans le catalogue ; au-delà de
+ * PATTERN_3, emplacements chargés) */
 typedef enum {
   PATTERN_NONE = 0,
   PATTERN_1 = 1,
@@ -34,13 +50,60 @@ typedef enum {
   PATTERN_3 = 3
 } Pattern_Type;
 
-/* Définition des fréquences de chenillard */
+/* Définition des fréquences de chenillard (périodes prédéfinies) */
 typedef enum {
   PATTERN_FREQ_500MS = 0,
   PATTERN_FREQ_1S = 1,
-  PATTERN_FREQ_3S = 2
+  PATTERN_FREQ_3S = 2,
+  PATTERN_FREQ_CUSTOM = 3     // Période libre (Pattern_SetPeriod)
 } Pattern_Frequency;
 
+/* Lecture des étapes */
+typedef enum {
+  PATTERN_PLAYBACK_CPU = 0,   // Timer logiciel et boucle principale
+  PATTERN_PLAYBACK_DMA = 1    // TIM8 et DMA vers GPIOB->BSRR (dma_player)
+} Pattern_Playback;
+
+/* Jeu d'instructions de la machine virtuelle. Une instruction occupe
+ * PATTERN_VM_INSN_SIZE octets [code, a, b, c] : a est un registre, b un
+ * second registre, c une cible de saut (numéro d'instruction) ; une valeur
+ * immédiate occupe b et c (16 bits, poids fort en tête). Les calculs se
+ * font modulo 2^16 ; un masque de LED est lu dans les bits de poids faible.
+ * Seules SHOW, SHOWI et WAIT terminent l'étape en cours. */
+typedef enum {
+  PATTERN_OP_SET     = 0x01,  // a = imm
+  PATTERN_OP_MOV     = 0x02,  // a = b
+  PATTERN_OP_ADD     = 0x03,  // a += b
+  PATTERN_OP_ADDI    = 0x04,  // a += imm
+  PATTERN_OP_ANDI    = 0x05,  // a &= imm
+  PATTERN_OP_XORI    = 0x06,  // a ^= imm
+  PATTERN_OP_SHLI    = 0x07,  // a <<= imm
+  PATTERN_OP_SHRI    = 0x08,  // a >>= imm
+  PATTERN_OP_RAND    = 0x09,  // a = aléa de 0 à imm - 1 (imm 0 : 16 bits)
+  PATTERN_OP_LEDS    = 0x0A,  // a = masque des LED allumées (LED_GetMask)
+  PATTERN_OP_SHOW    = 0x0B,  // Étape : LED selon le masque a
+  PATTERN_OP_SHOWI   = 0x0C,  // Étape : LED selon le masque imm
+  PATTERN_OP_WAIT    = 0x0D,  // imm étapes sans changement (imm >= 1)
+  PATTERN_OP_PERIOD  = 0x0E,  // Période des étapes = a ms
+  PATTERN_OP_PERIODI = 0x0F,  // Période des étapes = imm ms
+  PATTERN_OP_JMP     = 0x10,  // Saut à c
+  PATTERN_OP_JZ      = 0x11,  // Saut à c si a == 0
+  PATTERN_OP_JNZ     = 0x12,  // Saut à c si a != 0
+  PATTERN_OP_JLT     = 0x13,  // Saut à c si a < b (non signés)
+  PATTERN_OP_DJNZ    = 0x14,  // a -= 1, saut à c si a != 0
+  PATTERN_OP_HALT    = 0x15   // Fin du chenillard (LED éteintes)
+} Pattern_VmOpcode;
+
+/* Description d'un chenillard : une étape est un masque d'état des LED
+ * (bit 0 : LED1, voir LED_ForceMask) ; un programme remplace la table */
+typedef struct {
+  const char *name;           // Nom affiché (PATLIST)
+  const uint8_t *steps;       // Masques des étapes
+  uint8_t length;             // Nombre d'étapes (0 : emplacement vide ou programme)
+  const uint8_t *code;        // Bytecode (NULL : table d'étapes)
+  uint8_t codeLength;         // Octets de bytecode
+} Pattern_Definition;
+
 /* Exported functions prototypes ---------------------------------------------*/
 void Pattern_Controller_Init(void);
 bool Pattern_Start(Pattern_Type pattern);
@@ -48,9 +111,20 @@ bool Pattern_Stop(void);
 bool Pattern_SetFrequency(Pattern_Frequency freq);
 Pattern_Type Pattern_GetActive(void);
 Pattern_Frequency Pattern_GetFrequency(void);
+bool Pattern_SetPeriod(uint32_t periodMs);
+uint32_t Pattern_GetPeriod(void);
+bool Pattern_SetPlayback(Pattern_Playback mode);
+Pattern_Playback Pattern_GetPlayback(void);
+void Pattern_SetFade(bool enabled);
+bool Pattern_GetFade(void);
+uint32_t Pattern_GetMissedSteps(void);
 bool Pattern_IsActive(void);
+uint8_t Pattern_GetCount(void);
+bool Pattern_GetDefinition(uint8_t pattern, Pattern_Definition *definition);
+bool Pattern_Define(uint8_t pattern, const uint8_t *steps, uint8_t length);
+bool Pattern_DefineProgram(uint8_t pattern, const uint8_t *code, uint8_t length);
+uint32_t Pattern_GetProgramFaults(void);
 void Pattern_Controller_Update(void);
-void Pattern_TimerCallback(Pattern_Frequency timerType);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file           : profiler.h
+  * @brief          : En-tête pour le profilage par compteur de cycles
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient les sondes de profilage : une paire PROFILE_BEGIN /
+  * PROFILE_END encadre une portion de code et en mesure la durée avec le
+  * compteur de cycles DWT (CYCCNT, activé par Event_Init). Chaque sonde
+  * cumule le nombre d'appels, le minimum, le maximum, la somme et un
+  * histogramme en puissances de 2. La commande PROFILE affiche le tableau.
+  *
+  * Compilé avec PROFILE_ENABLED à 0, les macros ne produisent aucun code et
+  * le module ne contient plus de données.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Sondes de profilage (1 : compilées) */
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED         1
+#endif
+
+#define PROFILE_HISTOGRAM_BINS  32      // Case i : durées de 2^i à 2^(i+1)-1 cycles
+
+/* Exported types ------------------------------------------------------------*/
+/* Portions de code mesurées */
+typedef enum {
+  PROFILE_PROBE_PROCESS_CHAR = 0,   // Command_Parser_ProcessChar (un octet)
+  PROFILE_PROBE_PROCESS_COMMANDS,   // Command_Parser_ProcessCommands (exécution et réponses)
+  PROFILE_PROBE_PATTERN_UPDATE,     // Pattern_Controller_Update (une étape appliquée)
+  PROFILE_PROBE_USART3_ISR,         // USART3_IRQHandler
+  PROFILE_PROBE_COUNT
+} Profile_Probe;
+
+/* Mesures d'une sonde depuis Profile_Init ou le dernier Profile_Reset */
+typedef struct {
+  uint32_t count;                   // Nombre de mesures
+  uint32_t min;                     // Durée minimale (cycles)
+  uint32_t max;                     // Durée maximale (cycles)
+  uint64_t sum;                     // Somme des durées (cycles)
+  uint32_t histogram[PROFILE_HISTOGRAM_BINS]; // Mesures par puissance de 2
+} Profile_Stats;
+
+/* Exported macro ------------------------------------------------------------*/
+/* Encadrement d'une portion de code, dans un même bloc :
+ *   PROFILE_BEGIN(PROFILE_PROBE_xxx);
+ *   ...
+ *   PROFILE_END(PROFILE_PROBE_xxx);
+ * Une interruption servie entre les deux est comptée dans la mesure. */
+#if PROFILE_ENABLED
+#define PROFILE_BEGIN(probe)  uint32_t profileStart_##probe = Profile_Now()
+#define PROFILE_END(probe)    Profile_Record((probe), Profile_Now() - profileStart_##probe)
+#else
+#define PROFILE_BEGIN(probe)  ((void)0)
+#define PROFILE_END(probe)    ((void)0)
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+void Profile_Init(void);
+void Profile_Record(Profile_Probe probe, uint32_t cycles);
+void Profile_GetStats(Profile_Probe probe, Profile_Stats *stats);
+const char *Profile_GetName(Profile_Probe probe);
+uint32_t Profile_GetOverhead(void);
+void Profile_Reset(void);
+
+/**
+  * @brief  Lecture du compteur de cycles
+  * @retval Valeur de DWT->CYCCNT
+  */
+static inline uint32_t Profile_Now(void)
+{
+  return DWT->CYCCNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROFILER_H */
@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file           : ring_buffer.h
+  * @brief          : En-tête pour le buffer circulaire producteur/consommateur
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier contient le type et les prototypes du buffer circulaire d'octets
+  * à un producteur et un consommateur (SPSC), partagé entre une interruption
+  * et la boucle principale sans verrou ni masquage des interruptions.
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RING_BUFFER_H
+#define __RING_BUFFER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Les index sont des compteurs libres (modulo 2^32) : head n'est écrit que
+ * par le producteur, tail que par le consommateur. La taille doit être une
+ * puissance de 2 pour que la position dans le buffer soit index & (size - 1). */
+typedef struct {
+  uint8_t *buffer;            // Zone de stockage
+  uint32_t size;              // Taille de la zone (puissance de 2)
+  volatile uint32_t head;     // Octets publiés par le producteur
+  volatile uint32_t tail;     // Octets libérés par le consommateur
+} Ring_Buffer;
+
+/* Exported functions prototypes ---------------------------------------------*/
+bool Ring_Buffer_Init(Ring_Buffer *ring, uint8_t *storage, uint32_t size);
+void Ring_Buffer_Reset(Ring_Buffer *ring);
+uint32_t Ring_Buffer_Count(const Ring_Buffer *ring);
+uint32_t Ring_Buffer_Space(const Ring_Buffer *ring);
+
+/* Côté producteur */
+bool Ring_Buffer_Push(Ring_Buffer *ring, uint8_t byte);
+uint32_t Ring_Buffer_Write(Ring_Buffer *ring, const uint8_t *data, uint32_t length);
+void Ring_Buffer_Commit(Ring_Buffer *ring, uint32_t count);
+
+/* Côté consommateur */
+uint32_t Ring_Buffer_PeekSpan(const Ring_Buffer *ring, const uint8_t **data);
+void Ring_Buffer_Consume(Ring_Buffer *ring, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RING_BUFFER_H */
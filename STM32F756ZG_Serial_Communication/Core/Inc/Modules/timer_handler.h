@@ -6,8 +6,9 @@
   * @date           : 07-04-2025
   ******************************************************************************
   * @description
-  * Ce fichier contient les prototypes des fonctions pour la gestion des
-  * différents timers utilisés dans le projet.
+  * Ce fichier contient les prototypes des fonctions des timers logiciels :
+  * une base de temps unique (TIM2, 1 ms) et une roue de timers sur laquelle
+  * les modules enregistrent leurs échéances.
   ******************************************************************************
   */
 
@@ -22,19 +23,42 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Exported constants --------------------------------------------------------*/
-#define TIMER_COUNT 3
+#define TIMER_TICK_MS      1         // Période de la base de temps (TIM2)
+#define TIMER_WHEEL_SLOTS  64        // Cases de la roue (puissance de 2)
+
+/* Exported types ------------------------------------------------------------*/
+struct Soft_Timer;
+
+/* Fonction appelée à l'échéance d'un timer (depuis la boucle principale) */
+typedef void (*Timer_Handler)(struct Soft_Timer *timer, void *context);
+
+/* Timer logiciel : la structure est fournie par le module appelant (pas
+ * d'allocation) et chaînée dans la case de la roue de son échéance. */
+typedef struct Soft_Timer {
+  struct Soft_Timer *next;    // Suivant dans la case
+  struct Soft_Timer *prev;    // Précédent dans la case
+  uint32_t expiry;            // Échéance (ticks)
+  uint32_t period;            // Période en ticks (0 : timer unique)
+  Timer_Handler handler;      // Fonction appelée à l'échéance
+  void *context;              // Pointeur transmis à la fonction
+  bool armed;                 // true si le timer est dans la roue
+} Soft_Timer;
 
 /* Exported functions prototypes ---------------------------------------------*/
 void Timer_Init(void);
-bool Timer_Start(uint8_t timerType);
-bool Timer_Stop(uint8_t timerType);
-bool Timer_IsActive(uint8_t timerType);
-void Timer_Callback(uint8_t timerType);
+bool Timer_Arm(Soft_Timer *timer, uint32_t delayMs, uint32_t periodMs,
+               Timer_Handler handler, void *context);
+void Timer_Cancel(Soft_Timer *timer);
+bool Timer_SetPeriod(Soft_Timer *timer, uint32_t periodMs);
+bool Timer_IsArmed(const Soft_Timer *timer);
+uint32_t Timer_GetTicks(void);
+void Timer_Process(void);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* __TIMER_HANDLER_H */
\ No newline at end of file
+#endif /* __TIMER_HANDLER_H */
@@ -23,9 +23,43 @@ extern "C" {
 #include "main.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 /* Définitions ---------------------------------------------------------------*/
-#define UART_BUFFER_SIZE   64    // Taille du buffer de réception UART
+#ifndef UART_BAUDRATE
+#define UART_BAUDRATE      115200  // Débit de l'UART (921600 supporté en réception DMA)
+#endif
+#define UART_RX_DMA_BUFFER_SIZE 512  // Buffer circulaire de réception DMA (puissance de 2)
+#ifndef UART_RX_USE_DMA
+#define UART_RX_USE_DMA    1       // 0 : réception par interruption, un octet à la fois
+#endif
+#define UART_TX_RING_SIZE       1024 // Buffer circulaire d'émission (puissance de 2)
+
+/* Politique quand le buffer d'émission est plein */
+#define UART_TX_OVERFLOW_FLUSH  0    // Attendre que le DMA libère de la place
+#define UART_TX_OVERFLOW_DROP   1    // Abandonner les octets (comptés)
+#ifndef UART_TX_OVERFLOW_POLICY
+#define UART_TX_OVERFLOW_POLICY UART_TX_OVERFLOW_FLUSH
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t bytes;       // Octets émis (transferts DMA terminés)
+  uint32_t highWater;   // Remplissage maximal observé du buffer d'émission
+  uint32_t dropped;     // Octets abandonnés faute de place
+  uint32_t flushes;     // Attentes de vidage (politique FLUSH)
+} UART_TxStats;
+
+/* Compteurs de réception depuis UART_Init (jamais remis à zéro) */
+typedef struct {
+  uint32_t bytes;       // Octets transmis au parseur
+  uint32_t lost;        // Octets écrasés avant lecture (retard d'un tour)
+  uint32_t overrun;     // Erreurs de débordement matériel (ORE)
+  uint32_t framing;     // Erreurs de trame (FE)
+  uint32_t noise;       // Bruit détecté (NE)
+  uint32_t parity;      // Erreurs de parité (PE)
+  uint32_t dma;         // Erreurs DMA
+} UART_RxStats;
 
 /* Exported constants --------------------------------------------------------*/
 #define UART_RX_BUFFER_SIZE     256
@@ -38,10 +72,18 @@ void UART_Handler_Init(UART_HandleTypeDef *huart);
 void UART_StartReceive(void);
 void UART_RxCpltCallback(void);
 void UART_SendString(const char *str);
+void UART_Write(const uint8_t *data, size_t length);
+void UART_SendFrame(uint8_t opcode, const uint8_t *payload, uint8_t length);
+void UART_GetTxStats(UART_TxStats *stats);
+void UART_GetRxStats(UART_RxStats *stats);
 void UART_SendResponse(const char *response);
 bool UART_IsCommandAvailable(void);
 char* UART_GetCommand(void);
 bool UART_HasOverflow(void);
+void UART_ProcessReceived(void);
+void UART_Reset(void);
+bool UART_Flush(void);
+void UART_UpdateBaudRate(void);
 
 #ifdef __cplusplus
 }
@@ -70,10 +70,6 @@ void Error_Handler(void);
 #define LED3_GPIO_Port GPIOB
 
 /* USER CODE BEGIN Private defines */
-/* Définitions pour les timers */
-#define TIMER_500MS                 0  // TIM2
-#define TIMER_1S                    1  // TIM3
-#define TIMER_3S                    2  // TIM4
 
 /* USER CODE END Private defines */
 
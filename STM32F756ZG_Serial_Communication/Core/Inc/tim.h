@@ -38,6 +38,10 @@ extern TIM_HandleTypeDef htim3;
 
 extern TIM_HandleTypeDef htim4;
 
+extern TIM_HandleTypeDef htim8;
+
+extern TIM_HandleTypeDef htim12;
+
 /* USER CODE BEGIN Private defines */
 
 /* USER CODE END Private defines */
@@ -45,6 +49,8 @@ extern TIM_HandleTypeDef htim4;
 void MX_TIM2_Init(void);
 void MX_TIM3_Init(void);
 void MX_TIM4_Init(void);
+void MX_TIM8_Init(void);
+void MX_TIM12_Init(void);
 
 /* USER CODE BEGIN Prototypes */
 
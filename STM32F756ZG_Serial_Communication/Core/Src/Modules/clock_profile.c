@@ -0,0 +1,508 @@
+/**
+  ******************************************************************************
+  * @file           : clock_profile.c
+  * @brief          : Profils d'horloge du cœur
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente le choix de la fréquence du cœur parmi trois
+  * profils :
+  * - LOW : HSI 16 MHz sans PLL, échelle de tension 3, 0 état d'attente
+  *   (configuration de SystemClock_Config) ;
+  * - BALANCED : PLL 96 MHz depuis HSI, échelle 3, 3 états d'attente,
+  *   APB1 à 48 MHz ;
+  * - FULL : PLL 216 MHz, échelle 1 et overdrive, 7 états d'attente,
+  *   APB1 à 54 MHz et APB2 à 108 MHz (maximums du STM32F756).
+  *
+  * Le changement de profil repasse toujours par HSI : la PLL ne peut être
+  * reconfigurée (et l'échelle de tension changée) que PLL arrêtée. Les
+  * états d'attente de la flash sont ajustés par HAL_RCC_ClockConfig dans
+  * l'ordre qui reste sûr (augmentés avant de monter en fréquence, diminués
+  * après être descendu). L'émission UART est vidée avant le changement ;
+  * ensuite le diviseur de débit de l'UART et les prédiviseurs des timers
+  * sont recalculés depuis les nouvelles horloges de bus, et le SysTick de
+  * la HAL est reconfiguré par la HAL elle-même.
+  *
+  * Les caches L1 et l'accélérateur ART sont activés à l'initialisation
+  * (CLOCK_USE_xxx). L'ART n'accélère que les accès par l'interface ITCM de
+  * la flash (0x00200000) : le code lié à 0x08000000 passe par l'AXI et
+  * profite du cache d'instructions (le code critique, lui, s'exécute en
+  * ITCM). Les buffers DMA sont en SRAM2, non cachable (voir
+  * memory_sections.h) : le cache de données n'impose aucune maintenance.
+  *
+  * Clock_Benchmark passe par chaque profil et mesure, en cycles DWT, une
+  * charge fournie par l'appelant (l'analyse d'une ligne de commande) et la
+  * latence d'entrée dans une interruption mise en attente par logiciel.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "tim.h"
+#include "usart.h"
+#include "Modules/clock_profile.h"
+#include "Modules/uart_handler.h"
+#include "Modules/event_flags.h"
+#include "Modules/dma_player.h"
+#include "Modules/memory_sections.h"
+#include "stm32f7xx_hal.h"
+#include <string.h>
+
+/* Constantes privées --------------------------------------------------------*/
+#define CLOCK_PLL_M             8           // HSI / 8 : 2 MHz en entrée de PLL
+#define CLOCK_TICK_COUNTER_HZ   1000000u    // Compteur de TIM2 (ARR 999 : 1 kHz)
+#define CLOCK_PWM_COUNTER_HZ    16000000u   // Compteur PWM au plus (ARR 1023 : ~15.6 kHz)
+#define CLOCK_UART_BITS         10u         // Bits par octet (8N1)
+
+/* Types privés --------------------------------------------------------------*/
+/* Réglages d'un profil */
+typedef struct {
+  Clock_ProfileInfo info;     // Fréquences affichées
+  bool usePll;                // SYSCLK depuis la PLL (sinon HSI)
+  uint32_t pllN;              // Multiplicateur de la PLL (VCO = 2 MHz * N)
+  uint32_t pllQ;              // Diviseur de sortie 48 MHz
+  uint32_t apb1Div;           // Diviseur APB1 (RCC_HCLK_DIVx)
+  uint32_t apb2Div;           // Diviseur APB2 (RCC_HCLK_DIVx)
+} Clock_ProfileConfig;
+
+/* Prédiviseur d'un timer recalculé à chaque changement de profil */
+typedef struct {
+  TIM_HandleTypeDef *htim;    // Timer
+  uint32_t counterHz;         // Fréquence de comptage visée (au plus)
+} Clock_TimerConfig;
+
+/* Variables privées ---------------------------------------------------------*/
+static const Clock_ProfileConfig profiles[CLOCK_PROFILE_COUNT] = {
+  [CLOCK_PROFILE_LOW] = {
+    { "LOW", 16000000u, 16000000u, 16000000u, 0, 3, false },
+    false, 0, 0, RCC_HCLK_DIV1, RCC_HCLK_DIV1
+  },
+  [CLOCK_PROFILE_BALANCED] = {
+    { "BALANCED", 96000000u, 48000000u, 96000000u, 3, 3, false },
+    true, 96, 4, RCC_HCLK_DIV2, RCC_HCLK_DIV1
+  },
+  [CLOCK_PROFILE_FULL] = {
+    { "FULL", 216000000u, 54000000u, 108000000u, 7, 1, true },
+    true, 216, 9, RCC_HCLK_DIV4, RCC_HCLK_DIV2
+  },
+};
+
+/* Échelles de tension 1 à 3 */
+static const uint32_t voltageScales[3] = {
+  PWR_REGULATOR_VOLTAGE_SCALE1,
+  PWR_REGULATOR_VOLTAGE_SCALE2,
+  PWR_REGULATOR_VOLTAGE_SCALE3
+};
+
+static const Clock_TimerConfig timers[] = {
+  { &htim2,  CLOCK_TICK_COUNTER_HZ },   // Tick des timers logiciels
+  { &htim3,  CLOCK_PWM_COUNTER_HZ },    // PWM LED1
+  { &htim4,  CLOCK_PWM_COUNTER_HZ },    // PWM LED2
+  { &htim12, CLOCK_PWM_COUNTER_HZ },    // PWM LED3
+  { &htim8,  DMA_PLAYER_TICK_HZ },      // Lecture DMA des chenillards
+};
+#define CLOCK_TIMER_COUNT  (sizeof(timers) / sizeof(timers[0]))
+
+static Clock_Profile activeProfile = CLOCK_PROFILE_LOW;
+
+/* Sonde de latence : horodatage pris par Clock_IsrProbe */
+static volatile uint32_t probeStamp = 0;
+static volatile bool probeFired = false;
+
+/* Prototypes des fonctions privées ------------------------------------------*/
+static bool Clock_Apply(const Clock_ProfileConfig *config);
+static void Clock_SwitchToHsi(void);
+static void Clock_UpdatePeripherals(void);
+static uint32_t Clock_MeasureWorkload(Clock_Workload workload);
+static uint32_t Clock_MeasureIsr(void);
+
+/**
+  * @brief  Initialisation des accélérateurs et du profil par défaut
+  * @note   À appeler après l'initialisation des timers et de l'UART, dont
+  *         les prédiviseurs sont recalculés si le profil par défaut n'est
+  *         pas celui de SystemClock_Config.
+  * @param  None
+  * @retval None
+  */
+void Clock_Init(void)
+{
+#if CLOCK_USE_ART
+  __HAL_FLASH_ART_ENABLE();
+  __HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+#endif
+#if CLOCK_USE_ICACHE
+  SCB_EnableICache();
+#endif
+#if CLOCK_USE_DCACHE
+  SCB_EnableDCache();
+#endif
+
+  HAL_NVIC_SetPriority(CLOCK_PROBE_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(CLOCK_PROBE_IRQn);
+
+  activeProfile = CLOCK_PROFILE_LOW;
+  if (CLOCK_PROFILE_DEFAULT != CLOCK_PROFILE_LOW)
+  {
+    Clock_SetProfile(CLOCK_PROFILE_DEFAULT);
+  }
+}
+
+/**
+  * @brief  Changement de profil d'horloge
+  * @note   Bloque le temps de vider l'émission UART puis de verrouiller la
+  *         PLL (quelques centaines de µs). Un octet en cours de réception
+  *         pendant le changement est perdu. En cas d'échec, le cœur reste
+  *         sur HSI (profil LOW) avec des périphériques recalculés.
+  * @param  profile: Profil à appliquer
+  * @retval true si le profil est appliqué, false sinon
+  */
+bool Clock_SetProfile(Clock_Profile profile)
+{
+  bool applied;
+
+  if (profile >= CLOCK_PROFILE_COUNT)
+  {
+    return false;
+  }
+  if (profile == activeProfile)
+  {
+    return true;
+  }
+
+  UART_Flush();
+  Clock_SwitchToHsi();
+  activeProfile = CLOCK_PROFILE_LOW;
+
+  applied = Clock_Apply(&profiles[profile]);
+  if (applied)
+  {
+    activeProfile = profile;
+  }
+  else
+  {
+    Clock_SwitchToHsi();
+  }
+
+  Clock_UpdatePeripherals();
+  return applied;
+}
+
+/**
+  * @brief  Profil actif
+  * @param  None
+  * @retval Profil actif
+  */
+Clock_Profile Clock_GetProfile(void)
+{
+  return activeProfile;
+}
+
+/**
+  * @brief  Description d'un profil
+  * @param  profile: Profil demandé
+  * @retval Description, NULL si le profil n'existe pas
+  */
+const Clock_ProfileInfo* Clock_GetInfo(Clock_Profile profile)
+{
+  if (profile >= CLOCK_PROFILE_COUNT)
+  {
+    return NULL;
+  }
+  return &profiles[profile].info;
+}
+
+/**
+  * @brief  Recherche d'un profil par son nom
+  * @param  name: Nom du profil (majuscules)
+  * @param  profile: Profil trouvé
+  * @retval true si le nom est connu, false sinon
+  */
+bool Clock_FindProfile(const char *name, Clock_Profile *profile)
+{
+  for (uint32_t i = 0; i < CLOCK_PROFILE_COUNT; i++)
+  {
+    if (strcmp(name, profiles[i].info.name) == 0)
+    {
+      *profile = (Clock_Profile)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Fréquence d'horloge d'un timer
+  * @note   Les timers de l'APB2 (adresses au-delà de APB2PERIPH_BASE)
+  *         suivent PCLK2, les autres PCLK1 ; ils reçoivent le double de
+  *         l'horloge du bus dès que celui-ci est divisé.
+  * @param  instance: Timer (TIMx)
+  * @retval Fréquence en Hz
+  */
+uint32_t Clock_GetTimerClock(const TIM_TypeDef *instance)
+{
+  if ((uint32_t)instance >= APB2PERIPH_BASE)
+  {
+    uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_HCLK_DIV1) ? pclk2 * 2 : pclk2;
+  }
+
+  uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+  return ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) ? pclk1 * 2 : pclk1;
+}
+
+/**
+  * @brief  Accélérateurs actifs
+  * @param  None
+  * @retval Bits CLOCK_ACCEL_xxx
+  */
+uint32_t Clock_GetAccelerators(void)
+{
+  uint32_t accelerators = 0;
+
+  if (SCB->CCR & SCB_CCR_IC_Msk)
+  {
+    accelerators |= CLOCK_ACCEL_ICACHE;
+  }
+  if (SCB->CCR & SCB_CCR_DC_Msk)
+  {
+    accelerators |= CLOCK_ACCEL_DCACHE;
+  }
+  if (FLASH->ACR & FLASH_ACR_ARTEN)
+  {
+    accelerators |= CLOCK_ACCEL_ART;
+  }
+  return accelerators;
+}
+
+/**
+  * @brief  Mesures de chaque profil
+  * @note   Passe par tous les profils puis revient au profil actif. Pour
+  *         chacun :
+  *         - lineCycles : minimum sur CLOCK_BENCH_RUNS exécutions de la
+  *           charge, interruptions masquées (caches chauds) ;
+  *         - isrCycles : minimum sur CLOCK_BENCH_ISR_SAMPLES mises en
+  *           attente de CLOCK_PROBE_IRQn, de l'écriture dans le NVIC à la
+  *           première instruction du gestionnaire ; 0 si l'interruption
+  *           n'a pas été servie (masquée ou désactivée) ;
+  *         - maxBaud : débit auquel l'analyse suit encore la réception
+  *           (CLOCK_UART_BITS bits par octet), borné par le débit maximal
+  *           de l'UART (PCLK1 / suréchantillonnage).
+  * @param  workload: Charge mesurée (une ligne de lineLength octets)
+  * @param  lineLength: Octets traités par une exécution de la charge
+  * @param  results: Mesures, une case par profil
+  * @retval true si tous les profils ont été mesurés, false sinon
+  */
+bool Clock_Benchmark(Clock_Workload workload, uint32_t lineLength,
+                     Clock_BenchResult results[CLOCK_PROFILE_COUNT])
+{
+  Clock_Profile previous = activeProfile;
+  bool complete = true;
+
+  if (workload == NULL || lineLength == 0)
+  {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < CLOCK_PROFILE_COUNT; i++)
+  {
+    Clock_BenchResult *result = &results[i];
+    const Clock_ProfileInfo *info = &profiles[i].info;
+
+    memset(result, 0, sizeof(*result));
+    if (!Clock_SetProfile((Clock_Profile)i))
+    {
+      complete = false;
+      continue;
+    }
+
+    result->lineLength = lineLength;
+    result->lineCycles = Clock_MeasureWorkload(workload);
+    result->isrCycles = Clock_MeasureIsr();
+
+    uint32_t oversampling = (huart3.Init.OverSampling == UART_OVERSAMPLING_8) ? 8u : 16u;
+    uint64_t uartMax = info->pclk1Hz / oversampling;
+    uint64_t parseMax = (result->lineCycles == 0) ? uartMax :
+        ((uint64_t)info->sysclkHz * lineLength * CLOCK_UART_BITS) / result->lineCycles;
+    result->maxBaud = (uint32_t)((parseMax < uartMax) ? parseMax : uartMax);
+  }
+
+  if (!Clock_SetProfile(previous))
+  {
+    complete = false;
+  }
+  return complete;
+}
+
+/**
+  * @brief  Gestionnaire de la sonde de latence
+  * @note   Appelé en tête de l'interruption CLOCK_PROBE_IRQn.
+  * @param  None
+  * @retval None
+  */
+ITCM_CODE void Clock_IsrProbe(void)
+{
+  probeStamp = DWT->CYCCNT;
+  probeFired = true;
+}
+
+/**
+  * @brief  Passage de HSI à la PLL selon un profil
+  * @note   Le cœur tourne sur HSI et la PLL est arrêtée à l'appel.
+  * @param  config: Profil à appliquer
+  * @retval true si le profil est appliqué, false sinon
+  */
+static bool Clock_Apply(const Clock_ProfileConfig *config)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  __HAL_PWR_VOLTAGESCALING_CONFIG(voltageScales[config->info.voltageScale - 1]);
+
+  if (config->usePll)
+  {
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+    RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+    RCC_OscInitStruct.PLL.PLLM = CLOCK_PLL_M;
+    RCC_OscInitStruct.PLL.PLLN = config->pllN;
+    RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+    RCC_OscInitStruct.PLL.PLLQ = config->pllQ;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+    {
+      return false;
+    }
+  }
+
+  if (config->info.overdrive && HAL_PWREx_EnableOverDrive() != HAL_OK)
+  {
+    return false;
+  }
+
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = config->usePll ? RCC_SYSCLKSOURCE_PLLCLK : RCC_SYSCLKSOURCE_HSI;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = config->apb1Div;
+  RCC_ClkInitStruct.APB2CLKDivider = config->apb2Div;
+  return HAL_RCC_ClockConfig(&RCC_ClkInitStruct, config->info.flashLatency) == HAL_OK;
+}
+
+/**
+  * @brief  Retour sur HSI, PLL et overdrive arrêtés (profil LOW)
+  * @param  None
+  * @retval None
+  */
+static void Clock_SwitchToHsi(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+  const Clock_ProfileInfo *low = &profiles[CLOCK_PROFILE_LOW].info;
+
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, low->flashLatency) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  if (PWR->CSR1 & PWR_CSR1_ODRDY)
+  {
+    HAL_PWREx_DisableOverDrive();
+  }
+  __HAL_PWR_VOLTAGESCALING_CONFIG(voltageScales[low->voltageScale - 1]);
+}
+
+/**
+  * @brief  Recalcul des périphériques dépendant des horloges de bus
+  * @note   Les prédiviseurs sont préchargés : chaque timer passe à sa
+  *         nouvelle cadence à sa prochaine mise à jour, la période en cours
+  *         est seulement allongée ou raccourcie une fois. Les compteurs de
+  *         charge (LOAD) repartent de zéro avec la nouvelle fréquence.
+  * @param  None
+  * @retval None
+  */
+static void Clock_UpdatePeripherals(void)
+{
+  for (uint32_t i = 0; i < CLOCK_TIMER_COUNT; i++)
+  {
+    uint32_t clock = Clock_GetTimerClock(timers[i].htim->Instance);
+    uint32_t prescaler = (clock + timers[i].counterHz - 1) / timers[i].counterHz;
+    __HAL_TIM_SET_PRESCALER(timers[i].htim, prescaler - 1);
+  }
+
+  UART_UpdateBaudRate();
+  Event_ResetStats();
+}
+
+/**
+  * @brief  Coût minimal d'une exécution de la charge
+  * @param  workload: Charge mesurée
+  * @retval Cycles
+  */
+static uint32_t Clock_MeasureWorkload(Clock_Workload workload)
+{
+  uint32_t best = UINT32_MAX;
+
+  for (uint32_t run = 0; run < CLOCK_BENCH_RUNS; run++)
+  {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t start = DWT->CYCCNT;
+    workload();
+    uint32_t cycles = DWT->CYCCNT - start;
+    __set_PRIMASK(primask);
+
+    if (cycles < best)
+    {
+      best = cycles;
+    }
+  }
+  return best;
+}
+
+/**
+  * @brief  Latence minimale d'entrée dans une interruption
+  * @note   Chaque attente de la sonde est bornée à CLOCK_BENCH_ISR_TIMEOUT
+  *         cycles : une interruption masquée ou désactivée abandonne la
+  *         mesure au lieu de bloquer la boucle principale.
+  * @param  None
+  * @retval Cycles, 0 si la sonde n'a pas été servie
+  */
+static uint32_t Clock_MeasureIsr(void)
+{
+  uint32_t best = UINT32_MAX;
+
+  for (uint32_t sample = 0; sample < CLOCK_BENCH_ISR_SAMPLES; sample++)
+  {
+    probeFired = false;
+    uint32_t start = DWT->CYCCNT;
+    NVIC_SetPendingIRQ(CLOCK_PROBE_IRQn);
+    while (!probeFired)
+    {
+      if (DWT->CYCCNT - start > CLOCK_BENCH_ISR_TIMEOUT)
+      {
+        NVIC_ClearPendingIRQ(CLOCK_PROBE_IRQn);
+        return 0;
+      }
+    }
+
+    uint32_t cycles = probeStamp - start;
+    if (cycles < best)
+    {
+      best = cycles;
+    }
+  }
+  return best;
+}
@@ -15,6 +15,8 @@
   *    - Exemple : "LED1 ON" ou "LED2 OFF"
   *    - <num> : 1 à 3
   *    - <état> : ON ou OFF
+  *    Toutes les LED en une fois : "LEDS <états>", un chiffre 0/1 par LED
+  *    en commençant par LED1 (ex. "LEDS 101"), appliqués simultanément.
   * 
   * 2. Commandes de chenillard :
   *    - Format : "CHENILLARD<num> <fréquence>"
@@ -22,8 +24,69 @@
   *    - <num> : 1 à 3
   *    - <fréquence> : 500MS, 1S ou 3S
   * 
+  * 3. Raccourcis et commandes générales : PAT<num>, FREQ<num>, STOP, STATUS
+  *    "FREQ <ms>" règle une période d'étape quelconque (1 à 60000 ms) ;
+  *    pendant un chenillard, l'étape en cours garde sa fraction écoulée.
+  *    PATLIST liste le catalogue des chenillards ; "PATDEF<num> <étapes>"
+  *    charge un chenillard en RAM, un chiffre 0-7 (masque des LED, bit 0 :
+  *    LED1) par étape, ex. "PATDEF4 1247".
+  *    "PATPROG<num> <offset> <hex>" transmet un programme de chenillard
+  *    (bytecode, voir pattern_controller.h) par morceaux consécutifs en
+  *    hexadécimal, "PATPROG<num> END" le vérifie et le charge ; le
+  *    compilateur stm32_patc de linux_app produit ces lignes.
+  * 
+  *    "PLAYBACK DMA" fait jouer les chenillards par TIM8 et le DMA (fronts
+  *    cadencés par le matériel), "PLAYBACK CPU" revient au timer logiciel.
+  * 
+  *    Luminosité : "DIM<num> <niveau>" règle une LED de 0 à 255 (PWM,
+  *    correction gamma), "FADE<num> <niveau> <ms>" l'y amène par un fondu.
+  *    "PATFADE ON" fait atteindre chaque étape des chenillards par un fondu
+  *    de toute la durée de l'étape (respiration), "PATFADE OFF" l'annule.
+  * 
+  *    LOAD affiche la charge du processeur depuis le LOAD précédent : temps
+  *    éveillé (hors WFI), réveils et événements de la boucle principale.
+  * 
+  *    CLOCK affiche le profil d'horloge actif ; "CLOCK LOW|BALANCED|FULL"
+  *    en change (16, 96 ou 216 MHz), "CLOCK BENCH" mesure chaque profil
+  *    (cycles d'analyse d'une ligne, latence d'interruption, débit maximal).
+  * 
+  *    PROFILE affiche, pour chaque sonde de profilage (voir profiler.h), le
+  *    nombre de mesures, les durées minimale, moyenne et maximale en cycles
+  *    et l'histogramme en puissances de 2 ; "PROFILE RESET" les remet à zéro.
+  * 
+  *    STATS affiche les compteurs de fonctionnement depuis le démarrage, une
+  *    ligne "cle=valeur" chacun (octets reçus et émis, erreurs UART,
+  *    commandes réussies ou en erreur par mot-clé, ticks, étapes perdues,
+  *    plus long passage de la boucle), destinés à une supervision.
+  * 
+  *    "AT <t> <commande>" programme une commande, exécutée par la carte à
+  *    l'instant t (ms) sans la gigue de l'hôte : t absolu depuis le
+  *    démarrage, "+t" relatif à la réception, "@t" relatif au prochain
+  *    "AT GO" (spectacle préchargé puis déclenché d'un coup). "AT" affiche
+  *    la ligne de temps, "AT CLEAR" la vide. Seules les commandes qui
+  *    agissent sans rien afficher peuvent être programmées ; leur réponse
+  *    n'est pas envoyée (compteurs timeline_* de STATS).
+  * 
+  * 4. BINARY : passage au protocole binaire tramé (voir frame_protocol.h),
+  *    destiné à l'automatisation. La trame FRAME_OP_ASCII (ou un reset)
+  *    ramène à la console ASCII.
+  * 
+  * Chaque ligne est analysée au fil des octets reçus par un automate : le
+  * mot-clé est haché pendant sa réception puis recherché dans une table
+  * constante par hachage parfait dès qu'il se termine, le numéro collé au
+  * mot-clé et les arguments numériques sont convertis chiffre par chiffre.
+  * Une ligne invalide est rejetée dès le premier caractère fautif ; à la
+  * réception de '\r', la commande est prête à être exécutée sans nouveau
+  * parcours. Les gestionnaires reçoivent les jetons et valident leurs
+  * arguments ; ajouter une commande ne modifie que la table.
+  * 
   * Le module vérifie la validité des commandes et retourne des messages d'erreur
   * appropriés en cas de commande invalide.
+  * 
+  * Chaque commande reçoit exactement une réponse, terminée par la ligne
+  * "[END]" (ou "[END#n]" pour une commande numérotée "#n"). L'hôte termine la réponse dès qu'il reçoit
+  * ce marqueur, sans attendre de période de silence. Le prompt qui suit reste
+  * destiné à l'utilisateur d'un terminal série.
   ******************************************************************************
   */
 
@@ -33,6 +96,13 @@
 #include "Modules/uart_handler.h"
 #include "Modules/led_controller.h"
 #include "Modules/pattern_controller.h"
+#include "Modules/frame_protocol.h"
+#include "Modules/event_flags.h"
+#include "Modules/clock_profile.h"
+#include "Modules/memory_sections.h"
+#include "Modules/profiler.h"
+#include "Modules/timer_handler.h"
+#include "Modules/command_timeline.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h> // Pour atoi (si on l'utilise, sinon manuelle)
@@ -40,6 +110,7 @@
 
 /* Constantes pour les commandes */
 #define CMD_LED         "LED"
+#define CMD_LEDS        "LEDS"
 #define CMD_CHENILLARD  "CHENILLARD"
 #define CMD_ON          "ON"
 #define CMD_OFF         "OFF"
@@ -47,54 +118,291 @@
 #define CMD_HELP        "HELP"
 #define CMD_STATUS      "STATUS"
 #define CMD_PAT         "PAT"
+#define CMD_PATLIST     "PATLIST"
+#define CMD_PATDEF      "PATDEF"
+#define CMD_PATPROG     "PATPROG"
+#define CMD_END         "END"
 #define CMD_FREQ        "FREQ"
 #define CMD_STOP        "STOP"
 #define CMD_QUIT        "QUIT"
 #define CMD_CLEAR       "CLEAR"
+#define CMD_BINARY      "BINARY"
+#define CMD_PLAYBACK    "PLAYBACK"
+#define CMD_CPU         "CPU"
+#define CMD_DMA         "DMA"
+#define CMD_DIM         "DIM"
+#define CMD_FADE        "FADE"
+#define CMD_PATFADE     "PATFADE"
+#define CMD_LOAD        "LOAD"
+#define CMD_CLOCK       "CLOCK"
+#define CMD_BENCH       "BENCH"
+#define CMD_PROFILE     "PROFILE"
+#define CMD_RESET       "RESET"
+#define CMD_STATS       "STATS"
+#define CMD_AT          "AT"
+#define CMD_GO          "GO"
+
+/* Index de hachage de la table des commandes */
+#define COMMAND_HASH_SLOTS    64      // Cases de l'index (puissance de 2)
+#define COMMAND_HASH_MAX_SEED 1024    // Graines essayées à l'initialisation
+
+#define REPLY_TAG_SIZE        24      // Balise de réponse ("[END#65535]")
+#define PERIOD_TEXT_SIZE      16      // Période affichée ("4294967295MS")
+
+/* Échéance la plus lointaine d'une commande AT (24 h) */
+#define AT_MAX_DELAY_MS       86400000
+
+/* Ligne analysée par CLOCK BENCH (charge de référence) */
+#define CLOCK_BENCH_LINE      "LED1 ON"
+
+
+/* Types privés --------------------------------------------------------------*/
+/* États de l'analyseur lexical : la ligne est analysée au fil des octets
+ * reçus, chaque octet faisant avancer l'automate d'un pas. */
+typedef enum {
+  LEX_START = 0,                    // Début de ligne ('#' ou mot-clé)
+  LEX_SEQUENCE,                     // Chiffres du numéro de séquence "#n"
+  LEX_VERB_START,                   // Premier caractère du mot-clé après "#n "
+  LEX_VERB,                         // Lettres du mot-clé
+  LEX_INDEX,                        // Numéro collé au mot-clé
+  LEX_ARG_START,                    // Espaces avant un argument
+  LEX_ARG,                          // Caractères d'un argument
+  LEX_ERROR                         // Ligne invalide : ignorée jusqu'à '\r'
+} Lexer_State;
+
+/* Ligne en cours de réception, déjà découpée : à la réception de '\r', le
+ * mot-clé a été recherché dans la table et les arguments numériques
+ * convertis. Les positions sont relatives au début de text. */
+typedef struct {
+  char text[COMMAND_BUFFER_SIZE];   // Caractères reçus (majuscules)
+  uint8_t length;                   // Nombre de caractères reçus
+  uint8_t state;                    // État de l'analyseur (Lexer_State)
+  bool empty;                       // Ligne vide (pas de réponse)
+  int32_t sequence;                 // Numéro de séquence (-1 : aucun)
+  uint8_t verbStart;                // Début du mot-clé
+  uint8_t verbLength;               // Longueur du mot-clé
+  uint32_t verbHash;                // Hachage du mot-clé, calculé au fil de l'eau
+  int8_t entry;                     // Indice dans la table (-1 : inconnu)
+  int32_t index;                    // Numéro collé au mot-clé (-1 : absent)
+  uint8_t argCount;                 // Nombre d'arguments
+  uint8_t argStart[MAX_ARGS];       // Début de chaque argument
+  uint8_t argLength[MAX_ARGS];      // Longueur de chaque argument
+  int32_t argValue[MAX_ARGS];       // Valeur numérique (-1 : non numérique)
+} Command_Line;
+
+/* Compteurs d'une entrée de la table (commande STATS) */
+typedef struct {
+  uint32_t ok;                      // Gestionnaire réussi
+  uint32_t err;                     // Gestionnaire en erreur (ou ligne invalide)
+} Command_Counts;
+
+/* Commande découpée transmise aux gestionnaires */
+typedef struct {
+  const char* verb;                 // Mot-clé (lettres uniquement)
+  int32_t index;                    // Numéro collé au mot-clé (-1 : absent)
+  uint8_t argCount;                 // Nombre d'arguments
+  const char* args[MAX_ARGS];       // Arguments séparés par des espaces
+  int32_t values[MAX_ARGS];         // Valeur des arguments numériques (-1 sinon)
+} Command_Tokens;
+
+/* Gestionnaire de commande : retourne false si la commande n'est pas
+ * reconnue (réponse d'erreur générique si aucun message n'a été envoyé) */
+typedef bool (*Command_Handler)(const Command_Tokens* tokens);
+
+/* Entrée de la table des commandes */
+typedef struct {
+  const char* verb;                 // Mot-clé
+  Command_Handler handler;          // Gestionnaire associé
+  bool timed;                       // Programmable par AT (réponse seule, pas d'affichage)
+} Command_Entry;
 
 /* Variables privées ---------------------------------------------------------*/
-static char commandBuffer[COMMAND_BUFFER_SIZE];  // Buffer pour stocker la commande en cours
-static uint8_t bufferIndex = 0;                  // Index dans le buffer
-static bool commandComplete = false;             // Indique si une commande est complète
+/* File des lignes reçues : les octets reçus sont analysés dans la case
+ * d'indice queueHead, validée sur '\r' ; les commandes sont consommées
+ * depuis la case queueTail. Ces variables ne sont manipulées que par la
+ * boucle principale : les interruptions UART s'arrêtent au buffer de
+ * réception. Une case reste toujours libre pour la ligne en cours de
+ * saisie, soit COMMAND_QUEUE_DEPTH - 1 commandes complètes en attente au
+ * maximum. */
+DTCM_DATA static Command_Line commandQueue[COMMAND_QUEUE_DEPTH];
+DTCM_DATA static uint8_t queueHead = 0;          // Case en cours de remplissage
+DTCM_DATA static uint8_t queueTail = 0;          // Prochaine commande à traiter
+DTCM_DATA static bool queueOverflow = false;     // Ligne perdue (file pleine)
+DTCM_DATA static int32_t lostSequence = -1;      // Numéro de la dernière ligne perdue (-1 : aucun)
+static bool replySent = false;                   // Réponse déjà émise pour la commande en cours
+static int32_t currentSequence = -1;             // Numéro de séquence de la commande (-1 : aucun)
+
+/* Mode binaire : les octets reçus sont des trames (voir frame_protocol.h) */
+static bool binaryMode = false;
+static Frame_Decoder frameDecoder;
+
+/* Programme de chenillard en cours de réception (PATPROG) */
+static uint8_t programUpload[PATTERN_PROGRAM_SIZE];
+static uint8_t programUploadLength = 0;          // Octets reçus à la suite
+static int32_t programUploadSlot = -1;           // Emplacement visé (-1 : aucun)
+
+/* Commande programmée en cours d'exécution : réponse non envoyée */
+static bool timedCommand = false;
+
+/* Commande vérifiée par AT : le gestionnaire s'arrête avant tout effet */
+static bool validateOnly = false;
+
+/* Ligne de référence de CLOCK BENCH, analysée hors de la file */
+static Command_Line referenceLine;
+static volatile int8_t referenceEntry;           // Résultat lu : l'analyse n'est pas éliminée
 
 /* Prototypes de fonctions privées -------------------------------------------*/
-static bool Parse_LED_Command(const char* command);
-static bool Parse_Chenillard_ON_Command(const char* command);
-static bool Parse_Chenillard_Frequency_Command(const char* command);
-static bool Parse_Shortcut_Command(const char* command);
-static bool Execute_STOP_Command(void);
-static bool Execute_STATUS_Command(void);
+static bool Parse_LED_Command(const Command_Tokens* tokens);
+static bool Parse_LEDS_Command(const Command_Tokens* tokens);
+static bool Parse_Chenillard_Command(const Command_Tokens* tokens);
+static bool Parse_PAT_Command(const Command_Tokens* tokens);
+static bool Parse_PATDEF_Command(const Command_Tokens* tokens);
+static bool Parse_PATPROG_Command(const Command_Tokens* tokens);
+static int8_t Hex_Digit(char c);
+static bool Execute_PATLIST_Command(const Command_Tokens* tokens);
+static bool Parse_FREQ_Command(const Command_Tokens* tokens);
+static bool Execute_STOP_Command(const Command_Tokens* tokens);
+static bool Execute_STATUS_Command(const Command_Tokens* tokens);
+static bool Execute_BINARY_Command(const Command_Tokens* tokens);
+static bool Parse_PLAYBACK_Command(const Command_Tokens* tokens);
+static bool Parse_DIM_Command(const Command_Tokens* tokens);
+static bool Parse_FADE_Command(const Command_Tokens* tokens);
+static bool Parse_PATFADE_Command(const Command_Tokens* tokens);
+static bool Execute_LOAD_Command(const Command_Tokens* tokens);
+static bool Parse_CLOCK_Command(const Command_Tokens* tokens);
+static void Send_Clock_Benchmark(void);
+static void Parse_Reference_Line(void);
+static bool Parse_PROFILE_Command(const Command_Tokens* tokens);
+#if PROFILE_ENABLED
+static void Send_Profile_Table(void);
+#endif
+static bool Execute_STATS_Command(const Command_Tokens* tokens);
+static bool Parse_AT_Command(const Command_Tokens* tokens);
+static bool Execute_Timed_Command(const char* command);
+static void Send_Counter(const char* key, uint32_t value);
+static bool Start_Pattern_Command(int32_t number, const char* rangeError);
+static bool Set_Frequency_Command(int32_t number, const char* rangeError);
+static bool Set_Period_Command(int32_t periodMs);
+static void Format_Period(char* buffer, size_t size, uint32_t periodMs);
+static void Execute_Command(Command_Line* line);
+static bool Run_Command_Line(Command_Line* line);
+static void Split_Command_Line(Command_Line* line, Command_Tokens* tokens);
+static void Execute_Frame(const Frame_Decoder* frame);
+static uint8_t Execute_Frame_Opcode(const Frame_Decoder* frame, uint8_t* reply, uint8_t* replyLength);
+static void Lexer_Reset(Command_Line* line);
+static void Lexer_Text(Command_Line* line, const char* text);
+static void Lexer_Feed(Command_Line* line, char c);
+static void Lexer_Finish(Command_Line* line);
+static void Lexer_End_Verb(Command_Line* line);
+static bool Lexer_Accumulate(int32_t* value, char digit, int32_t maxValue);
+static int32_t Parse_Number(char** cursor, int32_t maxValue);
+static uint32_t Hash_Verb(const char* verb, uint32_t seed);
+static bool Build_Command_Index(void);
+static int8_t Find_Command(const char* verb, uint8_t length, uint32_t hash);
+static void Format_Reply_Tag(char* buffer, size_t size, const char* tag);
+static void Send_Reply_End(void);
 static void Send_Error_Message(const char* message);
 static void Send_Success_Message(const char* message);
 
+/* Table des commandes -------------------------------------------------------*/
+/* Ajouter une commande revient à ajouter une ligne ici : l'index de hachage
+ * est reconstruit à l'initialisation. */
+static const Command_Entry commandTable[] = {
+  { CMD_STATUS,     Execute_STATUS_Command,   false },
+  { CMD_STOP,       Execute_STOP_Command,     true },
+  { CMD_LED,        Parse_LED_Command,        true },
+  { CMD_LEDS,       Parse_LEDS_Command,       true },
+  { CMD_CHENILLARD, Parse_Chenillard_Command, true },
+  { CMD_PAT,        Parse_PAT_Command,        true },
+  { CMD_PATLIST,    Execute_PATLIST_Command,  false },
+  { CMD_PATDEF,     Parse_PATDEF_Command,     true },
+  { CMD_PATPROG,    Parse_PATPROG_Command,    false },
+  { CMD_FREQ,       Parse_FREQ_Command,       true },
+  { CMD_BINARY,     Execute_BINARY_Command,   false },
+  { CMD_PLAYBACK,   Parse_PLAYBACK_Command,   true },
+  { CMD_DIM,        Parse_DIM_Command,        true },
+  { CMD_FADE,       Parse_FADE_Command,       true },
+  { CMD_PATFADE,    Parse_PATFADE_Command,    true },
+  { CMD_LOAD,       Execute_LOAD_Command,     false },
+  { CMD_CLOCK,      Parse_CLOCK_Command,      false },
+  { CMD_PROFILE,    Parse_PROFILE_Command,    false },
+  { CMD_STATS,      Execute_STATS_Command,    false },
+  { CMD_AT,         Parse_AT_Command,         false },
+};
+#define COMMAND_TABLE_SIZE  (sizeof(commandTable) / sizeof(commandTable[0]))
+
+/* Compteurs depuis le démarrage (commande STATS) */
+static Command_Counts commandCounts[COMMAND_TABLE_SIZE]; // Par entrée de la table
+static uint32_t unknownCommands = 0;             // Mot-clé inconnu ou ligne invalide
+static uint32_t linesLost = 0;                   // Lignes perdues (file pleine)
+
+/* Index de hachage parfait : case -> indice dans la table + 1 (0 : vide) */
+DTCM_DATA static uint8_t commandSlots[COMMAND_HASH_SLOTS];
+DTCM_DATA static uint32_t commandSeed = 0;
+static bool commandIndexReady = false;
+
 /**
   * @brief  Initialisation du module de gestion des commandes
   * @note   Cette fonction initialise toutes les variables du module :
-  *         - Vide le buffer de commande
-  *         - Réinitialise l'index du buffer
-  *         - Désactive le flag de commande complète
+  *         - Vide la file de commandes
+  *         - Prépare l'analyse de la première ligne
+  *         - Efface l'indicateur de débordement de la file
+  *         - Remet à zéro les compteurs de commandes
+  *         - Construit l'index de hachage de la table des commandes
+  *         - Revient à la console ASCII
   * @param  None
   * @retval None
   */
 void Command_Parser_Init(void)
 {
-  memset(commandBuffer, 0, COMMAND_BUFFER_SIZE);
-  bufferIndex = 0;
-  commandComplete = false;
+  memset(commandQueue, 0, sizeof(commandQueue));
+  queueHead = 0;
+  queueTail = 0;
+  queueOverflow = false;
+  lostSequence = -1;
+  memset(commandCounts, 0, sizeof(commandCounts));
+  unknownCommands = 0;
+  linesLost = 0;
+  currentSequence = -1;
+  programUploadLength = 0;
+  programUploadSlot = -1;
+  timedCommand = false;
+  validateOnly = false;
+  Timeline_Init(Execute_Timed_Command);
+  commandIndexReady = Build_Command_Index();
+  Lexer_Reset(&commandQueue[queueHead]);
+  binaryMode = false;
+  Frame_Decoder_Reset(&frameDecoder);
 }
 
 /**
  * @brief  Traite un caractère reçu
+ * @note   Appelée depuis la boucle principale (voir UART_ProcessReceived) :
+ *         chaque caractère fait avancer l'analyseur de la ligne en cours,
+ *         qui n'est exécutée qu'après validation par '\r'. Un retour
+ *         arrière rejoue la ligne restante dans l'analyseur. En mode
+ *         binaire, l'octet est transmis au décodeur de trames et chaque
+ *         trame complète est exécutée aussitôt.
  * @param  c: Caractère reçu
  * @retval Aucun
  */
-void Command_Parser_ProcessChar(char c)
+ITCM_CODE void Command_Parser_ProcessChar(char c)
 {
-  // Si une commande vient d'être traitée, on s'assure que le buffer est prêt
-  if (commandComplete) {
-      memset(commandBuffer, 0, COMMAND_BUFFER_SIZE);
-      bufferIndex = 0;
-      commandComplete = false;
+  Command_Line* line = &commandQueue[queueHead];
+
+  if (binaryMode)
+  {
+    Frame_Result result = Frame_Decoder_Feed(&frameDecoder, (uint8_t)c);
+    if (result == FRAME_COMPLETE)
+    {
+      Execute_Frame(&frameDecoder);
+    }
+    else if (result == FRAME_BAD_CRC)
+    {
+      uint8_t status = FRAME_STATUS_CRC;
+      UART_SendFrame(FRAME_OP_NAK, &status, 1);
+    }
+    return;
   }
 
   // Convertir en majuscule
@@ -109,27 +417,61 @@ void Command_Parser_ProcessChar(char c)
   /* Gestion du retour chariot (fin de commande) */
   if (upperC == '\r')
   {
-    commandBuffer[bufferIndex] = '\0'; // Terminer la chaîne
-    commandComplete = true;
+    Lexer_Finish(line);
+
+    uint8_t nextHead = (queueHead + 1) % COMMAND_QUEUE_DEPTH;
+    if (nextHead == queueTail)
+    {
+      // File pleine : la ligne est abandonnée, signalé par la boucle principale
+      queueOverflow = true;
+      lostSequence = line->sequence;
+      linesLost++;
+      Lexer_Reset(line);
+      return;
+    }
+    queueHead = nextHead;
+    Lexer_Reset(&commandQueue[queueHead]);
     return;
   }
 
   /* Gestion du retour arrière (Backspace) */
   if (upperC == '\b' || upperC == 127) // ASCII Backspace ou DEL
   {
-    if (bufferIndex > 0)
+    if (line->length > 0)
     {
-      bufferIndex--;
-      commandBuffer[bufferIndex] = '\0'; // Effacer le dernier caractère
+      char text[COMMAND_BUFFER_SIZE];
+      uint8_t length = line->length - 1;
+      memcpy(text, line->text, length);
+      Lexer_Reset(line);
+      for (uint8_t i = 0; i < length; i++)
+      {
+        Lexer_Feed(line, text[i]);
+      }
     }
     return;
   }
 
-  /* Stockage du caractère si imprimable et place disponible */
-  if (bufferIndex < COMMAND_BUFFER_SIZE - 1 && isprint((unsigned char)upperC))
+  /* Analyse du caractère s'il est imprimable */
+  if (isprint((unsigned char)upperC))
+  {
+    Lexer_Feed(line, upperC);
+  }
+}
+
+/**
+ * @brief  Traite une plage contiguë d'octets reçus
+ * @note   Chaque octet est mesuré par la sonde PROFILE_PROBE_PROCESS_CHAR.
+ * @param  data: Octets reçus
+ * @param  length: Nombre d'octets
+ * @retval Aucun
+ */
+ITCM_CODE void Command_Parser_ProcessBuffer(const uint8_t* data, uint16_t length)
+{
+  for (uint16_t i = 0; i < length; i++)
   {
-    commandBuffer[bufferIndex] = upperC;
-    bufferIndex++;
+    PROFILE_BEGIN(PROFILE_PROBE_PROCESS_CHAR);
+    Command_Parser_ProcessChar((char)data[i]);
+    PROFILE_END(PROFILE_PROBE_PROCESS_CHAR);
   }
 }
 
@@ -137,337 +479,1787 @@ void Command_Parser_ProcessChar(char c)
   * @brief  Traitement des commandes complètes
   * @note   Cette fonction est appelée périodiquement pour traiter les commandes
   *         complètes. Elle :
-  *         - Vérifie si une commande est prête
-  *         - Analyse la commande selon son type
-  *         - Réinitialise le buffer après traitement
+  *         - Copie chaque commande en attente et libère sa case
+  *         - Exécute la commande
+  *         - Signale une éventuelle ligne perdue (file pleine), après les
+  *           commandes reçues avant elle et avec son numéro de séquence :
+  *           l'hôte termine ainsi la bonne requête, et considère comme
+  *           perdues les lignes numérotées perdues avant elle
   * @param  None
   * @retval None
   */
 void Command_Parser_ProcessCommands(void)
 {
-  if (!commandComplete) { return; }
+  Command_Line command;
+  PROFILE_BEGIN(PROFILE_PROBE_PROCESS_COMMANDS);
+
+  while (queueTail != queueHead) {
+      // La case est libérée avant l'exécution : l'hôte peut envoyer la
+      // commande suivante dès la réception de la réponse
+      memcpy(&command, &commandQueue[queueTail], sizeof(command));
+      queueTail = (queueTail + 1) % COMMAND_QUEUE_DEPTH;
+
+      Execute_Command(&command);
+  }
+
+  if (queueOverflow) {
+      queueOverflow = false;
+      currentSequence = lostSequence;
+      Send_Error_Message("File de commandes pleine, commande perdue");
+      currentSequence = -1;
+  }
 
+  PROFILE_END(PROFILE_PROBE_PROCESS_COMMANDS);
+}
+
+/**
+  * @brief  Exécution d'une commande complète
+  * @note   Une commande peut être préfixée par "#<n> " : le numéro de séquence
+  *         <n> est alors repris dans les balises de la réponse
+  *         ([OK#n], [ERR#n], [END#n]) et le prompt n'est pas renvoyé, ce qui
+  *         permet à l'hôte d'envoyer plusieurs commandes sans attendre.
+  * @param  line: Ligne analysée (copie, modifiée)
+  * @retval None
+  */
+static void Execute_Command(Command_Line* line)
+{
   bool commandProcessed = false;
-  bool isEmptyCommand = (strlen(commandBuffer) == 0); // Vérifier si vide AVANT traitement
+  currentSequence = line->sequence;
+  replySent = false;
 
   // Traitement des commandes principales
-  if (!isEmptyCommand) {
-      if (strcmp(commandBuffer, CMD_STATUS) == 0) {
-          commandProcessed = Execute_STATUS_Command();
-      }
-      else if (strcmp(commandBuffer, CMD_STOP) == 0) {
-          commandProcessed = Execute_STOP_Command();
-      }
-      else if (strncmp(commandBuffer, CMD_LED, strlen(CMD_LED)) == 0) {
-          commandProcessed = Parse_LED_Command(commandBuffer);
-      }
-      else if (strncmp(commandBuffer, CMD_CHENILLARD, strlen(CMD_CHENILLARD)) == 0) {
-          const char* argPart = commandBuffer + strlen(CMD_CHENILLARD);
-          // CHENILLARD<N> ON
-          // Vérifier si le premier char après CHENILLARD est un chiffre et si la fin est " ON"
-          if (strlen(argPart) >= 4 && isdigit((unsigned char)argPart[0]) && strcmp(argPart + 1, " " CMD_ON) == 0) {
-              commandProcessed = Parse_Chenillard_ON_Command(commandBuffer);
-          }
-          // CHENILLARD FREQUENCE<F>
-          else if (strncmp(argPart, " " CMD_FREQ_PREFIX, strlen(" " CMD_FREQ_PREFIX)) == 0) {
-              commandProcessed = Parse_Chenillard_Frequency_Command(commandBuffer);
-          }
-           // Ignorer "CHENILLARD OFF" ou autre format invalide
-          else {
-             commandProcessed = false; // Sera traité comme inconnu plus bas
-          }
-      }
-      else if (strncmp(commandBuffer, CMD_PAT, strlen(CMD_PAT)) == 0 ||
-               strncmp(commandBuffer, CMD_FREQ, strlen(CMD_FREQ)) == 0)
-      {
-          commandProcessed = Parse_Shortcut_Command(commandBuffer);
-      }
+  if (!line->empty) {
+      commandProcessed = Run_Command_Line(line);
 
-      // Si aucune commande n'a été reconnue ou traitée avec succès
-      if (!commandProcessed)
+      // Si aucune commande n'a été reconnue (les handlers ayant échoué ont
+      // déjà envoyé leur propre réponse d'erreur)
+      if (!commandProcessed && !replySent)
       {
           Send_Error_Message("Commande inconnue ou format invalide");
       }
-  } // Fin if (!isEmptyCommand)
-
-  // Réinitialisation (ne plus faire dans ProcessChar)
-  memset(commandBuffer, 0, COMMAND_BUFFER_SIZE);
-  bufferIndex = 0;
-  commandComplete = false; // Marquer comme traitée pour ProcessChar
+  } // Fin if (!line->empty)
 
-  // Afficher le prompt seulement si ce n'était pas une commande vide
-  if (!isEmptyCommand) {
+  // Afficher le prompt seulement pour une commande non vide et non numérotée
+  // (et pas après le passage en mode binaire)
+  if (!line->empty && currentSequence < 0 && !binaryMode) {
     UART_SendString("STM32> ");
   }
+  currentSequence = -1;
 }
 
 /**
-  * @brief  Analyse d'une commande LED
-  * @note   Cette fonction analyse une commande de type LED.
-  *         Format attendu : "LED<num> <état>"
-  *         Exemple : "LED1 ON" ou "LED2 OFF"
-  * @param  command: Commande à analyser
-  * @retval true si la commande est valide, false sinon
+  * @brief  Appel du gestionnaire d'une ligne analysée et comptage
+  * @note   La ligne a été analysée à la réception : il ne reste qu'à
+  *         terminer les jetons dans la copie et à appeler le gestionnaire
+  *         déjà identifié, sans nouveau parcours de la ligne.
+  * @param  line: Ligne analysée (copie, modifiée)
+  * @retval true si le gestionnaire a traité la commande
   */
-static bool Parse_LED_Command(const char* command)
+static bool Run_Command_Line(Command_Line* line)
 {
-  size_t prefixLen = strlen(CMD_LED);
-
-  // Vérification longueur minimale (LED1 ON = 6)
-  if (strlen(command) < prefixLen + 4) { // LEDN ON
-    Send_Error_Message("Format LED invalide (trop court)");
-    return false;
-  }
+  bool commandProcessed = false;
 
-  // Extraction et validation Numéro
-  char ledNumChar = command[prefixLen];
-  if (ledNumChar < '1' || ledNumChar > ('0' + LED_COUNT)) {
-      Send_Error_Message("Numero LED invalide (1-3)");
-      return false;
-  }
-  uint8_t ledNumber = ledNumChar - '0';
+  if (line->state != LEX_ERROR && line->entry >= 0) {
+      Command_Tokens tokens;
 
-  // Vérification Espace
-  if (command[prefixLen + 1] != ' ') {
-      Send_Error_Message("Format LED invalide (espace manquant)");
-      return false;
+      Split_Command_Line(line, &tokens);
+      commandProcessed = commandTable[line->entry].handler(&tokens);
   }
 
-  // Extraction et validation Etat
-  const char* stateStr = &command[prefixLen + 2];
-  LED_State ledState;
-
-  if (strcmp(stateStr, CMD_ON) == 0) {
-    ledState = LED_ON;
-  } else if (strcmp(stateStr, CMD_OFF) == 0) {
-    ledState = LED_OFF;
+  if (line->entry < 0) {
+      unknownCommands++;
+  } else if (commandProcessed) {
+      commandCounts[line->entry].ok++;
   } else {
-    Send_Error_Message("Etat LED invalide (ON/OFF attendu)");
-    return false;
+      commandCounts[line->entry].err++;
   }
+  return commandProcessed;
+}
 
-  // Application et message
-  if (!LED_SetState(ledNumber, ledState)) {
-      Send_Error_Message("Impossible de changer LED (pattern actif?)");
-      return false;
+/**
+  * @brief  Jetons d'une ligne analysée
+  * @param  line: Ligne analysée (copie, modifiée : jetons terminés par '\0')
+  * @param  tokens: Commande découpée (pointe dans la ligne)
+  * @retval None
+  */
+static void Split_Command_Line(Command_Line* line, Command_Tokens* tokens)
+{
+  // Le caractère qui suit le mot-clé (chiffre ou espace) a été lu
+  line->text[line->verbStart + line->verbLength] = '\0';
+  tokens->verb = &line->text[line->verbStart];
+  tokens->index = line->index;
+  tokens->argCount = line->argCount;
+  for (uint8_t i = 0; i < line->argCount; i++) {
+      line->text[line->argStart[i] + line->argLength[i]] = '\0';
+      tokens->args[i] = &line->text[line->argStart[i]];
+      tokens->values[i] = line->argValue[i];
   }
-  char successMsg[30];
-  snprintf(successMsg, sizeof(successMsg), "LED %d mise a %s\r\n", ledNumber, stateStr);
-  Send_Success_Message(successMsg);
-  return true;
 }
 
 /**
-  * @brief  Analyse une commande CHENILLARD<N> ON
-  * @param  command: Commande à analyser
-  * @retval true si la commande est valide et traitée, false sinon
+  * @brief  Exécution d'une commande programmée arrivée à échéance
+  * @note   Appelée par la ligne de temps (Timer_Process, boucle
+  *         principale). La commande a été vérifiée par AT ; sa réponse
+  *         n'est pas envoyée : la carte n'écrit rien que l'hôte n'ait
+  *         demandé, aucune réponse en attente n'est terminée à tort.
+  * @param  command: Commande (majuscules, sans numéro de séquence)
+  * @retval true si la commande a réussi
   */
-static bool Parse_Chenillard_ON_Command(const char* command)
+static bool Execute_Timed_Command(const char* command)
 {
-  // Format: "CHENILLARD<N> ON"
-  size_t prefixLen = strlen(CMD_CHENILLARD); // 10
+  Command_Line line;
+  int32_t sequence = currentSequence;
+  bool processed;
 
-  // Extraction Numéro
-  char patternNumChar = command[prefixLen];
-  if (patternNumChar < '1' || patternNumChar > ('0' + PATTERN_COUNT)) {
-      Send_Error_Message("Numero chenillard invalide (1-3)");
+  Lexer_Text(&line, command);
+  if (line.empty || line.entry < 0 || !commandTable[line.entry].timed) {
       return false;
   }
-  uint8_t patternNumber = patternNumChar - '0';
 
-  // Vérification " ON"
-  if (strcmp(&command[prefixLen + 1], " " CMD_ON) != 0) {
-      Send_Error_Message("Format chenillard ON invalide");
-      return false;
-  }
+  timedCommand = true;
+  currentSequence = -1;
+  processed = Run_Command_Line(&line);
+  timedCommand = false;
+  currentSequence = sequence;
+  return processed;
+}
 
-  // Démarrage et message
-  if (Pattern_Start(patternNumber)) {
-      char msg[40];
-      snprintf(msg, sizeof(msg), "Chenillard %d active\r\n", patternNumber);
-      Send_Success_Message(msg);
-      return true;
-  } else {
-      Send_Error_Message("Impossible de demarrer chenillard");
-      return false;
+/**
+  * @brief  Exécution d'une trame binaire reçue
+  * @note   La réponse est une trame de même code d'opération (avec
+  *         FRAME_REPLY_FLAG) dont le premier octet est le statut.
+  * @param  frame: Décodeur contenant la trame reçue
+  * @retval None
+  */
+static void Execute_Frame(const Frame_Decoder* frame)
+{
+  uint8_t reply[FRAME_MAX_PAYLOAD];
+  uint8_t replyLength = 1;
+
+  reply[0] = Execute_Frame_Opcode(frame, reply, &replyLength);
+  UART_SendFrame(frame->opcode | FRAME_REPLY_FLAG, reply, replyLength);
+
+  // Le retour à la console n'a lieu qu'après l'envoi de la réponse
+  if (frame->opcode == FRAME_OP_ASCII && reply[0] == FRAME_STATUS_OK) {
+      binaryMode = false;
+      Lexer_Reset(&commandQueue[queueHead]);
   }
 }
 
 /**
-  * @brief  Analyse une commande CHENILLARD FREQUENCE<F>
-  * @param  command: Commande à analyser
-  * @retval true si la commande est valide et traitée, false sinon
+  * @brief  Exécution du code d'opération d'une trame
+  * @note   Les commandes appellent directement les modules LED et
+  *         chenillard, sans passer par les messages texte de la console.
+  * @param  frame: Décodeur contenant la trame reçue
+  * @param  reply: Données de la réponse (reply[0] réservé au statut)
+  * @param  replyLength: Longueur de la réponse, statut compris
+  * @retval Code de statut (FRAME_STATUS_xxx)
   */
-static bool Parse_Chenillard_Frequency_Command(const char* command)
+static uint8_t Execute_Frame_Opcode(const Frame_Decoder* frame, uint8_t* reply, uint8_t* replyLength)
 {
-  // Format: "CHENILLARD FREQUENCE<F>"
-  const char* prefix = CMD_CHENILLARD " " CMD_FREQ_PREFIX; // "CHENILLARD FREQUENCE"
-  size_t prefixLen = strlen(prefix);
+  const uint8_t* payload = frame->payload;
 
-  if (strlen(command) != prefixLen + 1 || strncmp(command, prefix, prefixLen) != 0) {
-      Send_Error_Message("Format Frequence invalide");
-      return false;
-  }
+  switch (frame->opcode) {
+      case FRAME_OP_LED:
+          if (frame->length != 2) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (!LED_IsValidNumber(payload[0]) || payload[1] > LED_ON) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          return LED_SetState(payload[0], (LED_State)payload[1]) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
 
-  // Extraction Numéro Fréquence (1, 2, 3)
-  char freqNumChar = command[prefixLen];
-  Pattern_Frequency patternFreq;
-  const char* freqStr = NULL;
+      case FRAME_OP_LEDS:
+          if (frame->length != 1) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if ((payload[0] & ~LED_MASK_ALL) != 0) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          return LED_SetMask(payload[0]) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
 
-  switch (freqNumChar) {
-      case '1': patternFreq = PATTERN_FREQ_500MS; freqStr = "500MS"; break;
-      case '2': patternFreq = PATTERN_FREQ_1S; freqStr = "1S"; break;
-      case '3': patternFreq = PATTERN_FREQ_3S; freqStr = "3S"; break;
-      default:
-          Send_Error_Message("Numero Frequence invalide (1-3)");
-          return false;
-  }
+      case FRAME_OP_PATTERN:
+          if (frame->length != 1) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (payload[0] < 1 || payload[0] > Pattern_GetCount()) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          return Pattern_Start((Pattern_Type)payload[0]) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
 
-  // Mise à jour et message
-  if (Pattern_SetFrequency(patternFreq)) {
-      char msg[40];
-      snprintf(msg, sizeof(msg), "Frequence reglee a %s\r\n", freqStr);
-      Send_Success_Message(msg);
-      return true;
-  } else {
-      Send_Error_Message("Impossible de regler frequence");
-      return false;
+      case FRAME_OP_PATDEF:
+          if (frame->length < 2) {
+              return FRAME_STATUS_LENGTH;
+          }
+          return Pattern_Define(payload[0], &payload[1], frame->length - 1) ? FRAME_STATUS_OK : FRAME_STATUS_ARGUMENT;
+
+      case FRAME_OP_FREQ:
+          if (frame->length == 2) {
+              // Période libre en millisecondes, comme FREQ <ms>
+              uint32_t periodMs = ((uint32_t)payload[0] << 8) | payload[1];
+              return Pattern_SetPeriod(periodMs) ? FRAME_STATUS_OK : FRAME_STATUS_ARGUMENT;
+          }
+          if (frame->length != 1) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (payload[0] < 1 || payload[0] > 3) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          // Même numérotation que FREQ<n> : 1 : 500MS, 2 : 1S, 3 : 3S
+          return Pattern_SetFrequency((Pattern_Frequency)(payload[0] - 1)) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
+
+      case FRAME_OP_PLAYBACK:
+          if (frame->length != 1) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (payload[0] > PATTERN_PLAYBACK_DMA) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          return Pattern_SetPlayback((Pattern_Playback)payload[0]) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
+
+      case FRAME_OP_DIM:
+          if (frame->length != 2) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (!LED_IsValidNumber(payload[0])) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          return LED_SetLevel(payload[0], payload[1]) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
+
+      case FRAME_OP_FADE:
+          if (frame->length != 4) {
+              return FRAME_STATUS_LENGTH;
+          } else {
+              uint32_t durationMs = ((uint32_t)payload[2] << 8) | payload[3];
+              if (!LED_IsValidNumber(payload[0]) || durationMs > LED_FADE_MAX_MS) {
+                  return FRAME_STATUS_ARGUMENT;
+              }
+              return LED_Fade(payload[0], payload[1], durationMs) ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
+          }
+
+      case FRAME_OP_PATFADE:
+          if (frame->length != 1) {
+              return FRAME_STATUS_LENGTH;
+          }
+          if (payload[0] > 1) {
+              return FRAME_STATUS_ARGUMENT;
+          }
+          Pattern_SetFade(payload[0] != 0);
+          return FRAME_STATUS_OK;
+
+      case FRAME_OP_STOP:
+          if (frame->length != 0) {
+              return FRAME_STATUS_LENGTH;
+          }
+          return Pattern_Stop() ? FRAME_STATUS_OK : FRAME_STATUS_FAILED;
+
+      case FRAME_OP_STATUS:
+          if (frame->length != 0) {
+              return FRAME_STATUS_LENGTH;
+          }
+          for (uint8_t i = 1; i <= LED_COUNT; i++) {
+              reply[i] = (uint8_t)LED_GetState(i);
+          }
+          reply[LED_COUNT + 1] = (uint8_t)Pattern_GetActive();
+          // Fréquence prédéfinie (1 à 3, 0 : période libre) puis période
+          reply[LED_COUNT + 2] = (Pattern_GetFrequency() == PATTERN_FREQ_CUSTOM) ? 0 : (uint8_t)Pattern_GetFrequency() + 1;
+          reply[LED_COUNT + 3] = (uint8_t)(Pattern_GetPeriod() >> 8);
+          reply[LED_COUNT + 4] = (uint8_t)(Pattern_GetPeriod() & 0xFF);
+          *replyLength = LED_COUNT + 5;
+          return FRAME_STATUS_OK;
+
+      case FRAME_OP_ASCII:
+          return (frame->length == 0) ? FRAME_STATUS_OK : FRAME_STATUS_LENGTH;
+
+      default:
+          return FRAME_STATUS_OPCODE;
   }
 }
 
 /**
-  * @brief  Analyse une commande raccourci (PAT, FREQ, STOP)
-  * @param  command: Commande à analyser
-  * @retval true si la commande est valide et traitée, false sinon
+  * @brief  Préparation de l'analyse d'une nouvelle ligne
+  * @param  line: Case de la file à préparer
+  * @retval None
   */
-static bool Parse_Shortcut_Command(const char* command)
-{
-    // STOP
-    if (strcmp(command, CMD_STOP) == 0) {
-        return Execute_STOP_Command(); // Appelle la fonction dédiée
-    }
-    // PAT<N>
-    else if (strncmp(command, CMD_PAT, strlen(CMD_PAT)) == 0 && strlen(command) == strlen(CMD_PAT) + 1) {
-        char patternNumChar = command[strlen(CMD_PAT)];
-        if (patternNumChar >= '1' && patternNumChar <= ('0' + PATTERN_COUNT)) {
-            uint8_t patternNumber = patternNumChar - '0';
-            if (Pattern_Start(patternNumber)) {
-                char msg[40];
-                snprintf(msg, sizeof(msg), "Chenillard %d active\r\n", patternNumber);
-                Send_Success_Message(msg);
-                return true;
-            } else {
-                Send_Error_Message("Impossible de demarrer chenillard");
-                return false;
-            }
-        } else {
-             Send_Error_Message("Numero PAT invalide (1-3)");
-             return false;
-        }
-    }
-    // FREQ<F>
-    else if (strncmp(command, CMD_FREQ, strlen(CMD_FREQ)) == 0 && strlen(command) == strlen(CMD_FREQ) + 1) {
-        char freqNumChar = command[strlen(CMD_FREQ)];
-        Pattern_Frequency patternFreq;
-        const char* freqStr = NULL;
-
-        switch (freqNumChar) {
-            case '1': patternFreq = PATTERN_FREQ_500MS; freqStr = "500MS"; break;
-            case '2': patternFreq = PATTERN_FREQ_1S; freqStr = "1S"; break;
-            case '3': patternFreq = PATTERN_FREQ_3S; freqStr = "3S"; break;
-            default:
-                 Send_Error_Message("Numero FREQ invalide (1-3)");
-                 return false;
-        }
-
-        if (Pattern_SetFrequency(patternFreq)) {
-            char msg[40];
-            snprintf(msg, sizeof(msg), "Frequence reglee a %s\r\n", freqStr);
-            Send_Success_Message(msg);
-            return true;
-        } else {
-             Send_Error_Message("Impossible de regler frequence");
-             return false;
-        }
-    }
-
-    Send_Error_Message("Raccourci invalide");
-    return false;
+ITCM_CODE static void Lexer_Reset(Command_Line* line)
+{
+  line->length = 0;
+  line->state = LEX_START;
+  line->empty = false;
+  line->sequence = -1;
+  line->verbStart = 0;
+  line->verbLength = 0;
+  line->verbHash = 2166136261u ^ commandSeed;
+  line->entry = -1;
+  line->index = -1;
+  line->argCount = 0;
 }
 
 /**
-  * @brief  Execute le STOP command
-  * @retval true si la commande est traitée avec succès, false sinon
+  * @brief  Analyse d'une ligne complète hors de la file de réception
+  * @param  line: Ligne à remplir
+  * @param  text: Texte de la ligne (majuscules, sans '\r')
+  * @retval None
   */
-static bool Execute_STOP_Command(void)
+static void Lexer_Text(Command_Line* line, const char* text)
 {
-    if (Pattern_Stop()) {
-        Send_Success_Message("Chenillard arrete\r\n");
-        return true;
-    } else {
-        Send_Error_Message("Aucun chenillard actif a arreter");
-        // Considérer comme traité pour éviter "commande inconnue"
-        return true;
-    }
+  Lexer_Reset(line);
+  while (*text != '\0') {
+      Lexer_Feed(line, *text++);
+  }
+  Lexer_Finish(line);
 }
 
 /**
-  * @brief  Execute le STATUS command
-  * @retval true si la commande est traitée avec succès, false sinon
+  * @brief  Analyse d'un caractère de la ligne en cours
+  * @note   Format : [#<seq> ]<MOT-CLE>[<numéro>] [arg1] [arg2] ...
+  *         Le mot-clé (lettres) est haché au fil de l'eau et recherché dans
+  *         la table dès qu'il se termine ; les arguments numériques sont
+  *         convertis chiffre par chiffre. Dès qu'une erreur est détectée
+  *         (caractère inattendu, mot-clé inconnu, nombre trop grand, trop
+  *         d'arguments), la ligne passe à l'état LEX_ERROR et les
+  *         caractères suivants ne sont plus analysés. La réponse d'erreur
+  *         n'est envoyée qu'à la fin de la ligne, pour garder une seule
+  *         réponse par commande.
+  * @param  line: Ligne en cours
+  * @param  c: Caractère reçu (majuscule, imprimable)
+  * @retval None
   */
-static bool Execute_STATUS_Command(void)
+ITCM_CODE static void Lexer_Feed(Command_Line* line, char c)
 {
-    char buffer[80];
-    UART_SendString("--- Statut ---\r\n");
+  uint8_t position = line->length;
+  bool isLetter = (c >= 'A' && c <= 'Z');
+  bool isDigit = (c >= '0' && c <= '9');
 
-    // LEDs
-    for (uint8_t i = 1; i <= LED_COUNT; i++) {
-        snprintf(buffer, sizeof(buffer), "LED %d: %s\r\n", i, (LED_GetState(i) == LED_ON) ? CMD_ON : CMD_OFF);
-        UART_SendString(buffer);
-    }
+  if (position >= COMMAND_BUFFER_SIZE - 1)
+  {
+    line->state = LEX_ERROR; // Ligne trop longue
+    return;
+  }
+  line->text[position] = c;
+  line->length++;
 
-    // Chenillard
-    Pattern_Type activePat = Pattern_GetActive();
-    Pattern_Frequency currentFreq = Pattern_GetFrequency();
-    const char* freqStr = (currentFreq == PATTERN_FREQ_500MS) ? "500MS" : ((currentFreq == PATTERN_FREQ_1S) ? "1S" : "3S");
-    if (activePat == PATTERN_NONE) {
-        snprintf(buffer, sizeof(buffer), "Chenillard: INACTIF (Freq select: %s)\r\n", freqStr);
-    } else {
-        snprintf(buffer, sizeof(buffer), "Chenillard: ACTIF (Pattern: %d, Freq: %s)\r\n", activePat, freqStr);
-    }
-    UART_SendString(buffer);
+  switch (line->state)
+  {
+    case LEX_START:
+      if (c == '#') {
+          line->state = LEX_SEQUENCE;
+          line->sequence = 0;
+          break;
+      }
+      /* Pas de préfixe : le caractère commence le mot-clé */
+      /* fall through */
+    case LEX_VERB_START:
+      if (!isLetter) {
+          line->state = LEX_ERROR;
+          break;
+      }
+      line->verbStart = position;
+      line->state = LEX_VERB;
+      /* fall through */
+    case LEX_VERB:
+      if (isLetter) {
+          line->verbHash = (line->verbHash ^ (uint8_t)c) * 16777619u;
+          line->verbLength++;
+      } else if (isDigit) {
+          Lexer_End_Verb(line);
+          if (line->state != LEX_ERROR) {
+              line->index = c - '0';
+              line->state = LEX_INDEX;
+          }
+      } else if (c == ' ') {
+          Lexer_End_Verb(line);
+          if (line->state != LEX_ERROR) {
+              line->state = LEX_ARG_START;
+          }
+      } else {
+          line->state = LEX_ERROR;
+      }
+      break;
 
-    // Overflow UART?
-    if (UART_HasOverflow()) {
-        UART_SendString("Attention: Debordement buffer UART detecte!\r\n");
+    case LEX_SEQUENCE:
+      if (isDigit && Lexer_Accumulate(&line->sequence, c, COMMAND_MAX_SEQUENCE)) {
+          break;
+      }
+      if (c == ' ' && position > 1) {
+          line->state = LEX_VERB_START;
+          break;
+      }
+      line->sequence = -1; // Préfixe invalide : réponse sans numéro
+      line->state = LEX_ERROR;
+      break;
+
+    case LEX_INDEX:
+      if (isDigit && Lexer_Accumulate(&line->index, c, COMMAND_MAX_NUMBER)) {
+          break;
+      }
+      line->state = (c == ' ') ? LEX_ARG_START : LEX_ERROR;
+      break;
+
+    case LEX_ARG_START:
+      if (c == ' ') {
+          break;
+      }
+      if (line->argCount >= MAX_ARGS) {
+          line->state = LEX_ERROR;
+          break;
+      }
+      line->argStart[line->argCount] = position;
+      line->argLength[line->argCount] = 0;
+      line->argValue[line->argCount] = isDigit ? 0 : -1;
+      line->argCount++;
+      line->state = LEX_ARG;
+      /* fall through */
+    case LEX_ARG:
+    {
+      uint8_t arg = line->argCount - 1;
+      if (c == ' ') {
+          line->state = LEX_ARG_START;
+          break;
+      }
+      line->argLength[arg]++;
+      if (line->argValue[arg] >= 0 &&
+          (!isDigit || !Lexer_Accumulate(&line->argValue[arg], c, COMMAND_MAX_NUMBER))) {
+          line->argValue[arg] = -1; // Argument non numérique (ou trop grand)
+      }
+      break;
     }
 
-    return true;
+    case LEX_ERROR:
+    default:
+      break;
+  }
 }
 
 /**
-  * @brief  Envoi d'un message de succès
+  * @brief  Fin d'analyse de la ligne, à la réception de '\r'
+  * @param  line: Ligne en cours
+  * @retval None
   */
-static void Send_Success_Message(const char* message)
+ITCM_CODE static void Lexer_Finish(Command_Line* line)
 {
-    char buffer[100];
-    // Assurer que le message original finit par \r\n pour la clarté
-    size_t msgLen = strlen(message);
-    if (msgLen > 2 && message[msgLen-2] == '\r' && message[msgLen-1] == '\n') {
-        snprintf(buffer, sizeof(buffer), "[OK] %s", message);
-    } else {
-        snprintf(buffer, sizeof(buffer), "[OK] %s\r\n", message);
-    }
-    UART_SendString(buffer);
+  switch (line->state)
+  {
+    case LEX_START:
+    case LEX_VERB_START:
+      line->empty = true;
+      break;
+    case LEX_SEQUENCE:
+      line->sequence = -1;
+      line->state = LEX_ERROR;
+      break;
+    case LEX_VERB:
+      Lexer_End_Verb(line);
+      break;
+    default:
+      break;
+  }
 }
 
 /**
-  * @brief  Envoi d'un message d'erreur
+  * @brief  Fin du mot-clé : recherche immédiate dans la table
+  * @note   Un mot-clé inconnu fait passer la ligne en erreur sans attendre
+  *         la fin de la ligne.
+  * @param  line: Ligne en cours
+  * @retval None
   */
-static void Send_Error_Message(const char* message)
+ITCM_CODE static void Lexer_End_Verb(Command_Line* line)
 {
-    char buffer[100];
-    snprintf(buffer, sizeof(buffer), "[ERR] %s\r\n", message);
-    UART_SendString(buffer);
+  line->entry = Find_Command(&line->text[line->verbStart], line->verbLength, line->verbHash);
+  if (line->entry < 0) {
+      line->state = LEX_ERROR;
+  }
 }
 
+/**
+  * @brief  Ajout d'un chiffre à une valeur en cours de lecture
+  * @param  value: Valeur à compléter
+  * @param  digit: Chiffre reçu
+  * @param  maxValue: Valeur maximale acceptée
+  * @retval true si la valeur reste dans les limites, false sinon
+  */
+ITCM_CODE static bool Lexer_Accumulate(int32_t* value, char digit, int32_t maxValue)
+{
+  int32_t next = *value * 10 + (digit - '0');
+  if (next > maxValue) {
+      return false;
+  }
+  *value = next;
+  return true;
+}
+
+/**
+  * @brief  Lecture d'un nombre décimal
+  * @param  cursor: Position de lecture, avancée après le dernier chiffre
+  * @param  maxValue: Valeur maximale acceptée (jusqu'à INT32_MAX)
+  * @retval Valeur lue, -1 si absente ou trop grande
+  * @note   Le dépassement est détecté avant le calcul : value * 10 + digit
+  *         ne peut jamais déborder, quelle que soit la limite.
+  */
+static int32_t Parse_Number(char** cursor, int32_t maxValue)
+{
+  char* p = *cursor;
+  int32_t value = 0;
+
+  if (!isdigit((unsigned char)*p)) {
+      return -1;
+  }
+  while (isdigit((unsigned char)*p)) {
+      int32_t digit = *p - '0';
+      if (digit > maxValue || value > (maxValue - digit) / 10) {
+          return -1;
+      }
+      value = value * 10 + digit;
+      p++;
+  }
+  *cursor = p;
+  return value;
+}
+
+/**
+  * @brief  Fonction de hachage d'un mot-clé (FNV-1a avec graine)
+  * @param  verb: Mot-clé
+  * @param  seed: Graine de la table de hachage parfaite
+  * @retval Valeur de hachage
+  */
+static uint32_t Hash_Verb(const char* verb, uint32_t seed)
+{
+  uint32_t hash = 2166136261u ^ seed;
+  while (*verb != '\0') {
+      hash ^= (uint8_t)*verb++;
+      hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+  * @brief  Construction de l'index de hachage parfait de la table
+  * @note   Cherche une graine pour laquelle tous les mots-clés de la table
+  *         tombent dans des cases distinctes : une recherche se réduit alors
+  *         à un calcul de hachage et une seule comparaison de chaîne.
+  * @param  None
+  * @retval true si une graine sans collision a été trouvée, false sinon
+  */
+static bool Build_Command_Index(void)
+{
+  for (uint32_t seed = 0; seed < COMMAND_HASH_MAX_SEED; seed++) {
+      bool collision = false;
+      memset(commandSlots, 0, sizeof(commandSlots));
+
+      for (uint8_t i = 0; i < COMMAND_TABLE_SIZE && !collision; i++) {
+          uint32_t slot = Hash_Verb(commandTable[i].verb, seed) & (COMMAND_HASH_SLOTS - 1);
+          if (commandSlots[slot] != 0) {
+              collision = true;
+          } else {
+              commandSlots[slot] = i + 1;
+          }
+      }
+
+      if (!collision) {
+          commandSeed = seed;
+          return true;
+      }
+  }
+
+  memset(commandSlots, 0, sizeof(commandSlots));
+  return false;
+}
+
+/**
+  * @brief  Recherche d'un mot-clé dans la table des commandes
+  * @note   Le hachage est calculé par l'appelant (au fil des caractères
+  *         reçus). Recherche linéaire si aucun index de hachage n'a pu être
+  *         construit.
+  * @param  verb: Mot-clé (non terminé)
+  * @param  length: Longueur du mot-clé
+  * @param  hash: Hachage du mot-clé (Hash_Verb avec commandSeed)
+  * @retval Indice dans la table, -1 si le mot-clé est inconnu
+  */
+ITCM_CODE static int8_t Find_Command(const char* verb, uint8_t length, uint32_t hash)
+{
+  if (commandIndexReady) {
+      uint8_t slot = commandSlots[hash & (COMMAND_HASH_SLOTS - 1)];
+      if (slot != 0 && strncmp(commandTable[slot - 1].verb, verb, length) == 0 &&
+          commandTable[slot - 1].verb[length] == '\0') {
+          return (int8_t)(slot - 1);
+      }
+      return -1;
+  }
+
+  for (uint8_t i = 0; i < COMMAND_TABLE_SIZE; i++) {
+      if (strncmp(commandTable[i].verb, verb, length) == 0 && commandTable[i].verb[length] == '\0') {
+          return (int8_t)i;
+      }
+  }
+  return -1;
+}
+
+/**
+  * @brief  Analyse d'une commande LED
+  * @note   Cette fonction analyse une commande de type LED.
+  *         Format attendu : "LED<num> <état>"
+  *         Exemple : "LED1 ON" ou "LED2 OFF"
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide, false sinon
+  */
+static bool Parse_LED_Command(const Command_Tokens* tokens)
+{
+  if (tokens->index < 0 || tokens->argCount != 1) {
+    Send_Error_Message("Format LED invalide (LED<num> ON/OFF)");
+    return false;
+  }
+
+  // Validation Numéro
+  if (tokens->index < 1 || tokens->index > LED_COUNT) {
+      Send_Error_Message("Numero LED invalide (1-3)");
+      return false;
+  }
+  uint8_t ledNumber = (uint8_t)tokens->index;
+
+  // Validation Etat
+  const char* stateStr = tokens->args[0];
+  LED_State ledState;
+
+  if (strcmp(stateStr, CMD_ON) == 0) {
+    ledState = LED_ON;
+  } else if (strcmp(stateStr, CMD_OFF) == 0) {
+    ledState = LED_OFF;
+  } else {
+    Send_Error_Message("Etat LED invalide (ON/OFF attendu)");
+    return false;
+  }
+  if (validateOnly) {
+    return true;
+  }
+
+  // Application et message
+  if (!LED_SetState(ledNumber, ledState)) {
+      Send_Error_Message("Impossible de changer LED (pattern actif?)");
+      return false;
+  }
+  char successMsg[30];
+  snprintf(successMsg, sizeof(successMsg), "LED %d mise a %s\r\n", ledNumber, stateStr);
+  Send_Success_Message(successMsg);
+  return true;
+}
+
+/**
+  * @brief  Analyse d'une commande LEDS <états>
+  * @note   Un chiffre par LED, LED1 en premier : "LEDS 101" allume LED1 et
+  *         LED3 et éteint LED2 en une seule écriture du port.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_LEDS_Command(const Command_Tokens* tokens)
+{
+  if (tokens->index >= 0 || tokens->argCount != 1 || strlen(tokens->args[0]) != LED_COUNT) {
+    Send_Error_Message("Format LEDS invalide (LEDS 101 : LED1 a LED3)");
+    return false;
+  }
+
+  // Conversion "101" -> masque (LED1 au bit 0)
+  uint32_t mask = 0;
+  for (uint8_t i = 0; i < LED_COUNT; i++) {
+      char bit = tokens->args[0][i];
+      if (bit != '0' && bit != '1') {
+          Send_Error_Message("Etat LEDS invalide (0 ou 1 par LED)");
+          return false;
+      }
+      if (bit == '1') {
+          mask |= LED_MASK(i + 1);
+      }
+  }
+  if (validateOnly) {
+      return true;
+  }
+
+  if (!LED_SetMask(mask)) {
+      Send_Error_Message("Impossible de changer LED (pattern actif?)");
+      return false;
+  }
+  char successMsg[30];
+  snprintf(successMsg, sizeof(successMsg), "LEDs mises a %s\r\n", tokens->args[0]);
+  Send_Success_Message(successMsg);
+  return true;
+}
+
+/**
+  * @brief  Analyse une commande CHENILLARD<N> ON ou CHENILLARD FREQUENCE<F>
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_Chenillard_Command(const Command_Tokens* tokens)
+{
+  if (tokens->argCount != 1) {
+      return false;
+  }
+
+  // CHENILLARD<N> ON
+  if (tokens->index >= 0) {
+      if (strcmp(tokens->args[0], CMD_ON) != 0) {
+          Send_Error_Message("Format chenillard ON invalide");
+          return false;
+      }
+      return Start_Pattern_Command(tokens->index, "Numero chenillard invalide (voir PATLIST)");
+  }
+
+  // CHENILLARD FREQUENCE<F>
+  size_t prefixLen = strlen(CMD_FREQ_PREFIX);
+  if (strncmp(tokens->args[0], CMD_FREQ_PREFIX, prefixLen) == 0) {
+      char* cursor = (char*)tokens->args[0] + prefixLen;
+      int32_t frequency = Parse_Number(&cursor, COMMAND_MAX_NUMBER);
+      if (frequency < 0 || *cursor != '\0') {
+          Send_Error_Message("Format Frequence invalide");
+          return false;
+      }
+      return Set_Frequency_Command(frequency, "Numero Frequence invalide (1-3)");
+  }
+
+  return false;
+}
+
+/**
+  * @brief  Analyse une commande raccourci PAT<N>
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PAT_Command(const Command_Tokens* tokens)
+{
+  if (tokens->index < 0 || tokens->argCount != 0) {
+      Send_Error_Message("Format PAT invalide (PAT<num>)");
+      return false;
+  }
+  return Start_Pattern_Command(tokens->index, "Numero PAT invalide (voir PATLIST)");
+}
+
+/**
+  * @brief  Analyse une commande raccourci FREQ<F> ou FREQ <ms>
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_FREQ_Command(const Command_Tokens* tokens)
+{
+  // FREQ <ms> : période libre
+  if (tokens->index < 0 && tokens->argCount == 1) {
+      return Set_Period_Command(tokens->values[0]);
+  }
+  if (tokens->index < 0 || tokens->argCount != 0) {
+      Send_Error_Message("Format FREQ invalide (FREQ<num> ou FREQ <ms>)");
+      return false;
+  }
+  return Set_Frequency_Command(tokens->index, "Numero FREQ invalide (1-3)");
+}
+
+/**
+  * @brief  Démarrage d'un chenillard (CHENILLARD<N> ON et PAT<N>)
+  * @param  number: Numéro du chenillard
+  * @param  rangeError: Message d'erreur si le numéro est hors limites
+  * @retval true si le chenillard a démarré, false sinon
+  */
+static bool Start_Pattern_Command(int32_t number, const char* rangeError)
+{
+  Pattern_Definition definition;
+  if (number < 1 || !Pattern_GetDefinition((uint8_t)number, &definition)) {
+      Send_Error_Message(rangeError);
+      return false;
+  }
+  // Un emplacement vide peut être chargé d'ici l'échéance (PATDEF programmé)
+  if (validateOnly) {
+      return true;
+  }
+  if (definition.length == 0 && definition.code == NULL) {
+      Send_Error_Message("Chenillard vide (charger par PATDEF ou PATPROG)");
+      return false;
+  }
+
+  if (Pattern_Start((Pattern_Type)number)) {
+      char msg[40];
+      snprintf(msg, sizeof(msg), "Chenillard %d active\r\n", (int)number);
+      Send_Success_Message(msg);
+      return true;
+  } else {
+      Send_Error_Message("Impossible de demarrer chenillard");
+      return false;
+  }
+}
+
+/**
+  * @brief  Chargement d'un chenillard : PATDEF<N> <étapes>
+  * @note   Un chiffre 0-7 par étape, masque des LED (1 : LED1, 2 : LED2,
+  *         4 : LED3) ; seuls les emplacements après les chenillards
+  *         prédéfinis peuvent être chargés.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PATDEF_Command(const Command_Tokens* tokens)
+{
+  if (tokens->index < 0 || tokens->argCount != 1) {
+      Send_Error_Message("Format PATDEF invalide (PATDEF<num> <etapes 0-7>)");
+      return false;
+  }
+  if (tokens->index <= PATTERN_BUILTIN_COUNT || tokens->index > Pattern_GetCount()) {
+      Send_Error_Message("Numero PATDEF invalide (emplacement charge, voir PATLIST)");
+      return false;
+  }
+
+  const char* text = tokens->args[0];
+  size_t length = strlen(text);
+  uint8_t steps[PATTERN_MAX_STEPS];
+  if (length > PATTERN_MAX_STEPS) {
+      Send_Error_Message("Trop d'etapes pour PATDEF");
+      return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+      if (text[i] < '0' || text[i] > '7') {
+          Send_Error_Message("Etape PATDEF invalide (0-7 par etape)");
+          return false;
+      }
+      steps[i] = (uint8_t)(text[i] - '0');
+  }
+  if (validateOnly) {
+      return true;
+  }
+
+  if (!Pattern_Define((uint8_t)tokens->index, steps, (uint8_t)length)) {
+      Send_Error_Message("Impossible de charger le chenillard");
+      return false;
+  }
+  char msg[40];
+  snprintf(msg, sizeof(msg), "Chenillard %d charge (%u etapes)\r\n", (int)tokens->index, (unsigned)length);
+  Send_Success_Message(msg);
+  return true;
+}
+
+/**
+  * @brief  Chargement d'un programme : PATPROG<N> <offset> <hex> puis
+  *         PATPROG<N> END
+  * @note   Le bytecode arrive en morceaux consécutifs (deux chiffres
+  *         hexadécimaux par octet) : l'offset 0 commence un nouveau
+  *         programme, les suivants doivent prolonger exactement les octets
+  *         déjà reçus. END fait vérifier et charger le programme par
+  *         Pattern_DefineProgram ; un programme refusé est abandonné.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PATPROG_Command(const Command_Tokens* tokens)
+{
+  char msg[48];
+
+  if (tokens->index < 0 || tokens->argCount < 1 || tokens->argCount > 2) {
+      Send_Error_Message("Format PATPROG invalide (PATPROG<num> <offset> <hex> | END)");
+      return false;
+  }
+  if (tokens->index <= PATTERN_BUILTIN_COUNT || tokens->index > Pattern_GetCount()) {
+      Send_Error_Message("Numero PATPROG invalide (emplacement charge, voir PATLIST)");
+      return false;
+  }
+
+  /* Fin de transmission : vérification et chargement */
+  if (tokens->argCount == 1) {
+      if (strcmp(tokens->args[0], CMD_END) != 0) {
+          Send_Error_Message("Format PATPROG invalide (PATPROG<num> <offset> <hex> | END)");
+          return false;
+      }
+      if (programUploadSlot != tokens->index || programUploadLength == 0) {
+          Send_Error_Message("Aucun programme recu pour cet emplacement");
+          return false;
+      }
+      uint8_t length = programUploadLength;
+      programUploadSlot = -1;
+      programUploadLength = 0;
+      if (!Pattern_DefineProgram((uint8_t)tokens->index, programUpload, length)) {
+          Send_Error_Message("Programme refuse (bytecode invalide)");
+          return false;
+      }
+      snprintf(msg, sizeof(msg), "Programme %d charge (%u instructions)\r\n",
+               (int)tokens->index, (unsigned)(length / PATTERN_VM_INSN_SIZE));
+      Send_Success_Message(msg);
+      return true;
+  }
+
+  /* Morceau de bytecode */
+  int32_t offset = tokens->values[0];
+  const char* hex = tokens->args[1];
+  size_t digits = strlen(hex);
+  if (offset < 0 || (digits % 2) != 0) {
+      Send_Error_Message("Morceau PATPROG invalide (offset, octets en hexadecimal)");
+      return false;
+  }
+  if (offset > 0 && (programUploadSlot != tokens->index || offset != programUploadLength)) {
+      Send_Error_Message("Offset PATPROG inattendu (reprendre a 0)");
+      return false;
+  }
+  if ((size_t)offset + digits / 2 > PATTERN_PROGRAM_SIZE) {
+      Send_Error_Message("Programme trop long pour PATPROG");
+      return false;
+  }
+
+  for (size_t i = 0; i < digits; i += 2) {
+      int8_t high = Hex_Digit(hex[i]);
+      int8_t low = Hex_Digit(hex[i + 1]);
+      if (high < 0 || low < 0) {
+          Send_Error_Message("Morceau PATPROG invalide (offset, octets en hexadecimal)");
+          return false;
+      }
+      programUpload[offset + i / 2] = (uint8_t)((high << 4) | low);
+  }
+  programUploadSlot = tokens->index;
+  programUploadLength = (uint8_t)(offset + digits / 2);
+
+  snprintf(msg, sizeof(msg), "Programme %d: %u octets recus\r\n",
+           (int)tokens->index, (unsigned)programUploadLength);
+  Send_Success_Message(msg);
+  return true;
+}
+
+/**
+  * @brief  Valeur d'un chiffre hexadécimal (majuscules, voir Lexer_Feed)
+  * @param  c: Caractère
+  * @retval Valeur de 0 à 15, -1 si ce n'est pas un chiffre hexadécimal
+  */
+static int8_t Hex_Digit(char c)
+{
+  if (c >= '0' && c <= '9') {
+      return (int8_t)(c - '0');
+  }
+  if (c >= 'A' && c <= 'F') {
+      return (int8_t)(c - 'A' + 10);
+  }
+  return -1;
+}
+
+/**
+  * @brief  Réglage de la fréquence (CHENILLARD FREQUENCE<F> et FREQ<F>)
+  * @param  number: Numéro de fréquence (1 : 500MS, 2 : 1S, 3 : 3S)
+  * @param  rangeError: Message d'erreur si le numéro est hors limites
+  * @retval true si la fréquence a été réglée, false sinon
+  */
+static bool Set_Frequency_Command(int32_t number, const char* rangeError)
+{
+  Pattern_Frequency patternFreq;
+  const char* freqStr = NULL;
+
+  switch (number) {
+      case 1: patternFreq = PATTERN_FREQ_500MS; freqStr = "500MS"; break;
+      case 2: patternFreq = PATTERN_FREQ_1S; freqStr = "1S"; break;
+      case 3: patternFreq = PATTERN_FREQ_3S; freqStr = "3S"; break;
+      default:
+          Send_Error_Message(rangeError);
+          return false;
+  }
+  if (validateOnly) {
+      return true;
+  }
+
+  // Mise à jour et message
+  if (Pattern_SetFrequency(patternFreq)) {
+      char msg[40];
+      snprintf(msg, sizeof(msg), "Frequence reglee a %s\r\n", freqStr);
+      Send_Success_Message(msg);
+      return true;
+  } else {
+      Send_Error_Message("Impossible de regler frequence");
+      return false;
+  }
+}
+
+/**
+  * @brief  Réglage d'une période d'étape libre (FREQ <ms>)
+  * @param  periodMs: Période en millisecondes (-1 si l'argument n'est pas
+  *         numérique)
+  * @retval true si la période a été réglée, false sinon
+  */
+static bool Set_Period_Command(int32_t periodMs)
+{
+  if (periodMs < PATTERN_PERIOD_MIN_MS || periodMs > PATTERN_PERIOD_MAX_MS) {
+      Send_Error_Message("Periode invalide (1-60000 ms)");
+      return false;
+  }
+  if (validateOnly) {
+      return true;
+  }
+
+  if (Pattern_SetPeriod((uint32_t)periodMs)) {
+      char period[PERIOD_TEXT_SIZE];
+      char msg[40];
+      Format_Period(period, sizeof(period), (uint32_t)periodMs);
+      snprintf(msg, sizeof(msg), "Frequence reglee a %s\r\n", period);
+      Send_Success_Message(msg);
+      return true;
+  } else {
+      Send_Error_Message("Impossible de regler frequence");
+      return false;
+  }
+}
+
+/**
+  * @brief  Écriture d'une période au format des fréquences (500MS, 1S, ...)
+  * @param  buffer: Buffer de sortie (PERIOD_TEXT_SIZE octets suffisent)
+  * @param  size: Taille du buffer
+  * @param  periodMs: Période en millisecondes
+  * @retval None
+  */
+static void Format_Period(char* buffer, size_t size, uint32_t periodMs)
+{
+  if (periodMs % 1000 == 0) {
+      snprintf(buffer, size, "%uS", (unsigned)(periodMs / 1000));
+  } else {
+      snprintf(buffer, size, "%uMS", (unsigned)periodMs);
+  }
+}
+
+/**
+  * @brief  Execute le STOP command
+  * @param  tokens: Commande découpée (sans argument)
+  * @retval true si la commande est traitée avec succès, false sinon
+  */
+static bool Execute_STOP_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+    if (validateOnly) {
+        return true;
+    }
+
+    if (Pattern_Stop()) {
+        Send_Success_Message("Chenillard arrete\r\n");
+        return true;
+    } else {
+        // Réponse d'erreur déjà envoyée : pas de "commande inconnue"
+        Send_Error_Message("Aucun chenillard actif a arreter");
+        return false;
+    }
+}
+
+/**
+  * @brief  Execute le STATUS command
+  * @param  tokens: Commande découpée (sans argument)
+  * @retval true si la commande est traitée avec succès, false sinon
+  */
+static bool Execute_STATUS_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+
+    char buffer[96];
+    UART_SendString("--- Statut ---\r\n");
+
+    // LEDs (niveau affiché s'il est intermédiaire)
+    for (uint8_t i = 1; i <= LED_COUNT; i++) {
+        uint8_t level = LED_GetLevel(i);
+        if (level != 0 && level != LED_LEVEL_MAX) {
+            snprintf(buffer, sizeof(buffer), "LED %d: %s (niveau %u/%u)\r\n", i, CMD_ON, (unsigned)level, LED_LEVEL_MAX);
+        } else {
+            snprintf(buffer, sizeof(buffer), "LED %d: %s\r\n", i, (LED_GetState(i) == LED_ON) ? CMD_ON : CMD_OFF);
+        }
+        UART_SendString(buffer);
+    }
+
+    // Chenillard
+    Pattern_Type activePat = Pattern_GetActive();
+    char freqStr[PERIOD_TEXT_SIZE];
+    const char* playbackStr = (Pattern_GetPlayback() == PATTERN_PLAYBACK_DMA) ? CMD_DMA : CMD_CPU;
+    const char* fadeStr = Pattern_GetFade() ? CMD_ON : CMD_OFF;
+    Format_Period(freqStr, sizeof(freqStr), Pattern_GetPeriod());
+    if (activePat == PATTERN_NONE) {
+        snprintf(buffer, sizeof(buffer), "Chenillard: INACTIF (Freq select: %s, Lecture: %s, Fondu: %s)\r\n", freqStr, playbackStr, fadeStr);
+    } else {
+        snprintf(buffer, sizeof(buffer), "Chenillard: ACTIF (Pattern: %d, Freq: %s, Lecture: %s, Fondu: %s)\r\n", activePat, freqStr, playbackStr, fadeStr);
+    }
+    UART_SendString(buffer);
+
+    // Overflow UART?
+    if (UART_HasOverflow()) {
+        UART_SendString("Attention: Debordement buffer UART detecte!\r\n");
+    }
+
+    // Emission UART
+    UART_TxStats txStats;
+    UART_GetTxStats(&txStats);
+    snprintf(buffer, sizeof(buffer), "TX UART: max %lu/%u octets, perdus %lu\r\n",
+             (unsigned long)txStats.highWater, UART_TX_RING_SIZE, (unsigned long)txStats.dropped);
+    UART_SendString(buffer);
+
+    Send_Reply_End();
+    return true;
+}
+
+/**
+  * @brief  Execute le PATLIST command : catalogue des chenillards
+  * @param  tokens: Commande découpée (sans argument)
+  * @retval true si la commande est traitée avec succès, false sinon
+  */
+static bool Execute_PATLIST_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+
+    char buffer[60];
+    Pattern_Definition definition;
+    for (uint8_t i = 1; Pattern_GetDefinition(i, &definition); i++) {
+        if (definition.code != NULL) {
+            snprintf(buffer, sizeof(buffer), "PAT%u: %s, %u octets\r\n",
+                     (unsigned)i, definition.name, (unsigned)definition.codeLength);
+        } else if (definition.length == 0) {
+            snprintf(buffer, sizeof(buffer), "PAT%u: vide\r\n", (unsigned)i);
+        } else {
+            snprintf(buffer, sizeof(buffer), "PAT%u: %s, %u etapes\r\n",
+                     (unsigned)i, definition.name, (unsigned)definition.length);
+        }
+        UART_SendString(buffer);
+    }
+
+    Send_Reply_End();
+    return true;
+}
+
+/**
+  * @brief  Passage en mode binaire (poignée de main)
+  * @note   La réponse [OK] est envoyée en texte, sans prompt ; les octets
+  *         suivants sont ensuite décodés comme des trames jusqu'à la trame
+  *         FRAME_OP_ASCII. L'hôte doit attendre la fin de cette réponse
+  *         avant d'envoyer sa première trame.
+  * @param  tokens: Commande découpée (sans argument)
+  * @retval true si la commande est traitée avec succès, false sinon
+  */
+static bool Execute_BINARY_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+
+    Send_Success_Message("Mode binaire actif\r\n");
+    Frame_Decoder_Reset(&frameDecoder);
+    binaryMode = true;
+    return true;
+}
+
+/**
+  * @brief  Analyse une commande PLAYBACK CPU|DMA
+  * @note   En lecture DMA, les étapes sont jouées par TIM8 et le DMA sans
+  *         passer par la boucle principale (voir dma_player.c).
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PLAYBACK_Command(const Command_Tokens* tokens)
+{
+    Pattern_Playback mode;
+
+    if (tokens->index >= 0 || tokens->argCount != 1) {
+        Send_Error_Message("Format PLAYBACK invalide (PLAYBACK CPU|DMA)");
+        return false;
+    }
+    if (strcmp(tokens->args[0], CMD_CPU) == 0) {
+        mode = PATTERN_PLAYBACK_CPU;
+    } else if (strcmp(tokens->args[0], CMD_DMA) == 0) {
+        mode = PATTERN_PLAYBACK_DMA;
+    } else {
+        Send_Error_Message("Lecture invalide (CPU ou DMA)");
+        return false;
+    }
+    if (validateOnly) {
+        return true;
+    }
+
+    if (Pattern_SetPlayback(mode)) {
+        char msg[40];
+        snprintf(msg, sizeof(msg), "Lecture chenillard: %s\r\n", tokens->args[0]);
+        Send_Success_Message(msg);
+        return true;
+    } else {
+        Send_Error_Message("Impossible de changer la lecture");
+        return false;
+    }
+}
+
+/**
+  * @brief  Analyse une commande DIM<num> <niveau>
+  * @note   Niveau de 0 (éteinte) à LED_LEVEL_MAX (allumée) ; les niveaux
+  *         intermédiaires passent par le PWM de la LED.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_DIM_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index < 0 || tokens->argCount != 1) {
+        Send_Error_Message("Format DIM invalide (DIM<num> <niveau>)");
+        return false;
+    }
+    if (tokens->index < 1 || tokens->index > LED_COUNT) {
+        Send_Error_Message("Numero LED invalide (1-3)");
+        return false;
+    }
+    if (tokens->values[0] < 0 || tokens->values[0] > LED_LEVEL_MAX) {
+        Send_Error_Message("Niveau invalide (0-255)");
+        return false;
+    }
+    if (validateOnly) {
+        return true;
+    }
+
+    if (!LED_SetLevel((uint8_t)tokens->index, (uint8_t)tokens->values[0])) {
+        Send_Error_Message("Impossible de changer LED (pattern actif?)");
+        return false;
+    }
+    char msg[40];
+    snprintf(msg, sizeof(msg), "LED %ld au niveau %ld\r\n", (long)tokens->index, (long)tokens->values[0]);
+    Send_Success_Message(msg);
+    return true;
+}
+
+/**
+  * @brief  Analyse une commande FADE<num> <niveau> <ms>
+  * @note   Le fondu se déroule ensuite sans autre commande (timer des
+  *         fondus du module LED).
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_FADE_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index < 0 || tokens->argCount != 2) {
+        Send_Error_Message("Format FADE invalide (FADE<num> <niveau> <ms>)");
+        return false;
+    }
+    if (tokens->index < 1 || tokens->index > LED_COUNT) {
+        Send_Error_Message("Numero LED invalide (1-3)");
+        return false;
+    }
+    if (tokens->values[0] < 0 || tokens->values[0] > LED_LEVEL_MAX) {
+        Send_Error_Message("Niveau invalide (0-255)");
+        return false;
+    }
+    if (tokens->values[1] < 0 || tokens->values[1] > LED_FADE_MAX_MS) {
+        Send_Error_Message("Duree invalide (0-60000 ms)");
+        return false;
+    }
+    if (validateOnly) {
+        return true;
+    }
+
+    if (!LED_Fade((uint8_t)tokens->index, (uint8_t)tokens->values[0], (uint32_t)tokens->values[1])) {
+        Send_Error_Message("Impossible de changer LED (pattern actif?)");
+        return false;
+    }
+    char msg[64];
+    snprintf(msg, sizeof(msg), "LED %ld vers le niveau %ld en %ld ms\r\n",
+             (long)tokens->index, (long)tokens->values[0], (long)tokens->values[1]);
+    Send_Success_Message(msg);
+    return true;
+}
+
+/**
+  * @brief  Analyse une commande PATFADE ON|OFF
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PATFADE_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 1) {
+        Send_Error_Message("Format PATFADE invalide (PATFADE ON|OFF)");
+        return false;
+    }
+    bool fade;
+    if (strcmp(tokens->args[0], CMD_ON) == 0) {
+        fade = true;
+    } else if (strcmp(tokens->args[0], CMD_OFF) == 0) {
+        fade = false;
+    } else {
+        Send_Error_Message("Etat PATFADE invalide (ON/OFF attendu)");
+        return false;
+    }
+    if (validateOnly) {
+        return true;
+    }
+    Pattern_SetFade(fade);
+
+    char msg[40];
+    snprintf(msg, sizeof(msg), "Fondu chenillard: %s\r\n", tokens->args[0]);
+    Send_Success_Message(msg);
+    return true;
+}
+
+/**
+  * @brief  Execute le LOAD command : charge de la boucle principale
+  * @note   Les compteurs couvrent la période écoulée depuis le LOAD
+  *         précédent (ou le démarrage), puis sont remis à zéro : deux LOAD
+  *         encadrent une mesure. Le temps éveillé comprend la boucle et
+  *         les interruptions.
+  * @param  tokens: Commande découpée (sans argument)
+  * @retval true si la commande est traitée avec succès, false sinon
+  */
+static bool Execute_LOAD_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+
+    Event_Stats stats;
+    char buffer[80];
+    Event_GetStats(&stats);
+    Event_ResetStats();
+
+    uint32_t load = (stats.totalCycles == 0) ? 0 : (uint32_t)((stats.awakeCycles * 10000u) / stats.totalCycles);
+    uint32_t totalMs = (stats.cyclesPerMs == 0) ? 0 : (uint32_t)(stats.totalCycles / stats.cyclesPerMs);
+    uint32_t awakeUs = (stats.cyclesPerMs == 0) ? 0 : (uint32_t)((stats.awakeCycles * 1000u) / stats.cyclesPerMs);
+
+    snprintf(buffer, sizeof(buffer), "Charge: %lu.%02lu%% (eveille %lu us sur %lu ms)\r\n",
+             (unsigned long)(load / 100), (unsigned long)(load % 100),
+             (unsigned long)awakeUs, (unsigned long)totalMs);
+    UART_SendString(buffer);
+    snprintf(buffer, sizeof(buffer), "Reveils: %lu, passages boucle: %lu\r\n",
+             (unsigned long)stats.wakeups, (unsigned long)stats.dispatches);
+    UART_SendString(buffer);
+    snprintf(buffer, sizeof(buffer), "Evenements: timer %lu, reception UART %lu\r\n",
+             (unsigned long)stats.posted[EVENT_ID_TIMER], (unsigned long)stats.posted[EVENT_ID_UART_RX]);
+    UART_SendString(buffer);
+
+    Send_Reply_End();
+    return true;
+}
+
+/**
+  * @brief  Analyse une commande CLOCK [LOW|BALANCED|FULL|BENCH]
+  * @note   Sans argument, affiche le profil actif, les accélérateurs et
+  *         le placement du parseur (ITCM, DTCM). Le changement de profil
+  *         vide d'abord l'émission : la réponse part au nouveau débit
+  *         recalculé, inchangé pour l'hôte.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_CLOCK_Command(const Command_Tokens* tokens)
+{
+    Clock_Profile profile;
+    char buffer[96];
+
+    if (tokens->index >= 0 || tokens->argCount > 1) {
+        Send_Error_Message("Format CLOCK invalide (CLOCK [LOW|BALANCED|FULL|BENCH])");
+        return false;
+    }
+
+    if (tokens->argCount == 0) {
+        const Clock_ProfileInfo* info = Clock_GetInfo(Clock_GetProfile());
+        uint32_t accelerators = Clock_GetAccelerators();
+
+        snprintf(buffer, sizeof(buffer), "Horloge: %s (%lu MHz, APB1 %lu MHz, APB2 %lu MHz)\r\n",
+                 info->name, (unsigned long)(info->sysclkHz / 1000000u),
+                 (unsigned long)(info->pclk1Hz / 1000000u), (unsigned long)(info->pclk2Hz / 1000000u));
+        UART_SendString(buffer);
+        snprintf(buffer, sizeof(buffer), "Flash: %u WS, echelle %u, overdrive %s\r\n",
+                 (unsigned)info->flashLatency, (unsigned)info->voltageScale, info->overdrive ? CMD_ON : CMD_OFF);
+        UART_SendString(buffer);
+        snprintf(buffer, sizeof(buffer), "Caches: I %s, D %s, ART %s\r\n",
+                 (accelerators & CLOCK_ACCEL_ICACHE) ? CMD_ON : CMD_OFF,
+                 (accelerators & CLOCK_ACCEL_DCACHE) ? CMD_ON : CMD_OFF,
+                 (accelerators & CLOCK_ACCEL_ART) ? CMD_ON : CMD_OFF);
+        UART_SendString(buffer);
+        snprintf(buffer, sizeof(buffer), "Placement: analyse en %s, file en %s\r\n",
+                 MEMORY_IN_ITCM(Command_Parser_ProcessChar) ? "ITCM" : "flash",
+                 MEMORY_IN_DTCM(commandQueue) ? "DTCM" : "SRAM");
+        UART_SendString(buffer);
+        Send_Reply_End();
+        return true;
+    }
+
+    if (strcmp(tokens->args[0], CMD_BENCH) == 0) {
+        Send_Clock_Benchmark();
+        return true;
+    }
+
+    if (!Clock_FindProfile(tokens->args[0], &profile)) {
+        Send_Error_Message("Profil invalide (LOW, BALANCED ou FULL)");
+        return false;
+    }
+    if (!Clock_SetProfile(profile)) {
+        Send_Error_Message("Echec du changement d'horloge, retour a LOW");
+        return false;
+    }
+
+    snprintf(buffer, sizeof(buffer), "Horloge: %s (%lu MHz)\r\n", tokens->args[0],
+             (unsigned long)(Clock_GetInfo(profile)->sysclkHz / 1000000u));
+    Send_Success_Message(buffer);
+    return true;
+}
+
+/**
+  * @brief  Tableau des mesures de CLOCK BENCH
+  * @note   Les mesures sont prises profil par profil, puis le profil actif
+  *         est rétabli avant l'envoi du tableau.
+  * @param  None
+  * @retval None
+  */
+static void Send_Clock_Benchmark(void)
+{
+    Clock_BenchResult results[CLOCK_PROFILE_COUNT];
+    char buffer[96];
+
+    if (!Clock_Benchmark(Parse_Reference_Line, strlen(CLOCK_BENCH_LINE) + 1, results)) {
+        Send_Error_Message("Mesure incomplete (changement d'horloge refuse)");
+        return;
+    }
+
+    snprintf(buffer, sizeof(buffer), "Ligne \"%s\" (%lu octets), meilleur de %u essais\r\n",
+             CLOCK_BENCH_LINE, (unsigned long)results[0].lineLength, (unsigned)CLOCK_BENCH_RUNS);
+    UART_SendString(buffer);
+    UART_SendString("profil      MHz  WS  analyse (cycles)  latence IT (cycles)  debit max (bauds)\r\n");
+    for (uint32_t i = 0; i < CLOCK_PROFILE_COUNT; i++) {
+        const Clock_ProfileInfo* info = Clock_GetInfo((Clock_Profile)i);
+        if (results[i].isrCycles == 0) {
+            // Sonde de latence jamais servie (interruption masquée)
+            snprintf(buffer, sizeof(buffer), "%-10s %4lu %3u %17lu %20s %18lu\r\n",
+                     info->name, (unsigned long)(info->sysclkHz / 1000000u), (unsigned)info->flashLatency,
+                     (unsigned long)results[i].lineCycles, "non servie",
+                     (unsigned long)results[i].maxBaud);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%-10s %4lu %3u %17lu %20lu %18lu\r\n",
+                     info->name, (unsigned long)(info->sysclkHz / 1000000u), (unsigned)info->flashLatency,
+                     (unsigned long)results[i].lineCycles, (unsigned long)results[i].isrCycles,
+                     (unsigned long)results[i].maxBaud);
+        }
+        UART_SendString(buffer);
+    }
+    Send_Reply_End();
+}
+
+/**
+  * @brief  Charge de référence de CLOCK BENCH
+  * @note   Analyse CLOCK_BENCH_LINE suivie de '\r' dans une ligne hors de la
+  *         file : la ligne en cours de réception n'est pas touchée et rien
+  *         n'est exécuté.
+  * @param  None
+  * @retval None
+  */
+static void Parse_Reference_Line(void)
+{
+    Lexer_Text(&referenceLine, CLOCK_BENCH_LINE);
+    referenceEntry = referenceLine.entry;
+}
+
+/**
+  * @brief  Analyse une commande PROFILE [RESET]
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_PROFILE_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount > 1 ||
+        (tokens->argCount == 1 && strcmp(tokens->args[0], CMD_RESET) != 0)) {
+        Send_Error_Message("Format PROFILE invalide (PROFILE [RESET])");
+        return false;
+    }
+
+#if PROFILE_ENABLED
+    if (tokens->argCount == 1) {
+        Profile_Reset();
+        Send_Success_Message("Mesures de profilage remises a zero");
+        return true;
+    }
+
+    Send_Profile_Table();
+    return true;
+#else
+    Send_Error_Message("Profilage non compile (PROFILE_ENABLED a 0)");
+    return false;
+#endif
+}
+
+#if PROFILE_ENABLED
+/**
+  * @brief  Tableau des mesures de PROFILE
+  * @note   Une ligne par sonde (durées en cycles, coût de la sonde
+  *         retranché), puis une ligne "HIST" par sonde : "<i>:<n>" pour
+  *         n mesures de 2^i à 2^(i+1)-1 cycles, cases vides omises.
+  * @param  None
+  * @retval None
+  */
+static void Send_Profile_Table(void)
+{
+    Profile_Stats stats;
+    char buffer[96];
+
+    snprintf(buffer, sizeof(buffer), "Coeur %lu MHz, cout d'une sonde %lu cycles (retranche)\r\n",
+             (unsigned long)(Clock_GetInfo(Clock_GetProfile())->sysclkHz / 1000000u),
+             (unsigned long)Profile_GetOverhead());
+    UART_SendString(buffer);
+    UART_SendString("sonde                 appels        min        moy        max\r\n");
+    for (uint32_t i = 0; i < PROFILE_PROBE_COUNT; i++) {
+        Profile_GetStats((Profile_Probe)i, &stats);
+        snprintf(buffer, sizeof(buffer), "%-16s %11lu %10lu %10lu %10lu\r\n",
+                 Profile_GetName((Profile_Probe)i), (unsigned long)stats.count, (unsigned long)stats.min,
+                 (unsigned long)(stats.count ? stats.sum / stats.count : 0), (unsigned long)stats.max);
+        UART_SendString(buffer);
+    }
+    for (uint32_t i = 0; i < PROFILE_PROBE_COUNT; i++) {
+        Profile_GetStats((Profile_Probe)i, &stats);
+        snprintf(buffer, sizeof(buffer), "HIST %s", Profile_GetName((Profile_Probe)i));
+        UART_SendString(buffer);
+        for (uint32_t bin = 0; bin < PROFILE_HISTOGRAM_BINS; bin++) {
+            if (stats.histogram[bin] != 0) {
+                snprintf(buffer, sizeof(buffer), " %lu:%lu", (unsigned long)bin, (unsigned long)stats.histogram[bin]);
+                UART_SendString(buffer);
+            }
+        }
+        UART_SendString("\r\n");
+    }
+    Send_Reply_End();
+}
+#endif
+
+/**
+  * @brief  Exécute la commande STATS
+  * @note   Compteurs depuis le démarrage, jamais remis à zéro par la
+  *         lecture : une ligne "cle=valeur" par compteur, valeur décimale.
+  *         Les compteurs par mot-clé sont nommés "cmd.<MOT>.ok" et
+  *         "cmd.<MOT>.err", dans l'ordre de la table. La ligne STATS en
+  *         cours n'est comptée qu'après sa réponse.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Execute_STATS_Command(const Command_Tokens* tokens)
+{
+    if (tokens->index >= 0 || tokens->argCount != 0) {
+        return false;
+    }
+
+    UART_RxStats rxStats;
+    UART_TxStats txStats;
+    Event_Stats eventStats;
+    Timeline_Stats timeline;
+    char key[24];
+
+    UART_GetRxStats(&rxStats);
+    UART_GetTxStats(&txStats);
+    Event_GetStats(&eventStats);
+    Timeline_GetStats(&timeline);
+
+    Send_Counter("rx_bytes", rxStats.bytes);
+    Send_Counter("rx_lost", rxStats.lost);
+    Send_Counter("tx_bytes", txStats.bytes);
+    Send_Counter("tx_dropped", txStats.dropped);
+    Send_Counter("uart_ore", rxStats.overrun);
+    Send_Counter("uart_fe", rxStats.framing);
+    Send_Counter("uart_ne", rxStats.noise);
+    Send_Counter("uart_pe", rxStats.parity);
+    Send_Counter("uart_dma", rxStats.dma);
+    Send_Counter("timer_ticks", Timer_GetTicks());
+    Send_Counter("missed_steps", Pattern_GetMissedSteps());
+    Send_Counter("pattern_faults", Pattern_GetProgramFaults());
+    Send_Counter("timeline_run", timeline.executed);
+    Send_Counter("timeline_err", timeline.failed);
+    Send_Counter("timeline_late_max_ms", timeline.maxLateMs);
+    Send_Counter("loop_max_us", eventStats.maxLoopUs);
+    Send_Counter("lines_lost", linesLost);
+    Send_Counter("cmd_unknown", unknownCommands);
+    for (uint8_t i = 0; i < COMMAND_TABLE_SIZE; i++) {
+        snprintf(key, sizeof(key), "cmd.%s.ok", commandTable[i].verb);
+        Send_Counter(key, commandCounts[i].ok);
+        snprintf(key, sizeof(key), "cmd.%s.err", commandTable[i].verb);
+        Send_Counter(key, commandCounts[i].err);
+    }
+
+    Send_Reply_End();
+    return true;
+}
+
+/**
+  * @brief  Commande programmée : AT <t> <commande>, AT GO, AT CLEAR ou AT
+  * @note   <t> en ms : "12000" absolu (ticks depuis le démarrage, affichés
+  *         par AT), "+500" après la réception, "@500" après le prochain
+  *         AT GO. La commande est vérifiée dès maintenant : un mot-clé
+  *         inconnu ou non programmable (affichage, AT) est refusé, puis son
+  *         gestionnaire contrôle format, numéros et plages d'arguments sans
+  *         rien appliquer (validateOnly) ; son message d'erreur est la
+  *         réponse à AT. Seul ce qui dépend de l'état à l'échéance (LED
+  *         tenue par un chenillard, emplacement vide, chenillard actif) est
+  *         vérifié à l'exécution.
+  * @param  tokens: Commande découpée
+  * @retval true si la commande est valide et traitée, false sinon
+  */
+static bool Parse_AT_Command(const Command_Tokens* tokens)
+{
+    char msg[96];
+    uint32_t now = Timer_GetTicks();
+    uint32_t next;
+
+    if (tokens->index >= 0) {
+        Send_Error_Message("Format AT invalide (AT <t|+t|@t> <commande> | GO | CLEAR)");
+        return false;
+    }
+
+    /* Consultation et commandes de la ligne de temps */
+    if (tokens->argCount == 0) {
+        int written = snprintf(msg, sizeof(msg), "t=%lu ms, %u programmee(s), %u retenue(s)",
+                               (unsigned long)now, (unsigned)Timeline_GetCount(),
+                               (unsigned)Timeline_GetHeldCount());
+        if (Timeline_GetNext(&next)) {
+            snprintf(msg + written, sizeof(msg) - written, ", prochaine a t=%lu ms", (unsigned long)next);
+        }
+        Send_Success_Message(msg);
+        return true;
+    }
+    if (tokens->argCount == 1) {
+        if (strcmp(tokens->args[0], CMD_GO) == 0) {
+            uint8_t armed = Timeline_Go();
+            snprintf(msg, sizeof(msg), "%u commande(s) declenchee(s) a t=%lu ms",
+                     (unsigned)armed, (unsigned long)now);
+            Send_Success_Message(msg);
+            return true;
+        }
+        if (strcmp(tokens->args[0], CMD_CLEAR) == 0) {
+            Timeline_Clear();
+            Send_Success_Message("Ligne de temps videe");
+            return true;
+        }
+        Send_Error_Message("Format AT invalide (AT <t|+t|@t> <commande> | GO | CLEAR)");
+        return false;
+    }
+
+    /* Échéance : absolue, relative à la réception ou au déclenchement */
+    const char* time = tokens->args[0];
+    char mode = (time[0] == '+' || time[0] == '@') ? time[0] : '\0';
+    char* cursor = (char*)time + ((mode != '\0') ? 1 : 0);
+    int32_t value = Parse_Number(&cursor, (mode != '\0') ? AT_MAX_DELAY_MS : INT32_MAX);
+    uint32_t due = (uint32_t)value;
+
+    if (value < 0 || *cursor != '\0') {
+        Send_Error_Message("Instant AT invalide (t, +t ou @t en ms, 24 h au plus)");
+        return false;
+    }
+    if (mode == '+') {
+        due = now + (uint32_t)value;
+    } else if (mode == '\0') {
+        int32_t delta = (int32_t)(due - now);
+        if (delta < 0 || delta > AT_MAX_DELAY_MS) {
+            snprintf(msg, sizeof(msg), "Instant AT passe ou a plus de 24 h (t=%lu ms)", (unsigned long)now);
+            Send_Error_Message(msg);
+            return false;
+        }
+    }
+
+    /* Commande : arguments suivants, vérifiée par l'analyseur */
+    char command[COMMAND_BUFFER_SIZE];
+    Command_Line line;
+    size_t length = 0;
+    command[0] = '\0';
+    for (uint8_t i = 1; i < tokens->argCount && length < sizeof(command); i++) {
+        length += (size_t)snprintf(command + length, sizeof(command) - length, "%s%s",
+                                   (i > 1) ? " " : "", tokens->args[i]);
+    }
+    Lexer_Text(&line, command);
+    if (line.state == LEX_ERROR || line.entry < 0 || line.sequence >= 0 ||
+        !commandTable[line.entry].timed) {
+        Send_Error_Message("Commande non programmable par AT");
+        return false;
+    }
+
+    /* Arguments : le gestionnaire s'arrête avant d'appliquer la commande */
+    Command_Tokens lineTokens;
+    bool valid;
+    Split_Command_Line(&line, &lineTokens);
+    replySent = false;
+    validateOnly = true;
+    valid = commandTable[line.entry].handler(&lineTokens);
+    validateOnly = false;
+    if (!valid) {
+        if (!replySent) {
+            Send_Error_Message("Commande programmee invalide");
+        }
+        return false;
+    }
+
+    if (!Timeline_Add(due, mode == '@', command)) {
+        snprintf(msg, sizeof(msg), "Ligne de temps pleine (%d commandes)", TIMELINE_DEPTH);
+        Send_Error_Message(msg);
+        return false;
+    }
+    if (mode == '@') {
+        snprintf(msg, sizeof(msg), "%s retenue a GO+%lu ms (%u retenue(s))",
+                 command, (unsigned long)due, (unsigned)Timeline_GetHeldCount());
+    } else {
+        snprintf(msg, sizeof(msg), "%s programmee a t=%lu ms (%u programmee(s))",
+                 command, (unsigned long)due, (unsigned)Timeline_GetCount());
+    }
+    Send_Success_Message(msg);
+    return true;
+}
+
+/**
+  * @brief  Envoi d'une ligne "cle=valeur" de STATS
+  * @param  key: Nom du compteur
+  * @param  value: Valeur
+  */
+static void Send_Counter(const char* key, uint32_t value)
+{
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%s=%lu\r\n", key, (unsigned long)value);
+    UART_SendString(buffer);
+}
+
+/**
+  * @brief  Construction de la balise de réponse ("[OK]" ou "[OK#n]")
+  * @param  buffer: Buffer de sortie
+  * @param  size: Taille du buffer
+  * @param  tag: Nom de la balise (OK, ERR, END)
+  */
+static void Format_Reply_Tag(char* buffer, size_t size, const char* tag)
+{
+    if (currentSequence >= 0) {
+        snprintf(buffer, size, "[%s#%ld]", tag, (long)currentSequence);
+    } else {
+        snprintf(buffer, size, "[%s]", tag);
+    }
+}
+
+/**
+  * @brief  Envoi du marqueur de fin de réponse
+  */
+static void Send_Reply_End(void)
+{
+    char buffer[REPLY_TAG_SIZE];
+    Format_Reply_Tag(buffer, sizeof(buffer), "END");
+    UART_SendString(buffer);
+    UART_SendString("\r\n");
+    replySent = true;
+}
+
+/**
+  * @brief  Envoi d'un message de succès
+  */
+static void Send_Success_Message(const char* message)
+{
+    char tag[REPLY_TAG_SIZE];
+    char buffer[100];
+    if (timedCommand) {
+        replySent = true;
+        return;
+    }
+    Format_Reply_Tag(tag, sizeof(tag), "OK");
+    // Assurer que le message original finit par \r\n pour la clarté
+    size_t msgLen = strlen(message);
+    if (msgLen > 2 && message[msgLen-2] == '\r' && message[msgLen-1] == '\n') {
+        snprintf(buffer, sizeof(buffer), "%s %s", tag, message);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s %s\r\n", tag, message);
+    }
+    UART_SendString(buffer);
+    Send_Reply_End();
+}
+
+/**
+  * @brief  Envoi d'un message d'erreur
+  */
+static void Send_Error_Message(const char* message)
+{
+    char tag[REPLY_TAG_SIZE];
+    char buffer[100];
+    if (timedCommand) {
+        replySent = true;
+        return;
+    }
+    Format_Reply_Tag(tag, sizeof(tag), "ERR");
+    snprintf(buffer, sizeof(buffer), "%s %s\r\n", tag, message);
+    UART_SendString(buffer);
+    Send_Reply_End();
+}
@@ -0,0 +1,334 @@
+/**
+  ******************************************************************************
+  * @file           : command_timeline.c
+  * @brief          : Ligne de temps des commandes programmées (AT)
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente la ligne de temps de la commande AT : des
+  * commandes reçues à l'avance sont exécutées par la carte à leur échéance,
+  * sans la gigue de l'hôte (ordonnanceur, USB-CDC) ni le temps de transfert
+  * de la ligne.
+  *
+  * Les commandes armées sont rangées dans un tas binaire (min-heap) selon
+  * leur échéance : la prochaine est toujours à la racine, l'ajout et le
+  * retrait coûtent O(log n). Un seul timer logiciel est armé, sur
+  * l'échéance de la racine ; à son expiration (Timer_Process, boucle
+  * principale), toutes les commandes échues sont exécutées dans l'ordre de
+  * leur échéance, puis le timer est réarmé sur la suivante. Deux commandes
+  * de même échéance s'exécutent dans l'ordre où elles ont été reçues.
+  *
+  * Une commande "retenue" (spectacle préchargé) n'est pas dans le tas : son
+  * échéance est un décalage par rapport au déclenchement. Timeline_Go les
+  * arme toutes à la fois, relativement au même tick.
+  *
+  * Les échéances sont des ticks modulo 2^32 : elles sont comparées par leur
+  * différence signée, valable tant que les commandes sont à moins de 24
+  * jours les unes des autres.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Modules/command_timeline.h"
+#include "Modules/timer_handler.h"
+#include <string.h>
+
+/* Types privés --------------------------------------------------------------*/
+/* Commande programmée */
+typedef struct {
+  uint32_t due;               // Échéance (ticks), ou décalage si retenue
+  uint32_t order;             // Rang de réception (échéances égales)
+  bool used;                  // Case occupée
+  bool held;                  // Retenue jusqu'à Timeline_Go
+  char command[COMMAND_BUFFER_SIZE];
+} Timeline_Entry;
+
+/* Variables privées ---------------------------------------------------------*/
+static Timeline_Entry entries[TIMELINE_DEPTH];
+static uint8_t heap[TIMELINE_DEPTH];            // Indices dans entries, racine : prochaine échéance
+static uint8_t heapSize = 0;
+static uint8_t heldCount = 0;
+static uint32_t nextOrder = 0;
+static Soft_Timer timelineTimer;
+static Timeline_Handler timelineHandler = NULL;
+static Timeline_Stats timelineStats;
+
+/* Prototypes de fonctions privées -------------------------------------------*/
+static bool Timeline_Before(uint8_t a, uint8_t b);
+static void Timeline_Push(uint8_t entry);
+static uint8_t Timeline_Pop(void);
+static void Timeline_Arm(void);
+static void Timeline_Expired(Soft_Timer *timer, void *context);
+
+/**
+  * @brief  Initialisation de la ligne de temps (vide)
+  * @param  handler: Fonction d'exécution des commandes échues
+  * @retval None
+  */
+void Timeline_Init(Timeline_Handler handler)
+{
+  Timer_Cancel(&timelineTimer);
+  memset(entries, 0, sizeof(entries));
+  heapSize = 0;
+  heldCount = 0;
+  nextOrder = 0;
+  timelineHandler = handler;
+  memset(&timelineStats, 0, sizeof(timelineStats));
+}
+
+/**
+  * @brief  Programmation d'une commande
+  * @param  due: Échéance en ticks (Timer_GetTicks), ou décalage en ms après
+  *         Timeline_Go pour une commande retenue
+  * @param  held: true pour retenir la commande jusqu'à Timeline_Go
+  * @param  command: Commande à exécuter (tronquée à COMMAND_BUFFER_SIZE - 1)
+  * @retval true si la commande est programmée, false si la ligne est pleine
+  */
+bool Timeline_Add(uint32_t due, bool held, const char *command)
+{
+  uint8_t i;
+
+  for (i = 0; i < TIMELINE_DEPTH && entries[i].used; i++)
+  {
+  }
+  if (i == TIMELINE_DEPTH)
+  {
+    return false;
+  }
+
+  entries[i].due = due;
+  entries[i].order = nextOrder++;
+  entries[i].used = true;
+  entries[i].held = held;
+  strncpy(entries[i].command, command, sizeof(entries[i].command) - 1);
+  entries[i].command[sizeof(entries[i].command) - 1] = '\0';
+
+  if (held)
+  {
+    heldCount++;
+  }
+  else
+  {
+    Timeline_Push(i);
+    Timeline_Arm();
+  }
+  return true;
+}
+
+/**
+  * @brief  Déclenchement des commandes retenues
+  * @note   Chaque commande retenue est armée au tick courant plus son
+  *         décalage ; un décalage nul l'exécute au tick suivant.
+  * @param  None
+  * @retval Nombre de commandes armées
+  */
+uint8_t Timeline_Go(void)
+{
+  uint32_t now = Timer_GetTicks();
+  uint8_t armed = 0;
+
+  for (uint8_t i = 0; i < TIMELINE_DEPTH; i++)
+  {
+    if (entries[i].used && entries[i].held)
+    {
+      entries[i].held = false;
+      entries[i].due += now;
+      Timeline_Push(i);
+      armed++;
+    }
+  }
+  heldCount = 0;
+  Timeline_Arm();
+  return armed;
+}
+
+/**
+  * @brief  Abandon de toutes les commandes, armées ou retenues
+  * @param  None
+  * @retval None
+  */
+void Timeline_Clear(void)
+{
+  Timer_Cancel(&timelineTimer);
+  for (uint8_t i = 0; i < TIMELINE_DEPTH; i++)
+  {
+    entries[i].used = false;
+  }
+  heapSize = 0;
+  heldCount = 0;
+}
+
+/**
+  * @brief  Nombre de commandes armées
+  * @param  None
+  * @retval Commandes en attente de leur échéance
+  */
+uint8_t Timeline_GetCount(void)
+{
+  return heapSize;
+}
+
+/**
+  * @brief  Nombre de commandes retenues
+  * @param  None
+  * @retval Commandes en attente de Timeline_Go
+  */
+uint8_t Timeline_GetHeldCount(void)
+{
+  return heldCount;
+}
+
+/**
+  * @brief  Prochaine échéance
+  * @param  due: Échéance de la racine du tas (ticks)
+  * @retval true si une commande est armée
+  */
+bool Timeline_GetNext(uint32_t *due)
+{
+  if (heapSize == 0)
+  {
+    return false;
+  }
+  *due = entries[heap[0]].due;
+  return true;
+}
+
+/**
+  * @brief  Lecture des compteurs
+  * @param  stats: Compteurs depuis l'initialisation
+  * @retval None
+  */
+void Timeline_GetStats(Timeline_Stats *stats)
+{
+  *stats = timelineStats;
+}
+
+/**
+  * @brief  Ordre de deux commandes : échéance, puis rang de réception
+  * @param  a: Indice dans entries
+  * @param  b: Indice dans entries
+  * @retval true si a passe avant b
+  */
+static bool Timeline_Before(uint8_t a, uint8_t b)
+{
+  int32_t delta = (int32_t)(entries[a].due - entries[b].due);
+
+  return (delta != 0) ? (delta < 0) : ((int32_t)(entries[a].order - entries[b].order) < 0);
+}
+
+/**
+  * @brief  Insertion dans le tas (remontée depuis la dernière feuille)
+  * @param  entry: Indice dans entries
+  * @retval None
+  */
+static void Timeline_Push(uint8_t entry)
+{
+  uint8_t child = heapSize++;
+
+  while (child > 0)
+  {
+    uint8_t parent = (child - 1) / 2;
+    if (!Timeline_Before(entry, heap[parent]))
+    {
+      break;
+    }
+    heap[child] = heap[parent];
+    child = parent;
+  }
+  heap[child] = entry;
+}
+
+/**
+  * @brief  Retrait de la racine (descente de la dernière feuille)
+  * @param  None
+  * @retval Indice dans entries de la prochaine échéance
+  */
+static uint8_t Timeline_Pop(void)
+{
+  uint8_t root = heap[0];
+  uint8_t last = heap[--heapSize];
+  uint8_t parent = 0;
+
+  for (;;)
+  {
+    uint8_t child = 2 * parent + 1;
+    if (child >= heapSize)
+    {
+      break;
+    }
+    if (child + 1 < heapSize && Timeline_Before(heap[child + 1], heap[child]))
+    {
+      child++;
+    }
+    if (!Timeline_Before(heap[child], last))
+    {
+      break;
+    }
+    heap[parent] = heap[child];
+    parent = child;
+  }
+  heap[parent] = last;
+  return root;
+}
+
+/**
+  * @brief  Armement du timer sur l'échéance de la racine
+  * @param  None
+  * @retval None
+  */
+static void Timeline_Arm(void)
+{
+  if (heapSize == 0)
+  {
+    Timer_Cancel(&timelineTimer);
+    return;
+  }
+
+  int32_t delay = (int32_t)(entries[heap[0]].due - Timer_GetTicks());
+  Timer_Arm(&timelineTimer, (delay > 0) ? (uint32_t)delay * TIMER_TICK_MS : 0, 0,
+            Timeline_Expired, NULL);
+}
+
+/**
+  * @brief  Expiration du timer : exécution des commandes échues
+  * @note   Appelée par Timer_Process (boucle principale). La case est
+  *         libérée avant l'exécution de sa commande.
+  * @param  timer: Timer de la ligne de temps
+  * @param  context: Inutilisé
+  * @retval None
+  */
+static void Timeline_Expired(Soft_Timer *timer, void *context)
+{
+  char command[COMMAND_BUFFER_SIZE];
+  (void)timer;
+  (void)context;
+
+  while (heapSize > 0)
+  {
+    uint32_t now = Timer_GetTicks();
+    int32_t late = (int32_t)(now - entries[heap[0]].due);
+    if (late < 0)
+    {
+      break;
+    }
+
+    uint8_t entry = Timeline_Pop();
+    memcpy(command, entries[entry].command, sizeof(command));
+    entries[entry].used = false;
+
+    if ((uint32_t)late > timelineStats.maxLateMs)
+    {
+      timelineStats.maxLateMs = (uint32_t)late;
+    }
+    if (timelineHandler != NULL && timelineHandler(command))
+    {
+      timelineStats.executed++;
+    }
+    else
+    {
+      timelineStats.failed++;
+    }
+  }
+  Timeline_Arm();
+}
@@ -0,0 +1,149 @@
+/**
+  ******************************************************************************
+  * @file           : dma_player.c
+  * @brief          : Lecture des chenillards par DMA
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente la lecture d'une table de mots BSRR par le
+  * matériel, sans interruption ni passage dans la boucle principale :
+  * - TIM8 compte à DMA_PLAYER_TICK_HZ, sa période (ARR) est celle d'une
+  *   étape (au plus DMA_PLAYER_MAX_PERIOD_MS) ;
+  * - chaque débordement de TIM8 émet une requête DMA (TIM8_UP) ;
+  * - DMA2 Stream1 (Channel 7) copie alors le mot suivant de la table dans
+  *   GPIOB->BSRR et repart au début de la table (mode circulaire).
+  * 
+  * Les fronts des LED sont donc cadencés par le timer, quelle que soit
+  * l'activité du processeur (émission UART bloquante comprise). DMA2 est
+  * nécessaire : seul son port périphérique atteint le bus AHB1 de GPIOB.
+  * 
+  * La table doit rester en place pendant toute la lecture : elle est lue
+  * par le DMA à chaque étape.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "tim.h"
+#include "Modules/dma_player.h"
+#include "Modules/clock_profile.h"
+#include "stm32f7xx_hal.h"
+#include <stddef.h>
+
+/* Variables privées ---------------------------------------------------------*/
+static bool playerRunning = false;      // Lecture en cours
+
+/**
+  * @brief  Démarre la lecture circulaire d'une table de mots BSRR
+  * @note   La première étape est écrite immédiatement (événement de mise à
+  *         jour logiciel), les suivantes à chaque période. Une lecture en
+  *         cours est d'abord arrêtée.
+  * @param  words: Table des mots (reste lue par le DMA jusqu'à l'arrêt)
+  * @param  length: Nombre d'étapes (au moins 1)
+  * @param  target: Registre de destination (GPIOx->BSRR)
+  * @param  periodMs: Durée d'une étape en millisecondes
+  * @retval true si la lecture a démarré, false sinon
+  */
+bool DMA_Player_Start(const uint32_t *words, uint8_t length,
+                      volatile uint32_t *target, uint32_t periodMs)
+{
+  if (words == NULL || length == 0 || target == NULL ||
+      periodMs == 0 || periodMs > DMA_PLAYER_MAX_PERIOD_MS)
+  {
+    return false;
+  }
+
+  DMA_Player_Stop();
+
+  /* Compteur à DMA_PLAYER_TICK_HZ quelle que soit l'horloge de TIM8 */
+  __HAL_TIM_SET_PRESCALER(&htim8, Clock_GetTimerClock(htim8.Instance) / DMA_PLAYER_TICK_HZ - 1);
+  __HAL_TIM_SET_AUTORELOAD(&htim8, periodMs * DMA_PLAYER_TICKS_PER_MS - 1);
+  __HAL_TIM_SET_COUNTER(&htim8, 0);
+
+  if (HAL_DMA_Start(htim8.hdma[TIM_DMA_ID_UPDATE], (uint32_t)words,
+                    (uint32_t)target, length) != HAL_OK)
+  {
+    return false;
+  }
+  __HAL_TIM_ENABLE_DMA(&htim8, TIM_DMA_UPDATE);
+
+  /* Événement de mise à jour : charge le prédiviseur et joue l'étape 1 */
+  htim8.Instance->EGR = TIM_EGR_UG;
+  __HAL_TIM_ENABLE(&htim8);
+
+  playerRunning = true;
+  return true;
+}
+
+/**
+  * @brief  Arrête la lecture
+  * @note   Le port garde l'état de la dernière étape jouée.
+  * @param  None
+  * @retval None
+  */
+void DMA_Player_Stop(void)
+{
+  if (!playerRunning)
+  {
+    return;
+  }
+
+  __HAL_TIM_DISABLE(&htim8);
+  __HAL_TIM_DISABLE_DMA(&htim8, TIM_DMA_UPDATE);
+  HAL_DMA_Abort(htim8.hdma[TIM_DMA_ID_UPDATE]);
+  playerRunning = false;
+}
+
+/**
+  * @brief  Change la durée des étapes sans perdre la phase
+  * @note   Comme Timer_SetPeriod pour la lecture par le processeur : le
+  *         compteur est mis à l'échelle pour que l'étape en cours garde la
+  *         fraction déjà écoulée. ARR et CNT sont écrits dans l'ordre qui
+  *         garde toujours CNT sous ARR ; si le compteur a tout de même
+  *         dépassé la nouvelle limite, l'étape est jouée aussitôt.
+  * @param  periodMs: Nouvelle durée d'une étape en millisecondes
+  * @retval true si la période a été changée, false sinon
+  */
+bool DMA_Player_SetPeriod(uint32_t periodMs)
+{
+  if (!playerRunning || periodMs == 0 || periodMs > DMA_PLAYER_MAX_PERIOD_MS)
+  {
+    return false;
+  }
+
+  TIM_TypeDef *tim = htim8.Instance;
+  uint32_t period = periodMs * DMA_PLAYER_TICKS_PER_MS;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t oldPeriod = tim->ARR + 1;
+  uint32_t counter = (uint32_t)(((uint64_t)tim->CNT * period) / oldPeriod);
+  if (period >= oldPeriod)
+  {
+    tim->ARR = period - 1;
+    tim->CNT = counter;
+  }
+  else
+  {
+    tim->CNT = counter;
+    tim->ARR = period - 1;
+  }
+  if (tim->CNT > tim->ARR)
+  {
+    tim->EGR = TIM_EGR_UG;
+  }
+
+  __set_PRIMASK(primask);
+  return true;
+}
+
+/**
+  * @brief  Indique si une lecture est en cours
+  * @param  None
+  * @retval true si le DMA joue une table, false sinon
+  */
+bool DMA_Player_IsRunning(void)
+{
+  return playerRunning;
+}
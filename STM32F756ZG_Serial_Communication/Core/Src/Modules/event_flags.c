@@ -0,0 +1,201 @@
+/**
+  ******************************************************************************
+  * @file           : event_flags.c
+  * @brief          : Événements et sommeil de la boucle principale
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente l'attente de la boucle principale. Les
+  * interruptions publient des événements par un OU dans un mot de bits
+  * (Event_Post) ; Event_Wait endort le cœur en WFI jusqu'à ce qu'au moins
+  * un événement soit en attente, puis les retire tous d'un coup.
+  * 
+  * Le test du mot et l'entrée en WFI se font interruptions masquées
+  * (PRIMASK) : une interruption arrivée entre les deux réveille quand même
+  * le cœur (WFI sort sur toute interruption en attente), elle n'est servie
+  * qu'au démasquage. Aucun événement ne peut donc être perdu.
+  * 
+  * Le SysTick de la HAL est suspendu pendant le sommeil : il ne réveille
+  * plus le cœur à chaque milliseconde. HAL_GetTick ne compte alors que le
+  * temps éveillé, ce qui suffit aux délais d'attente active (émission UART
+  * bloquante, fonctions de la HAL) ; le temps réel est celui de TIM2.
+  * 
+  * Le compteur de cycles DWT mesure le temps total et le temps passé en
+  * WFI : le temps éveillé (boucle et interruptions) en est la différence.
+  * Il mesure aussi chaque passage de la boucle, du retour de Event_Wait à
+  * l'appel suivant ; le plus long est conservé en microsecondes, ce qui
+  * reste comparable d'un profil d'horloge à l'autre, et n'est pas remis à
+  * zéro par Event_ResetStats (qui n'écarte que le passage en cours).
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "Modules/event_flags.h"
+#include "Modules/memory_sections.h"
+#include "stm32f7xx_hal.h"
+
+/* Constantes privées --------------------------------------------------------*/
+#define EVENT_DWT_UNLOCK  0xC5ACCE55u   // Clé du registre LAR du DWT
+
+/* Variables privées ---------------------------------------------------------*/
+DTCM_DATA static volatile uint32_t pendingEvents = 0; // Événements en attente
+DTCM_DATA static volatile uint32_t postedCounts[EVENT_COUNT]; // Événements publiés
+static uint32_t wakeups = 0;                    // Sorties de WFI
+static uint32_t dispatches = 0;                 // Retours de Event_Wait
+static uint32_t lastStamp = 0;                  // Dernière lecture de CYCCNT
+static uint64_t totalCycles = 0;                // Cycles écoulés
+static uint64_t sleepCycles = 0;                // Cycles passés en WFI
+static uint32_t loopStamp = 0;                  // Retour précédent de Event_Wait
+static bool loopStarted = false;                // loopStamp valide
+static uint32_t maxLoopUs = 0;                  // Plus long passage de la boucle
+
+/* Prototypes des fonctions privées ------------------------------------------*/
+static uint32_t Event_Elapsed(void);
+
+/**
+  * @brief  Initialisation des événements et du compteur de cycles
+  * @note   Les événements déjà publiés sont conservés.
+  * @param  None
+  * @retval None
+  */
+void Event_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = EVENT_DWT_UNLOCK;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  maxLoopUs = 0;
+  Event_ResetStats();
+}
+
+/**
+  * @brief  Publication d'événements
+  * @note   Utilisable depuis une interruption ou depuis la boucle.
+  * @param  events: Bits EVENT_xxx à publier
+  * @retval None
+  */
+ITCM_CODE void Event_Post(uint32_t events)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  pendingEvents |= events;
+  for (uint32_t i = 0; i < EVENT_COUNT; i++)
+  {
+    if (events & (1u << i))
+    {
+      postedCounts[i]++;
+    }
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Attente d'au moins un événement (boucle principale)
+  * @note   Le cœur dort en WFI tant que rien n'est en attente ; une
+  *         interruption qui ne publie rien (tick de TIM2 sans échéance, par
+  *         exemple) le rendort aussitôt.
+  * @param  None
+  * @retval Événements reçus (bits EVENT_xxx), retirés de l'attente
+  */
+uint32_t Event_Wait(void)
+{
+  uint32_t events;
+
+  /* Durée du passage de la boucle qui se termine */
+  if (loopStarted)
+  {
+    uint32_t loopUs = (DWT->CYCCNT - loopStamp) / (SystemCoreClock / 1000000u);
+    if (loopUs > maxLoopUs)
+    {
+      maxLoopUs = loopUs;
+    }
+  }
+
+  __disable_irq();
+  while (pendingEvents == 0)
+  {
+    Event_Elapsed();
+    HAL_SuspendTick();
+    __DSB();
+    __WFI();
+    HAL_ResumeTick();
+    sleepCycles += Event_Elapsed();
+    wakeups++;
+
+    /* L'interruption qui a réveillé le cœur est servie ici */
+    __enable_irq();
+    __disable_irq();
+  }
+  events = pendingEvents;
+  pendingEvents = 0;
+  __enable_irq();
+
+  dispatches++;
+  loopStamp = DWT->CYCCNT;
+  loopStarted = true;
+  return events;
+}
+
+/**
+  * @brief  Lecture des compteurs
+  * @param  stats: Structure à remplir
+  * @retval None
+  */
+void Event_GetStats(Event_Stats *stats)
+{
+  Event_Elapsed();
+
+  stats->wakeups = wakeups;
+  stats->dispatches = dispatches;
+  for (uint32_t i = 0; i < EVENT_COUNT; i++)
+  {
+    stats->posted[i] = postedCounts[i];
+  }
+  stats->totalCycles = totalCycles;
+  stats->awakeCycles = totalCycles - sleepCycles;
+  stats->cyclesPerMs = SystemCoreClock / 1000u;
+  stats->maxLoopUs = maxLoopUs;
+}
+
+/**
+  * @brief  Remise à zéro des compteurs (début d'une fenêtre de mesure)
+  * @param  None
+  * @retval None
+  */
+void Event_ResetStats(void)
+{
+  wakeups = 0;
+  dispatches = 0;
+  for (uint32_t i = 0; i < EVENT_COUNT; i++)
+  {
+    postedCounts[i] = 0;
+  }
+  lastStamp = DWT->CYCCNT;
+  totalCycles = 0;
+  sleepCycles = 0;
+  /* Le passage en cours n'est pas mesuré : il peut couvrir un changement
+   * d'horloge (Clock_SetProfile) */
+  loopStarted = false;
+}
+
+/**
+  * @brief  Cycles écoulés depuis la lecture précédente de CYCCNT
+  * @note   Ajoutés au temps total. Le tick de TIM2 réveille le cœur chaque
+  *         milliseconde : deux lectures sont toujours séparées de bien moins
+  *         de 2^32 cycles (20 s à 216 MHz), le compteur 32 bits peut boucler.
+  * @param  None
+  * @retval Cycles écoulés
+  */
+static uint32_t Event_Elapsed(void)
+{
+  uint32_t now = DWT->CYCCNT;
+  uint32_t elapsed = now - lastStamp;
+
+  lastStamp = now;
+  totalCycles += elapsed;
+  return elapsed;
+}
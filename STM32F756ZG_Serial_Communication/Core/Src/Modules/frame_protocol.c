@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : frame_protocol.c
+  * @brief          : Protocole de commandes binaire
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente le décodage et l'encodage des trames binaires
+  * utilisées par l'automatisation côté hôte (voir frame_protocol.h pour le
+  * format). Une commande LED tient en 7 octets et sa réponse en 6, contre
+  * une dizaine d'octets et une réponse texte de plus de 30 octets en mode
+  * ASCII.
+  * 
+  * Le décodeur est alimenté octet par octet depuis la boucle principale.
+  * Les octets reçus hors trame sont ignorés jusqu'au prochain SYNC ; une
+  * longueur annoncée trop grande fait reprendre la recherche du SYNC.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Modules/frame_protocol.h"
+#include "Modules/memory_sections.h"
+#include <string.h>
+
+/* Types privés --------------------------------------------------------------*/
+/* Position du décodeur dans la trame */
+typedef enum {
+  FRAME_WAIT_SYNC = 0,
+  FRAME_WAIT_OPCODE,
+  FRAME_WAIT_LENGTH,
+  FRAME_WAIT_PAYLOAD,
+  FRAME_WAIT_CRC_HIGH,
+  FRAME_WAIT_CRC_LOW
+} Frame_State;
+
+/* Définitions privées -------------------------------------------------------*/
+#define FRAME_CRC_INIT      0xFFFF
+#define FRAME_CRC_POLY      0x1021
+
+/**
+  * @brief  Ajout d'un octet au CRC-16/CCITT
+  * @param  crc: CRC courant (FRAME_CRC_INIT pour le premier octet)
+  * @param  byte: Octet à ajouter
+  * @retval Nouveau CRC
+  */
+ITCM_CODE uint16_t Frame_Crc16_Update(uint16_t crc, uint8_t byte)
+{
+  crc ^= (uint16_t)byte << 8;
+  for (uint8_t bit = 0; bit < 8; bit++)
+  {
+    crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ FRAME_CRC_POLY) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+/**
+  * @brief  Remise du décodeur en attente d'un SYNC
+  * @param  decoder: Décodeur à réinitialiser
+  * @retval None
+  */
+void Frame_Decoder_Reset(Frame_Decoder *decoder)
+{
+  decoder->state = FRAME_WAIT_SYNC;
+  decoder->opcode = 0;
+  decoder->length = 0;
+  decoder->received = 0;
+  decoder->crc = FRAME_CRC_INIT;
+  decoder->frameCrc = 0;
+}
+
+/**
+  * @brief  Décodage d'un octet reçu
+  * @note   Après FRAME_COMPLETE, opcode, length et payload restent valides
+  *         jusqu'au prochain appel.
+  * @param  decoder: Décodeur
+  * @param  byte: Octet reçu
+  * @retval FRAME_COMPLETE si une trame valide vient d'être reçue,
+  *         FRAME_BAD_CRC si son CRC est faux, FRAME_INCOMPLETE sinon
+  */
+ITCM_CODE Frame_Result Frame_Decoder_Feed(Frame_Decoder *decoder, uint8_t byte)
+{
+  switch (decoder->state)
+  {
+    case FRAME_WAIT_SYNC:
+      if (byte == FRAME_SYNC)
+      {
+        Frame_Decoder_Reset(decoder);
+        decoder->state = FRAME_WAIT_OPCODE;
+      }
+      break;
+
+    case FRAME_WAIT_OPCODE:
+      decoder->opcode = byte;
+      decoder->crc = Frame_Crc16_Update(decoder->crc, byte);
+      decoder->state = FRAME_WAIT_LENGTH;
+      break;
+
+    case FRAME_WAIT_LENGTH:
+      if (byte > FRAME_MAX_PAYLOAD)
+      {
+        // Longueur impossible : faux SYNC, reprise de la recherche
+        decoder->state = FRAME_WAIT_SYNC;
+        break;
+      }
+      decoder->length = byte;
+      decoder->received = 0;
+      decoder->crc = Frame_Crc16_Update(decoder->crc, byte);
+      decoder->state = (byte > 0) ? FRAME_WAIT_PAYLOAD : FRAME_WAIT_CRC_HIGH;
+      break;
+
+    case FRAME_WAIT_PAYLOAD:
+      decoder->payload[decoder->received++] = byte;
+      decoder->crc = Frame_Crc16_Update(decoder->crc, byte);
+      if (decoder->received == decoder->length)
+      {
+        decoder->state = FRAME_WAIT_CRC_HIGH;
+      }
+      break;
+
+    case FRAME_WAIT_CRC_HIGH:
+      decoder->frameCrc = (uint16_t)byte << 8;
+      decoder->state = FRAME_WAIT_CRC_LOW;
+      break;
+
+    case FRAME_WAIT_CRC_LOW:
+      decoder->frameCrc |= byte;
+      decoder->state = FRAME_WAIT_SYNC;
+      return (decoder->frameCrc == decoder->crc) ? FRAME_COMPLETE : FRAME_BAD_CRC;
+
+    default:
+      decoder->state = FRAME_WAIT_SYNC;
+      break;
+  }
+
+  return FRAME_INCOMPLETE;
+}
+
+/**
+  * @brief  Construction d'une trame
+  * @param  opcode: Code d'opération
+  * @param  payload: Données (NULL si length vaut 0)
+  * @param  length: Nombre d'octets de données (FRAME_MAX_PAYLOAD au plus)
+  * @param  frame: Buffer de sortie d'au moins FRAME_MAX_SIZE octets
+  * @retval Taille de la trame, 0 si les données sont trop longues
+  */
+size_t Frame_Encode(uint8_t opcode, const uint8_t *payload, uint8_t length, uint8_t *frame)
+{
+  if (length > FRAME_MAX_PAYLOAD)
+  {
+    return 0;
+  }
+
+  uint16_t crc = FRAME_CRC_INIT;
+  frame[0] = FRAME_SYNC;
+  frame[1] = opcode;
+  frame[2] = length;
+  crc = Frame_Crc16_Update(crc, opcode);
+  crc = Frame_Crc16_Update(crc, length);
+  for (uint8_t i = 0; i < length; i++)
+  {
+    frame[3 + i] = payload[i];
+    crc = Frame_Crc16_Update(crc, payload[i]);
+  }
+  frame[3 + length] = (uint8_t)(crc >> 8);
+  frame[4 + length] = (uint8_t)(crc & 0xFF);
+  return (size_t)length + FRAME_OVERHEAD;
+}
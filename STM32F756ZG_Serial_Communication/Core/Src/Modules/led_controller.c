@@ -20,14 +20,35 @@
   * 
   * Le module vérifie également qu'aucun chenillard n'est actif avant
   * de permettre le contrôle individuel des LED.
+  * 
+  * Toutes les LED étant sur le port GPIOB, un état complet (masque, bit 0
+  * pour LED1) s'applique en une seule écriture du registre BSRR : les bits
+  * de mise à 1 et de mise à 0 de chaque masque sont précalculés dans une
+  * table, si bien qu'aucune LED ne change d'état avant les autres.
+  * 
+  * Chaque LED peut aussi être réglée à un niveau de luminosité de 0 à
+  * LED_LEVEL_MAX. Un niveau intermédiaire bascule la broche sur le canal PWM
+  * de son timer (TIM3_CH3, TIM4_CH2, TIM12_CH1, fonction alternative) dont
+  * le rapport cyclique sur LED_PWM_BITS bits est lu dans une table de
+  * correction gamma calculée à la compilation. Les niveaux 0 et
+  * LED_LEVEL_MAX ramènent la broche en sortie GPIO : le tout-ou-rien et les
+  * écritures BSRR (chenillards, DMA) restent inchangés.
+  * 
+  * Un fondu (LED_Fade) fait varier le niveau d'une LED jusqu'à une cible
+  * en une durée donnée : un timer logiciel (roue de timer_handler) met à
+  * jour les rapports cycliques toutes les LED_FADE_STEP_MS, le préchargement
+  * des registres CCR évitant toute période PWM incomplète.
   ******************************************************************************
   */
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "gpio.h"
+#include "tim.h"
 #include "Modules/led_controller.h"
+#include "Modules/memory_sections.h"
 #include "Modules/pattern_controller.h"
+#include "Modules/timer_handler.h"
 #include "stm32f7xx_hal.h"
 
 /* Définition des broches LED -------------------------------------------------*/
@@ -36,9 +57,88 @@
 #define LED3_PIN GPIO_PIN_14
 #define LED_PORT GPIOB
 
+/* Mode d'une broche dans le registre MODER */
+#define LED_MODER_OUTPUT  0x1u
+#define LED_MODER_AF      0x2u
+
+/* Bits BSRR : mise à 1 dans les 16 bits de poids faible, mise à 0 dans les
+ * 16 bits de poids fort */
+#define LED_BSRR_SET(pin)    ((uint32_t)(pin))
+#define LED_BSRR_RESET(pin)  ((uint32_t)(pin) << 16)
+#define LED_BSRR(mask, bit, pin) \
+  (((mask) & (bit)) ? LED_BSRR_SET(pin) : LED_BSRR_RESET(pin))
+#define LED_BSRR_WORD(mask) \
+  (LED_BSRR(mask, 0x1, LED1_PIN) | LED_BSRR(mask, 0x2, LED2_PIN) | LED_BSRR(mask, 0x4, LED3_PIN))
+
+/* Correction gamma : rapport cyclique de chaque niveau, calculé à la
+ * compilation. Avec x = niveau / LED_LEVEL_MAX, rapport = (x² + x³) / 2
+ * (gamma proche de 2,4) ; tout niveau non nul donne au moins 1. */
+#define LED_GAMMA_DIV  (2ull * LED_LEVEL_MAX * LED_LEVEL_MAX * LED_LEVEL_MAX)
+#define LED_GAMMA_RAW(l) \
+  (((uint64_t)(l) * (l) * ((l) + LED_LEVEL_MAX) * LED_PWM_MAX + LED_GAMMA_DIV / 2) / LED_GAMMA_DIV)
+#define LED_GAMMA(l) \
+  ((uint16_t)(((l) != 0 && LED_GAMMA_RAW(l) == 0) ? 1 : LED_GAMMA_RAW(l)))
+#define LED_GAMMA_4(l) \
+  LED_GAMMA(l), LED_GAMMA((l) + 1), LED_GAMMA((l) + 2), LED_GAMMA((l) + 3)
+#define LED_GAMMA_16(l) \
+  LED_GAMMA_4(l), LED_GAMMA_4((l) + 4), LED_GAMMA_4((l) + 8), LED_GAMMA_4((l) + 12)
+#define LED_GAMMA_64(l) \
+  LED_GAMMA_16(l), LED_GAMMA_16((l) + 16), LED_GAMMA_16((l) + 32), LED_GAMMA_16((l) + 48)
+
+/* Canal PWM d'une LED */
+typedef struct {
+  TIM_HandleTypeDef *timer;   // Timer (TIM3, TIM4, TIM12)
+  uint32_t channel;           // Canal du timer
+  uint8_t alternate;          // Fonction alternative de la broche
+  uint8_t position;           // Numéro de la broche sur le port
+} LED_PwmChannel;
+
+/* Fondu en cours d'une LED */
+typedef struct {
+  uint8_t from;               // Niveau de départ
+  uint8_t to;                 // Niveau visé
+  uint32_t start;             // Tick de départ
+  uint32_t duration;          // Durée (ms)
+} LED_FadeState;
+
 /* Variables privées ---------------------------------------------------------*/
 static GPIO_InitTypeDef GPIO_InitStruct;  // Structure de configuration GPIO
 
+/* Rapport cyclique (0 à LED_PWM_MAX) de chaque niveau */
+static const uint16_t ledGamma[LED_LEVEL_MAX + 1] = {
+  LED_GAMMA_64(0), LED_GAMMA_64(64), LED_GAMMA_64(128), LED_GAMMA_64(192)
+};
+
+/* Canal PWM de chaque LED (indice 0 inutilisé) */
+static const LED_PwmChannel ledPwm[LED_COUNT + 1] = {
+  { NULL, 0, 0, 0 },
+  { &htim3,  TIM_CHANNEL_3, GPIO_AF2_TIM3,  0 },    // LED1 : PB0
+  { &htim4,  TIM_CHANNEL_2, GPIO_AF2_TIM4,  7 },    // LED2 : PB7
+  { &htim12, TIM_CHANNEL_1, GPIO_AF9_TIM12, 14 },   // LED3 : PB14
+};
+
+static uint8_t ledLevels[LED_COUNT + 1];          // Niveau des LED en PWM
+static uint32_t pwmMask = 0;                      // LED dont la broche est sur le PWM
+static LED_FadeState ledFades[LED_COUNT + 1];     // Fondus en cours
+static uint32_t fadeMask = 0;                     // LED en cours de fondu
+static Soft_Timer fadeTimer;                      // Mise à jour des fondus
+
+/* Broche de chaque LED (indice 0 inutilisé) */
+static const uint16_t ledPins[LED_COUNT + 1] = { 0, LED1_PIN, LED2_PIN, LED3_PIN };
+
+/* Mot BSRR de chaque masque : un seul accès applique l'état des 3 LED */
+static const uint32_t ledBsrrTable[LED_MASK_ALL + 1] = {
+  LED_BSRR_WORD(0), LED_BSRR_WORD(1), LED_BSRR_WORD(2), LED_BSRR_WORD(3),
+  LED_BSRR_WORD(4), LED_BSRR_WORD(5), LED_BSRR_WORD(6), LED_BSRR_WORD(7)
+};
+
+/* Prototypes des fonctions privées ------------------------------------------*/
+static void LED_SetPinMode(uint8_t ledNumber, uint32_t mode);
+static void LED_ApplyLevel(uint8_t ledNumber, uint8_t level);
+static void LED_StartFade(uint8_t ledNumber, uint8_t level, uint32_t durationMs);
+static void LED_StopLevels(void);
+static void LED_FadeExpired(Soft_Timer *timer, void *context);
+
 /**
   * @brief  Initialise le contrôleur de LED
   * @param  Aucun
@@ -58,10 +158,21 @@ void LED_Controller_Init(void)
   /* Initialisation des broches */
   HAL_GPIO_Init(LED_PORT, &GPIO_InitStruct);
   
+  /* Fonction alternative PWM de chaque broche (prise en compte seulement
+   * quand la broche passe en mode alternatif) et démarrage des canaux */
+  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  {
+    uint32_t shift = (ledPwm[i].position & 0x7u) * 4u;
+    volatile uint32_t *afr = &LED_PORT->AFR[ledPwm[i].position >> 3];
+    *afr = (*afr & ~(0xFu << shift)) | ((uint32_t)ledPwm[i].alternate << shift);
+    HAL_TIM_PWM_Start(ledPwm[i].timer, ledPwm[i].channel);
+    ledLevels[i] = 0;
+  }
+  pwmMask = 0;
+  fadeMask = 0;
+  
   /* Extinction de toutes les LED */
-  LED_SetState(1, LED_OFF);
-  LED_SetState(2, LED_OFF);
-  LED_SetState(3, LED_OFF);
+  LED_ForceMask(0);
 }
 
 /**
@@ -85,17 +196,7 @@ bool LED_IsValidNumber(uint8_t ledNumber)
   */
 static uint16_t LED_NumberToPin(uint8_t ledNumber)
 {
-  switch (ledNumber)
-  {
-    case 1:
-      return LED1_PIN;
-    case 2:
-      return LED2_PIN;
-    case 3:
-      return LED3_PIN;
-    default:
-      return 0;
-  }
+  return LED_IsValidNumber(ledNumber) ? ledPins[ledNumber] : 0;
 }
 
 /**
@@ -119,8 +220,93 @@ void LED_ForceState(uint8_t ledNumber, LED_State state)
     return; // Ne rien faire si le pin est invalide
   }
 
-  /* Modification de l'état de la LED */
-  HAL_GPIO_WritePin(LED_PORT, pin, (state == LED_ON) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+  /* Fin d'un éventuel fondu, puis modification de l'état de la LED */
+  fadeMask &= ~LED_MASK(ledNumber);
+  LED_ApplyLevel(ledNumber, (state == LED_ON) ? LED_LEVEL_MAX : 0);
+}
+
+/**
+  * @brief  Application d'un état complet des LED (sans vérifier Pattern_IsActive)
+  * @note   Une seule écriture BSRR : les LED changent d'état simultanément.
+  *         Utilisée par les chenillards à chaque étape. Les fondus en cours
+  *         sont abandonnés et les broches en PWM reviennent en sortie GPIO.
+  * @param  mask: État des LED (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3)
+  * @retval None
+  */
+ITCM_CODE void LED_ForceMask(uint32_t mask)
+{
+  LED_PORT->BSRR = ledBsrrTable[mask & LED_MASK_ALL];
+  if ((pwmMask | fadeMask) != 0)
+  {
+    LED_StopLevels();
+  }
+}
+
+/**
+  * @brief  Mot BSRR d'un état complet des LED
+  * @note   Utilisé pour préparer les tables lues par DMA (chenillard joué
+  *         par le matériel, voir dma_player.c).
+  * @param  mask: État des LED (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3)
+  * @retval Mot à écrire dans le registre BSRR
+  */
+ITCM_CODE uint32_t LED_MaskToBsrr(uint32_t mask)
+{
+  return ledBsrrTable[mask & LED_MASK_ALL];
+}
+
+/**
+  * @brief  Adresse du registre BSRR du port des LED
+  * @param  None
+  * @retval Adresse de GPIOB->BSRR (destination des transferts DMA)
+  */
+volatile uint32_t* LED_GetBsrrAddress(void)
+{
+  return &LED_PORT->BSRR;
+}
+
+/**
+  * @brief  Modification simultanée de l'état de toutes les LED
+  * @note   Comme LED_SetState, refusée pendant un chenillard.
+  * @param  mask: État des LED (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3)
+  * @retval true si l'opération a réussi, false sinon
+  */
+bool LED_SetMask(uint32_t mask)
+{
+  /* Vérification du masque (aucun bit au-delà de LED_COUNT) */
+  if ((mask & ~(uint32_t)LED_MASK_ALL) != 0)
+  {
+    return false;
+  }
+
+  /* Vérification qu'aucun chenillard n'est actif */
+  if (Pattern_IsActive())
+  {
+    return false;
+  }
+
+  LED_ForceMask(mask);
+  return true;
+}
+
+/**
+  * @brief  Lecture de l'état de toutes les LED
+  * @note   Une seule lecture du registre ODR.
+  * @param  None
+  * @retval État des LED (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3)
+  */
+uint32_t LED_GetMask(void)
+{
+  uint32_t odr = LED_PORT->ODR;
+  uint32_t mask = pwmMask;    // Une LED en PWM est allumée
+
+  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  {
+    if (odr & ledPins[i])
+    {
+      mask |= LED_MASK(i);
+    }
+  }
+  return mask;
 }
 
 /**
@@ -148,15 +334,8 @@ bool LED_SetState(uint8_t ledNumber, LED_State state)
     return false;
   }
   
-  /* Conversion du numéro de LED en broche GPIO */
-  uint16_t pin = LED_NumberToPin(ledNumber);
-  if (pin == 0)
-  {
-    return false;
-  }
-  
   /* Modification de l'état de la LED */
-  HAL_GPIO_WritePin(LED_PORT, pin, (state == LED_ON) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+  LED_ForceState(ledNumber, state);
   
   return true;
 }
@@ -182,6 +361,12 @@ LED_State LED_GetState(uint8_t ledNumber)
     return LED_ERROR;
   }
   
+  /* Une LED en PWM a un niveau non nul */
+  if (pwmMask & LED_MASK(ledNumber))
+  {
+    return LED_ON;
+  }
+  
   /* Lecture de l'état de la LED */
   GPIO_PinState pinState = HAL_GPIO_ReadPin(LED_PORT, pin);
   return (pinState == GPIO_PIN_SET) ? LED_ON : LED_OFF;
@@ -200,9 +385,233 @@ bool LED_Toggle(uint8_t ledNumber)
     return false;
   }
   
-  /* Inversion de l'état de la LED */
-  HAL_GPIO_TogglePin(LED_PORT, LED_NumberToPin(ledNumber));
+  /* Inversion de l'état de la LED (une LED en PWM s'éteint) */
+  LED_ForceState(ledNumber, (LED_GetState(ledNumber) == LED_ON) ? LED_OFF : LED_ON);
   
   return true;
 }
 
+/**
+  * @brief  Réglage de la luminosité d'une LED
+  * @note   Comme LED_SetState, refusé pendant un chenillard. Un fondu en
+  *         cours sur cette LED est abandonné.
+  * @param  ledNumber: Numéro de la LED (1-3)
+  * @param  level: Niveau (0 : éteinte, LED_LEVEL_MAX : allumée)
+  * @retval true si l'opération a réussi, false sinon
+  */
+bool LED_SetLevel(uint8_t ledNumber, uint8_t level)
+{
+  if (!LED_IsValidNumber(ledNumber) || Pattern_IsActive())
+  {
+    return false;
+  }
+
+  fadeMask &= ~LED_MASK(ledNumber);
+  LED_ApplyLevel(ledNumber, level);
+  return true;
+}
+
+/**
+  * @brief  Récupération de la luminosité d'une LED
+  * @param  ledNumber: Numéro de la LED (1-3)
+  * @retval Niveau actuel (0 à LED_LEVEL_MAX), 0 si le numéro est invalide
+  */
+uint8_t LED_GetLevel(uint8_t ledNumber)
+{
+  if (!LED_IsValidNumber(ledNumber))
+  {
+    return 0;
+  }
+  if (pwmMask & LED_MASK(ledNumber))
+  {
+    return ledLevels[ledNumber];
+  }
+  return (LED_PORT->ODR & ledPins[ledNumber]) ? LED_LEVEL_MAX : 0;
+}
+
+/**
+  * @brief  Fondu d'une LED vers un niveau
+  * @note   Le niveau varie linéairement depuis le niveau actuel (la
+  *         correction gamma rend la variation perçue régulière). Refusé
+  *         pendant un chenillard. Une durée nulle applique le niveau
+  *         immédiatement.
+  * @param  ledNumber: Numéro de la LED (1-3)
+  * @param  level: Niveau visé (0 à LED_LEVEL_MAX)
+  * @param  durationMs: Durée du fondu (0 à LED_FADE_MAX_MS)
+  * @retval true si le fondu a été lancé, false sinon
+  */
+bool LED_Fade(uint8_t ledNumber, uint8_t level, uint32_t durationMs)
+{
+  if (!LED_IsValidNumber(ledNumber) || durationMs > LED_FADE_MAX_MS || Pattern_IsActive())
+  {
+    return false;
+  }
+
+  LED_StartFade(ledNumber, level, durationMs);
+  return true;
+}
+
+/**
+  * @brief  Fondu de toutes les LED vers un état complet (sans vérifier
+  *         Pattern_IsActive)
+  * @note   Utilisé par les chenillards en fondu : chaque LED va vers
+  *         LED_LEVEL_MAX ou 0 selon son bit.
+  * @param  mask: État visé (bit 0 : LED1, bit 1 : LED2, bit 2 : LED3)
+  * @param  durationMs: Durée du fondu (0 à LED_FADE_MAX_MS)
+  * @retval None
+  */
+void LED_FadeMask(uint32_t mask, uint32_t durationMs)
+{
+  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  {
+    LED_StartFade(i, (mask & LED_MASK(i)) ? LED_LEVEL_MAX : 0, durationMs);
+  }
+}
+
+/**
+  * @brief  Mode d'une broche de LED (sortie GPIO ou fonction alternative)
+  * @param  ledNumber: Numéro de la LED
+  * @param  mode: LED_MODER_OUTPUT ou LED_MODER_AF
+  * @retval None
+  */
+static void LED_SetPinMode(uint8_t ledNumber, uint32_t mode)
+{
+  uint32_t shift = 2u * ledPwm[ledNumber].position;
+  LED_PORT->MODER = (LED_PORT->MODER & ~(0x3u << shift)) | (mode << shift);
+}
+
+/**
+  * @brief  Application d'un niveau à une LED
+  * @note   Les niveaux extrêmes passent par BSRR puis remettent la broche
+  *         en sortie GPIO ; un niveau intermédiaire règle le rapport
+  *         cyclique (préchargé, pris en compte à la fin de la période PWM)
+  *         et passe la broche sur le canal PWM. À l'entrée en PWM, une mise
+  *         à jour du timer charge aussitôt le nouveau rapport.
+  * @param  ledNumber: Numéro de la LED (valide)
+  * @param  level: Niveau (0 à LED_LEVEL_MAX)
+  * @retval None
+  */
+static void LED_ApplyLevel(uint8_t ledNumber, uint8_t level)
+{
+  uint32_t bit = LED_MASK(ledNumber);
+  const LED_PwmChannel *pwm = &ledPwm[ledNumber];
+
+  if (level == 0 || level == LED_LEVEL_MAX)
+  {
+    uint16_t pin = ledPins[ledNumber];
+    LED_PORT->BSRR = level ? LED_BSRR_SET(pin) : LED_BSRR_RESET(pin);
+    if (pwmMask & bit)
+    {
+      LED_SetPinMode(ledNumber, LED_MODER_OUTPUT);
+      pwmMask &= ~bit;
+    }
+  }
+  else
+  {
+    __HAL_TIM_SET_COMPARE(pwm->timer, pwm->channel, ledGamma[level]);
+    if (!(pwmMask & bit))
+    {
+      pwm->timer->Instance->EGR = TIM_EGR_UG;
+      LED_SetPinMode(ledNumber, LED_MODER_AF);
+      pwmMask |= bit;
+    }
+  }
+  ledLevels[ledNumber] = level;
+}
+
+/**
+  * @brief  Lancement du fondu d'une LED (sans vérification)
+  * @param  ledNumber: Numéro de la LED (valide)
+  * @param  level: Niveau visé
+  * @param  durationMs: Durée du fondu (0 : immédiat)
+  * @retval None
+  */
+static void LED_StartFade(uint8_t ledNumber, uint8_t level, uint32_t durationMs)
+{
+  uint32_t bit = LED_MASK(ledNumber);
+
+  if (durationMs == 0)
+  {
+    fadeMask &= ~bit;
+    LED_ApplyLevel(ledNumber, level);
+    return;
+  }
+
+  ledFades[ledNumber].from = LED_GetLevel(ledNumber);
+  ledFades[ledNumber].to = level;
+  ledFades[ledNumber].start = Timer_GetTicks();
+  ledFades[ledNumber].duration = durationMs;
+  fadeMask |= bit;
+
+  if (!Timer_IsArmed(&fadeTimer))
+  {
+    Timer_Arm(&fadeTimer, LED_FADE_STEP_MS, LED_FADE_STEP_MS, LED_FadeExpired, NULL);
+  }
+}
+
+/**
+  * @brief  Abandon des fondus et retour des broches PWM en sortie GPIO
+  * @note   L'état des sorties (ODR) a déjà été écrit par l'appelant.
+  * @param  None
+  * @retval None
+  */
+static void LED_StopLevels(void)
+{
+  fadeMask = 0;
+  Timer_Cancel(&fadeTimer);
+
+  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  {
+    if (pwmMask & LED_MASK(i))
+    {
+      LED_SetPinMode(i, LED_MODER_OUTPUT);
+    }
+  }
+  pwmMask = 0;
+}
+
+/**
+  * @brief  Échéance du timer des fondus
+  * @note   Appelée par Timer_Process toutes les LED_FADE_STEP_MS : calcule
+  *         le niveau de chaque LED en fondu d'après le temps écoulé. Le
+  *         timer s'arrête quand tous les fondus sont terminés.
+  * @param  timer: Timer échu (fadeTimer)
+  * @param  context: Inutilisé
+  * @retval None
+  */
+static void LED_FadeExpired(Soft_Timer *timer, void *context)
+{
+  uint32_t now = Timer_GetTicks();
+  (void)context;
+
+  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  {
+    uint32_t bit = LED_MASK(i);
+    LED_FadeState *fade = &ledFades[i];
+    uint32_t elapsed = now - fade->start;
+    uint8_t level;
+
+    if (!(fadeMask & bit))
+    {
+      continue;
+    }
+
+    if (elapsed >= fade->duration)
+    {
+      level = fade->to;
+      fadeMask &= ~bit;
+    }
+    else
+    {
+      int32_t delta = (int32_t)fade->to - (int32_t)fade->from;
+      level = (uint8_t)((int32_t)fade->from + delta * (int32_t)elapsed / (int32_t)fade->duration);
+    }
+    LED_ApplyLevel(i, level);
+  }
+
+  if (fadeMask == 0)
+  {
+    Timer_Cancel(timer);
+  }
+}
+
@@ -12,6 +12,9 @@
 #include "Modules/timer_handler.h"
 #include "Modules/uart_handler.h"
 #include "Modules/command_parser.h"
+#include "Modules/event_flags.h"
+#include "Modules/clock_profile.h"
+#include "Modules/profiler.h"
 #include "usart.h"
 
 /* Fonctions d'adaptation (wrappers) -----------------------------------------*/
@@ -32,6 +35,39 @@ void PATTERN_Init(void)
     Pattern_Controller_Init();
 }
 
+/**
+  * @brief  Wrapper pour Clock_Init
+  */
+void CLOCK_Init(void)
+{
+    Clock_Init();
+}
+
+/**
+  * @brief  Wrapper pour Event_Init
+  */
+void EVENT_Init(void)
+{
+    Event_Init();
+}
+
+/**
+  * @brief  Wrapper pour Profile_Init
+  */
+void PROFILE_Init(void)
+{
+    Profile_Init();
+}
+
+/**
+  * @brief  Wrapper pour Event_Wait
+  * @retval Événements reçus (bits EVENT_xxx)
+  */
+uint32_t EVENT_Wait(void)
+{
+    return Event_Wait();
+}
+
 /**
   * @brief  Wrapper pour Timer_Init
   */
@@ -58,13 +94,22 @@ void COMMAND_Init(void)
 }
 
 /**
-  * @brief  Wrapper pour Command_Parser_ProcessCommands
+  * @brief  Wrapper pour UART_ProcessReceived et Command_Parser_ProcessCommands
   */
 void COMMAND_Process(void)
 {
+    UART_ProcessReceived();
     Command_Parser_ProcessCommands();
 }
 
+/**
+  * @brief  Wrapper pour Timer_Process
+  */
+void TIMER_Process(void)
+{
+    Timer_Process();
+}
+
 /**
   * @brief  Wrapper pour Pattern_Process
   */
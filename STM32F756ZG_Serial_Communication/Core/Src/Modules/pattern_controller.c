@@ -14,31 +14,124 @@
   * - Pattern 2 : Alternance des LED paires et impaires
   * - Pattern 3 : Allumage en chenille avec retour
   * 
-  * Fréquences disponibles :
+  * Un chenillard n'est qu'une table de masques d'état des LED (un par
+  * étape) : les chenillards prédéfinis sont des tables constantes en flash,
+  * et PATTERN_USER_SLOTS emplacements en RAM peuvent être chargés par l'UART
+  * (Pattern_Define). Chaque étape se réduit à une lecture indexée et une
+  * écriture du port (LED_ForceMask).
+  * 
+  * Les étapes sont cadencées par un timer logiciel (patternTimer) armé sur
+  * la roue du module timer_handler. Changer de période pendant un
+  * chenillard conserve la phase : l'étape en cours garde la fraction déjà
+  * écoulée (Timer_SetPeriod), le tempo change sans à-coup.
+  * 
+  * Fréquences prédéfinies (FREQ<n>) :
   * - 500ms : Changement rapide
   * - 1s    : Changement moyen
   * - 3s    : Changement lent
+  * 
+  * Toute période de PATTERN_PERIOD_MIN_MS à PATTERN_PERIOD_MAX_MS peut aussi
+  * être réglée (FREQ <ms>).
+  * 
+  * En lecture DMA (Pattern_SetPlayback), la table est convertie en mots BSRR
+  * et jouée par TIM8 et le DMA (dma_player.c) : les étapes ne dépendent plus
+  * de la boucle principale. Au-delà de DMA_PLAYER_MAX_PERIOD_MS par étape,
+  * la lecture repasse par le timer logiciel.
+  * 
+  * En fondu (Pattern_SetFade), chaque étape est atteinte par un fondu de
+  * toute la durée de l'étape (LED_FadeMask) au lieu d'un changement franc :
+  * un chenillard { 0x7, 0x0 } respire. Le fondu passe par le PWM des LED,
+  * la lecture est alors toujours faite par le timer logiciel.
+  * 
+  * Un emplacement chargé peut aussi recevoir un programme (Pattern_
+  * DefineProgram) : du bytecode exécuté par une petite machine virtuelle à
+  * registres, qui exprime boucles, aléas, tests sur l'état des LED et
+  * rampes de tempo (jeu d'instructions dans pattern_controller.h). À chaque
+  * étape, le programme s'exécute jusqu'à l'instruction qui fixe l'étape
+  * (SHOW, SHOWI, WAIT), dans la limite de PATTERN_VM_BUDGET instructions ;
+  * ses opérandes sont vérifiés au chargement et son état (registres,
+  * compteur ordinal) est statique. Un programme est toujours joué par le
+  * timer logiciel.
   ******************************************************************************
   */
 
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "Modules/pattern_controller.h"
+#include "Modules/memory_sections.h"
 #include "Modules/led_controller.h"
 #include "Modules/timer_handler.h"
+#include "Modules/dma_player.h"
 #include "Modules/uart_handler.h"
+#include "Modules/profiler.h"
 #include <stdio.h>
+#include <string.h>
+
+/* Chenillards prédéfinis (flash) -------------------------------------------*/
+/* Pattern 1 : LED1, LED2, LED3 l'une après l'autre */
+static const uint8_t pattern1Steps[] = { 0x1, 0x2, 0x4 };
+/* Pattern 2 : LED impaires puis LED paires */
+static const uint8_t pattern2Steps[] = { 0x5, 0x2 };
+/* Pattern 3 : remplissage puis vidage de gauche à droite */
+static const uint8_t pattern3Steps[] = { 0x1, 0x3, 0x7, 0x6, 0x4, 0x0 };
+
+static const Pattern_Definition builtinPatterns[PATTERN_BUILTIN_COUNT] = {
+  { "SEQUENTIEL", pattern1Steps, sizeof(pattern1Steps), NULL, 0 },
+  { "ALTERNE",    pattern2Steps, sizeof(pattern2Steps), NULL, 0 },
+  { "CHENILLE",   pattern3Steps, sizeof(pattern3Steps), NULL, 0 },
+};
+
+/* Chenillard chargé par l'UART (RAM) : table d'étapes ou programme */
+typedef struct {
+  uint8_t steps[PATTERN_MAX_STEPS];   // Masques des étapes
+  uint8_t length;                     // Nombre d'étapes (0 : vide ou programme)
+  uint8_t code[PATTERN_PROGRAM_SIZE]; // Bytecode
+  uint8_t codeLength;                 // Octets de bytecode (0 : table d'étapes)
+} Pattern_Slot;
+
+/* État de la machine virtuelle du programme actif */
+typedef struct {
+  uint16_t regs[PATTERN_VM_REGISTERS]; // Registres r0 à r7
+  uint8_t pc;                         // Prochaine instruction
+  uint16_t wait;                      // Étapes restantes d'un WAIT
+  uint32_t random;                    // État du générateur xorshift (RAND)
+} Pattern_Vm;
+
+/* Période des étapes pour chaque fréquence prédéfinie (ms) */
+static const uint32_t patternPeriodsMs[PATTERN_FREQ_CUSTOM] = {
+  500,    // PATTERN_FREQ_500MS
+  1000,   // PATTERN_FREQ_1S
+  3000,   // PATTERN_FREQ_3S
+};
 
 /* Variables privées ---------------------------------------------------------*/
 static Pattern_Type activePattern = PATTERN_NONE;    // Pattern actuellement actif
-static Pattern_Frequency currentFrequency = PATTERN_FREQ_1S;  // Fréquence actuelle
-static uint8_t patternStep = 0;                      // Étape actuelle du pattern
-static bool patternNeedsUpdate = false;              // Flag de mise à jour
+static uint32_t stepPeriodMs = 1000;                 // Période des étapes (ms)
+DTCM_DATA static uint8_t patternStep = 0;            // Étape actuelle du pattern
+DTCM_DATA static bool patternNeedsUpdate = false;    // Flag de mise à jour
+DTCM_DATA static const uint8_t *activeSteps = NULL;  // Table du pattern actif
+DTCM_DATA static uint8_t activeLength = 0;           // Nombre d'étapes du pattern actif
+static Pattern_Slot userPatterns[PATTERN_USER_SLOTS]; // Emplacements chargés
+static Soft_Timer patternTimer;                      // Cadence des étapes
+static Pattern_Playback playback = PATTERN_PLAYBACK_CPU; // Lecture demandée
+DMA_BUFFER static uint32_t bsrrSteps[PATTERN_MAX_STEPS]; // Étapes lues par le DMA
+static bool fadeSteps = false;                       // Étapes en fondu
+static uint32_t missedSteps = 0;                     // Échéances perdues (étape précédente non appliquée)
+DTCM_DATA static const uint8_t *activeCode = NULL;   // Bytecode du programme actif (NULL : table)
+DTCM_DATA static uint8_t activeCodeLength = 0;       // Octets de bytecode du programme actif
+DTCM_DATA static Pattern_Vm vm;                      // Machine virtuelle du programme actif
+static uint32_t programFaults = 0;                   // Programmes arrêtés (budget épuisé, période invalide)
 
-/* Prototypes de fonctions privées -------------------------------------------*/
-static void Pattern1_Update(void);  // Mise à jour du pattern 1
-static void Pattern2_Update(void);  // Mise à jour du pattern 2
-static void Pattern3_Update(void);  // Mise à jour du pattern 3
+/* Prototypes des fonctions privées ------------------------------------------*/
+static void Pattern_TimerExpired(Soft_Timer *timer, void *context);
+static bool Pattern_UseDma(void);
+static void Pattern_StartPlayback(void);
+static void Pattern_StopPlayback(void);
+static void Pattern_ShowMask(uint8_t mask);
+static void Pattern_RunProgram(void);
+static void Pattern_ProgramFault(void);
+static uint16_t Pattern_Random(uint16_t bound);
+static bool Pattern_VerifyProgram(const uint8_t *code, uint8_t length);
 
 /**
   * @brief  Initialisation du module de gestion des chenillards
@@ -53,9 +146,17 @@ static void Pattern3_Update(void);  // Mise à jour du pattern 3
 void Pattern_Controller_Init(void)
 {
   activePattern = PATTERN_NONE;
-  currentFrequency = PATTERN_FREQ_1S;
+  stepPeriodMs = patternPeriodsMs[PATTERN_FREQ_1S];
   patternStep = 0;
   patternNeedsUpdate = false;
+  activeSteps = NULL;
+  activeLength = 0;
+  Pattern_StopPlayback();
+  for (uint8_t i = 0; i < PATTERN_USER_SLOTS; i++)
+  {
+    userPatterns[i].length = 0;
+    userPatterns[i].codeLength = 0;
+  }
 }
 
 /**
@@ -64,15 +165,19 @@ void Pattern_Controller_Init(void)
   *         - Vérifie la validité du pattern demandé
   *         - Arrête le pattern actif si nécessaire
   *         - Configure le nouveau pattern
-  *         - Démarre le timer correspondant à la fréquence actuelle
-  *         - Force une mise à jour immédiate pour voir l'effet
-  * @param  pattern: Type de chenillard à démarrer (PATTERN_1, PATTERN_2, PATTERN_3)
-  * @retval true si l'opération a réussi, false sinon
+  *         - Lance la lecture des étapes (timer logiciel ou DMA), la
+  *           première étape étant appliquée immédiatement
+  * @param  pattern: Numéro du chenillard dans le catalogue (1 à Pattern_GetCount())
+  * @retval true si l'opération a réussi, false sinon (numéro invalide ou
+  *         emplacement vide)
   */
 bool Pattern_Start(Pattern_Type pattern)
 {
+  Pattern_Definition definition;
+
   /* Vérification de la validité du type de chenillard */
-  if (pattern <= PATTERN_NONE || pattern > PATTERN_COUNT)
+  if (!Pattern_GetDefinition((uint8_t)pattern, &definition) ||
+      (definition.length == 0 && definition.code == NULL))
   {
     return false;
   }
@@ -85,13 +190,14 @@ bool Pattern_Start(Pattern_Type pattern)
   
   /* Activation du chenillard demandé */
   activePattern = pattern;
+  activeSteps = definition.steps;
+  activeLength = definition.length;
+  activeCode = definition.code;
+  activeCodeLength = definition.codeLength;
   patternStep = 0;
   
-  /* Démarrage du timer correspondant à la fréquence actuelle */
-  Timer_Start(currentFrequency);
-  
-  /* Mise à jour immédiate pour voir un effet */
-  patternNeedsUpdate = true;
+  /* Lecture des étapes à la période actuelle */
+  Pattern_StartPlayback();
   
   return true;
 }
@@ -99,7 +205,7 @@ bool Pattern_Start(Pattern_Type pattern)
 /**
   * @brief  Arrêt du chenillard actif
   * @note   Cette fonction :
-  *         - Arrête le timer actif
+  *         - Arrête la lecture des étapes (timer logiciel ou DMA)
   *         - Désactive le pattern
   *         - Éteint toutes les LED
   * @param  None
@@ -113,30 +219,21 @@ bool Pattern_Stop(void)
     return false;
   }
   
-  /* Arrêt du timer */
-  Timer_Stop(currentFrequency);
+  /* Arrêt de la lecture des étapes */
+  Pattern_StopPlayback();
   
   /* Désactivation du chenillard */
   activePattern = PATTERN_NONE;
   
   /* Extinction de toutes les LED */
-  for (uint8_t i = 1; i <= LED_COUNT; i++)
-  {
-    LED_ForceState(i, LED_OFF);
-  }
+  LED_ForceMask(0);
   
   return true;
 }
 
 /**
   * @brief  Changement de la fréquence du chenillard
-  * @note   Cette fonction :
-  *         - Vérifie la validité de la nouvelle fréquence
-  *         - Si un chenillard est actif :
-  *           * Arrête l'ancien timer
-  *           * Change la fréquence
-  *           * Démarre le nouveau timer
-  *         - Sinon, met juste à jour la fréquence pour utilisation future
+  * @note   Raccourci de Pattern_SetPeriod pour les périodes prédéfinies.
   * @param  freq: Nouvelle fréquence (PATTERN_FREQ_500MS, PATTERN_FREQ_1S, PATTERN_FREQ_3S)
   * @retval true si l'opération a réussi, false sinon
   */
@@ -148,27 +245,63 @@ bool Pattern_SetFrequency(Pattern_Frequency freq)
     return false;
   }
   
-  /* Si un chenillard est actif, on doit changer le timer */
-  if (activePattern != PATTERN_NONE)
+  return Pattern_SetPeriod(patternPeriodsMs[freq]);
+}
+
+/**
+  * @brief  Changement de la période des étapes du chenillard
+  * @note   Cette fonction :
+  *         - Vérifie que la période est dans les limites
+  *         - Si un chenillard est actif, change la période de son timer
+  *           (logiciel ou TIM8) en gardant la fraction écoulée de l'étape en
+  *           cours ; si la nouvelle période impose l'autre lecture, le
+  *           chenillard reprend à sa première étape
+  *         - Sinon, met juste à jour la période pour utilisation future
+  * @param  periodMs: Période en millisecondes (PATTERN_PERIOD_MIN_MS à
+  *         PATTERN_PERIOD_MAX_MS)
+  * @retval true si l'opération a réussi, false sinon
+  */
+bool Pattern_SetPeriod(uint32_t periodMs)
+{
+  if (periodMs < PATTERN_PERIOD_MIN_MS || periodMs > PATTERN_PERIOD_MAX_MS)
   {
-    /* Arrêt du timer actuel */
-    Timer_Stop(currentFrequency);
-    
-    /* Mise à jour de la fréquence */
-    currentFrequency = freq;
-    
-    /* Démarrage du nouveau timer */
-    Timer_Start(currentFrequency);
+    return false;
   }
-  else
+  
+  stepPeriodMs = periodMs;
+  
+  /* Chenillard actif : nouvelle période sans perte de phase */
+  if (activePattern != PATTERN_NONE)
   {
-    /* Mise à jour de la fréquence pour utilisation future */
-    currentFrequency = freq;
+    if (DMA_Player_IsRunning() && Pattern_UseDma())
+    {
+      DMA_Player_SetPeriod(stepPeriodMs);
+    }
+    else if (!DMA_Player_IsRunning() && !Pattern_UseDma())
+    {
+      Timer_SetPeriod(&patternTimer, stepPeriodMs);
+    }
+    else
+    {
+      Pattern_StopPlayback();
+      patternStep = 0;
+      Pattern_StartPlayback();
+    }
   }
   
   return true;
 }
 
+/**
+  * @brief  Récupération de la période des étapes
+  * @param  None
+  * @retval Période actuelle en millisecondes
+  */
+uint32_t Pattern_GetPeriod(void)
+{
+  return stepPeriodMs;
+}
+
 /**
   * @brief  Récupération du chenillard actif
   * @note   Retourne le type de chenillard actuellement actif
@@ -182,13 +315,22 @@ Pattern_Type Pattern_GetActive(void)
 
 /**
   * @brief  Récupération de la fréquence actuelle
-  * @note   Retourne la fréquence actuellement configurée
+  * @note   Retourne la fréquence prédéfinie correspondant à la période
+  *         actuelle, PATTERN_FREQ_CUSTOM si la période a été réglée
+  *         librement (voir Pattern_GetPeriod)
   * @param  None
   * @retval Fréquence actuelle
   */
 Pattern_Frequency Pattern_GetFrequency(void)
 {
-  return currentFrequency;
+  for (uint8_t i = 0; i < PATTERN_FREQ_CUSTOM; i++)
+  {
+    if (patternPeriodsMs[i] == stepPeriodMs)
+    {
+      return (Pattern_Frequency)i;
+    }
+  }
+  return PATTERN_FREQ_CUSTOM;
 }
 
 /**
@@ -208,165 +350,532 @@ bool Pattern_IsActive(void)
   * @note   Cette fonction est appelée périodiquement pour mettre à jour
   *         l'état des LED selon le pattern actif. Elle :
   *         - Vérifie si une mise à jour est nécessaire
-  *         - Appelle la fonction de mise à jour appropriée
+  *         - Applique l'étape courante de la table du pattern
   *         - Réinitialise le flag de mise à jour
+  *         Seuls les passages qui appliquent une étape sont mesurés
+  *         (sonde PROFILE_PROBE_PATTERN_UPDATE).
   * @param  None
   * @retval None
   */
-void Pattern_Controller_Update(void)
+ITCM_CODE void Pattern_Controller_Update(void)
 {
   /* Vérification si une mise à jour est nécessaire */
   if (!patternNeedsUpdate || activePattern == PATTERN_NONE)
   {
     return;
   }
+  PROFILE_BEGIN(PROFILE_PROBE_PATTERN_UPDATE);
   
-  /* Mise à jour du chenillard en fonction du type */
-  switch (activePattern)
+  /* Une étape : lecture du masque et une seule écriture du port, ou
+   * fondu vers ce masque pendant toute l'étape ; un programme calcule
+   * lui-même son étape */
+  if (activeCode != NULL)
+  {
+    Pattern_RunProgram();
+  }
+  else
   {
-    case PATTERN_1:
-      Pattern1_Update();
-      break;
-    
-    case PATTERN_2:
-      Pattern2_Update();
-      break;
-    
-    case PATTERN_3:
-      Pattern3_Update();
-      break;
-    
-    default:
-      /* Ne devrait jamais arriver */
-      break;
+    Pattern_ShowMask(activeSteps[patternStep]);
+    if (++patternStep >= activeLength)
+    {
+      patternStep = 0;
+    }
   }
   
   /* Réinitialisation du flag de mise à jour */
   patternNeedsUpdate = false;
+  PROFILE_END(PROFILE_PROBE_PATTERN_UPDATE);
+}
+
+/**
+  * @brief  Nombre d'entrées du catalogue de chenillards
+  * @note   Chenillards prédéfinis puis emplacements chargés (vides ou non) :
+  *         les numéros valides vont de 1 à cette valeur.
+  * @param  None
+  * @retval Nombre d'entrées
+  */
+uint8_t Pattern_GetCount(void)
+{
+  return PATTERN_BUILTIN_COUNT + PATTERN_USER_SLOTS;
 }
 
 /**
-  * @brief  Callback appelé par le timer
-  * @note   Cette fonction est appelée par le module de gestion des timers
-  *         lorsqu'un timer expire. Elle :
-  *         - Vérifie que le timer correspond à la fréquence actuelle
-  *         - Active le flag de mise à jour si nécessaire
-  * @param  timerType: Type de timer qui a expiré
+  * @brief  Description d'une entrée du catalogue
+  * @param  pattern: Numéro du chenillard (1 à Pattern_GetCount())
+  * @param  definition: Description à remplir (length à 0 pour un
+  *         emplacement vide)
+  * @retval true si le numéro existe, false sinon
+  */
+bool Pattern_GetDefinition(uint8_t pattern, Pattern_Definition *definition)
+{
+  if (pattern == PATTERN_NONE || pattern > Pattern_GetCount())
+  {
+    return false;
+  }
+
+  if (pattern <= PATTERN_BUILTIN_COUNT)
+  {
+    *definition = builtinPatterns[pattern - 1];
+  }
+  else
+  {
+    Pattern_Slot *slot = &userPatterns[pattern - PATTERN_BUILTIN_COUNT - 1];
+    definition->name = (slot->codeLength != 0) ? "PROGRAMME" : "CHARGE";
+    definition->steps = slot->steps;
+    definition->length = slot->length;
+    definition->code = (slot->codeLength != 0) ? slot->code : NULL;
+    definition->codeLength = slot->codeLength;
+  }
+  return true;
+}
+
+/**
+  * @brief  Chargement d'un chenillard dans un emplacement RAM
+  * @note   Si l'emplacement est le chenillard actif, il reprend à sa
+  *         première étape avec la nouvelle table. Un programme chargé dans
+  *         l'emplacement est remplacé.
+  * @param  pattern: Numéro d'un emplacement chargé (après les prédéfinis)
+  * @param  steps: Masques des étapes (bits au-delà de LED_COUNT interdits)
+  * @param  length: Nombre d'étapes (1 à PATTERN_MAX_STEPS)
+  * @retval true si le chenillard a été chargé, false sinon
+  */
+bool Pattern_Define(uint8_t pattern, const uint8_t *steps, uint8_t length)
+{
+  if (pattern <= PATTERN_BUILTIN_COUNT || pattern > Pattern_GetCount() ||
+      length == 0 || length > PATTERN_MAX_STEPS)
+  {
+    return false;
+  }
+  for (uint8_t i = 0; i < length; i++)
+  {
+    if ((steps[i] & ~LED_MASK_ALL) != 0)
+    {
+      return false;
+    }
+  }
+
+  Pattern_Slot *slot = &userPatterns[pattern - PATTERN_BUILTIN_COUNT - 1];
+  memcpy(slot->steps, steps, length);
+  slot->length = length;
+  slot->codeLength = 0;
+
+  if (activePattern == (Pattern_Type)pattern)
+  {
+    Pattern_StopPlayback();
+    activeLength = length;
+    activeCode = NULL;
+    patternStep = 0;
+    Pattern_StartPlayback();
+  }
+  return true;
+}
+
+/**
+  * @brief  Chargement d'un programme dans un emplacement RAM
+  * @note   Le bytecode est vérifié en entier avant d'être copié (codes
+  *         d'opération, registres, cibles de saut, valeurs immédiates) :
+  *         seuls le budget d'instructions par étape et une période calculée
+  *         restent contrôlés à l'exécution. Si l'emplacement est le
+  *         chenillard actif, le nouveau programme démarre aussitôt.
+  * @param  pattern: Numéro d'un emplacement chargé (après les prédéfinis)
+  * @param  code: Bytecode (PATTERN_VM_INSN_SIZE octets par instruction)
+  * @param  length: Octets de bytecode (1 à PATTERN_PROGRAM_SIZE / 4
+  *         instructions)
+  * @retval true si le programme a été chargé, false sinon
+  */
+bool Pattern_DefineProgram(uint8_t pattern, const uint8_t *code, uint8_t length)
+{
+  if (pattern <= PATTERN_BUILTIN_COUNT || pattern > Pattern_GetCount() ||
+      !Pattern_VerifyProgram(code, length))
+  {
+    return false;
+  }
+
+  Pattern_Slot *slot = &userPatterns[pattern - PATTERN_BUILTIN_COUNT - 1];
+  memcpy(slot->code, code, length);
+  slot->codeLength = length;
+  slot->length = 0;
+
+  if (activePattern == (Pattern_Type)pattern)
+  {
+    Pattern_StopPlayback();
+    activeLength = 0;
+    activeCode = slot->code;
+    activeCodeLength = length;
+    Pattern_StartPlayback();
+  }
+  return true;
+}
+
+/**
+  * @brief  Nombre de programmes arrêtés depuis le démarrage
+  * @param  None
+  * @retval Programmes arrêtés faute d'avoir fixé une étape dans leur
+  *         budget d'instructions, ou sur une période hors limites
+  */
+uint32_t Pattern_GetProgramFaults(void)
+{
+  return programFaults;
+}
+
+/**
+  * @brief  Choix de la lecture des étapes (processeur ou DMA)
+  * @note   Un chenillard actif reprend à sa première étape avec la nouvelle
+  *         lecture.
+  * @param  mode: PATTERN_PLAYBACK_CPU ou PATTERN_PLAYBACK_DMA
+  * @retval true si l'opération a réussi, false sinon
+  */
+bool Pattern_SetPlayback(Pattern_Playback mode)
+{
+  if (mode != PATTERN_PLAYBACK_CPU && mode != PATTERN_PLAYBACK_DMA)
+  {
+    return false;
+  }
+
+  playback = mode;
+  if (activePattern != PATTERN_NONE)
+  {
+    Pattern_StopPlayback();
+    patternStep = 0;
+    Pattern_StartPlayback();
+  }
+  return true;
+}
+
+/**
+  * @brief  Récupération de la lecture des étapes demandée
+  * @param  None
+  * @retval PATTERN_PLAYBACK_CPU ou PATTERN_PLAYBACK_DMA
+  */
+Pattern_Playback Pattern_GetPlayback(void)
+{
+  return playback;
+}
+
+/**
+  * @brief  Activation du fondu entre les étapes
+  * @note   Un chenillard actif reprend à sa première étape.
+  * @param  enabled: true pour atteindre chaque étape par un fondu
+  * @retval None
+  */
+void Pattern_SetFade(bool enabled)
+{
+  fadeSteps = enabled;
+  if (activePattern != PATTERN_NONE)
+  {
+    Pattern_StopPlayback();
+    patternStep = 0;
+    Pattern_StartPlayback();
+  }
+}
+
+/**
+  * @brief  Indique si les étapes sont atteintes par un fondu
+  * @param  None
+  * @retval true en fondu, false sinon
+  */
+bool Pattern_GetFade(void)
+{
+  return fadeSteps;
+}
+
+/**
+  * @brief  Nombre d'étapes perdues depuis le démarrage
+  * @note   Seule la lecture par le timer logiciel est concernée : une
+  *         étape jouée par le DMA ne peut pas être perdue.
+  * @param  None
+  * @retval Échéances du timer des étapes survenues avant que l'étape
+  *         précédente ne soit appliquée
+  */
+uint32_t Pattern_GetMissedSteps(void)
+{
+  return missedSteps;
+}
+
+/**
+  * @brief  Échéance du timer des étapes
+  * @note   Appelée par Timer_Process (boucle principale) à chaque période :
+  *         active le flag de mise à jour traité par
+  *         Pattern_Controller_Update. Si le flag est encore actif, la
+  *         boucle a été occupée plus d'une période : l'étape est perdue.
+  * @param  timer: Timer échu (patternTimer)
+  * @param  context: Inutilisé
   * @retval None
   */
-void Pattern_TimerCallback(Pattern_Frequency timerType)
+ITCM_CODE static void Pattern_TimerExpired(Soft_Timer *timer, void *context)
 {
-  /* Vérification que le timer correspond au pattern actif */
-  if (activePattern != PATTERN_NONE && timerType == currentFrequency)
+  (void)timer;
+  (void)context;
+
+  if (activePattern != PATTERN_NONE)
   {
+    if (patternNeedsUpdate)
+    {
+      missedSteps++;
+    }
     patternNeedsUpdate = true;
   }
 }
 
 /**
-  * @brief  Mise à jour du chenillard de type 1
-  * @note   Pattern 1 : Allumage séquentiel des LED de gauche à droite
-  *         Étape 0 : LED1 ON, LED2 OFF, LED3 OFF
-  *         Étape 1 : LED1 OFF, LED2 ON, LED3 OFF
-  *         Étape 2 : LED1 OFF, LED2 OFF, LED3 ON
-  *         Puis retour à l'étape 0
+  * @brief  Indique si le chenillard doit être joué par le DMA
+  * @param  None
+  * @retval true si la lecture DMA est demandée, couvre la période actuelle
+  *         et que les étapes ne sont pas en fondu (ni calculées par un
+  *         programme)
+  */
+static bool Pattern_UseDma(void)
+{
+  return playback == PATTERN_PLAYBACK_DMA && !fadeSteps && activeCode == NULL &&
+         stepPeriodMs <= DMA_PLAYER_MAX_PERIOD_MS;
+}
+
+/**
+  * @brief  Lancement de la lecture des étapes du chenillard actif
+  * @note   En lecture DMA, la table est convertie en mots BSRR puis jouée
+  *         par TIM8 (première étape immédiate). Sinon, le timer logiciel
+  *         est armé et la première étape est appliquée au prochain
+  *         Pattern_Controller_Update. La lecture DMA reprend toujours à la
+  *         première étape, un programme à sa première instruction.
   * @param  None
   * @retval None
   */
-static void Pattern1_Update(void)
+static void Pattern_StartPlayback(void)
 {
-  /* Extinction de toutes les LED */
-  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  if (Pattern_UseDma())
   {
-    LED_ForceState(i, LED_OFF);
+    for (uint8_t i = 0; i < activeLength; i++)
+    {
+      bsrrSteps[i] = LED_MaskToBsrr(activeSteps[i]);
+    }
+    /* Broches en sortie GPIO (fin des niveaux PWM) pour les écritures BSRR */
+    LED_ForceMask(activeSteps[0]);
+    if (DMA_Player_Start(bsrrSteps, activeLength, LED_GetBsrrAddress(), stepPeriodMs))
+    {
+      return;
+    }
   }
-  
-  /* Allumage de la LED correspondant à l'étape actuelle */
-  LED_ForceState(patternStep + 1, LED_ON);
-  
-  /* Passage à l'étape suivante */
-  patternStep = (patternStep + 1) % LED_COUNT;
+
+  /* Lecture par le timer logiciel (demandée, ou DMA indisponible) */
+  memset(&vm, 0, sizeof(vm));
+  vm.random = 0x9E3779B9u ^ Timer_GetTicks();
+  Timer_Arm(&patternTimer, stepPeriodMs, stepPeriodMs, Pattern_TimerExpired, NULL);
+  patternNeedsUpdate = true;
 }
 
 /**
-  * @brief  Mise à jour du chenillard de type 2
-  * @note   Pattern 2 : Alternance des LED paires et impaires
-  *         Étape 0 : LED1 ON, LED2 OFF, LED3 ON
-  *         Étape 1 : LED1 OFF, LED2 ON, LED3 OFF
-  *         Puis retour à l'étape 0
+  * @brief  Arrêt de la lecture des étapes (timer logiciel et DMA)
   * @param  None
   * @retval None
   */
-static void Pattern2_Update(void)
+static void Pattern_StopPlayback(void)
 {
-  /* Alternance entre LED paires et impaires */
-  if (patternStep == 0)
+  DMA_Player_Stop();
+  Timer_Cancel(&patternTimer);
+  patternNeedsUpdate = false;
+}
+
+/**
+  * @brief  Application d'une étape : masque des LED, franc ou en fondu
+  * @param  mask: Masque des LED (bit 0 : LED1)
+  * @retval None
+  */
+ITCM_CODE static void Pattern_ShowMask(uint8_t mask)
+{
+  if (fadeSteps)
   {
-    /* Étape 0 : LED impaires allumées */
-    LED_ForceState(1, LED_ON);
-    LED_ForceState(2, LED_OFF);
-    LED_ForceState(3, LED_ON);
+    LED_FadeMask(mask, stepPeriodMs);
   }
   else
   {
-    /* Étape 1 : LED paires allumées */
-    LED_ForceState(1, LED_OFF);
-    LED_ForceState(2, LED_ON);
-    LED_ForceState(3, LED_OFF);
+    LED_ForceMask(mask);
   }
-  
-  /* Passage à l'étape suivante */
-  patternStep = (patternStep + 1) % 2;
 }
 
 /**
-  * @brief  Mise à jour du chenillard de type 3
-  * @note   Pattern 3 : Allumage en chenille avec retour
-  *         Étape 0 : LED1 ON, LED2 OFF, LED3 OFF
-  *         Étape 1 : LED1 ON, LED2 ON, LED3 OFF
-  *         Étape 2 : LED1 ON, LED2 ON, LED3 ON
-  *         Étape 3 : LED1 OFF, LED2 ON, LED3 ON
-  *         Étape 4 : LED1 OFF, LED2 OFF, LED3 ON
-  *         Étape 5 : LED1 OFF, LED2 OFF, LED3 OFF
-  *         Puis retour à l'étape 0
+  * @brief  Exécution du programme actif jusqu'à la fin de l'étape
+  * @note   Le programme reprend après l'instruction qui a terminé l'étape
+  *         précédente et s'exécute jusqu'à la prochaine SHOW, SHOWI ou
+  *         WAIT ; après sa dernière instruction, il reprend à la première.
+  *         Un programme qui ne termine pas l'étape en PATTERN_VM_BUDGET
+  *         instructions (boucle sans étape) ou qui demande une période hors
+  *         limites est arrêté (Pattern_ProgramFault). Les opérandes ont été
+  *         vérifiés au chargement.
   * @param  None
   * @retval None
   */
-static void Pattern3_Update(void)
+ITCM_CODE static void Pattern_RunProgram(void)
 {
-  /* Extinction de toutes les LED */
-  for (uint8_t i = 1; i <= LED_COUNT; i++)
+  uint8_t count = activeCodeLength / PATTERN_VM_INSN_SIZE;
+
+  if (vm.wait > 0)
   {
-    LED_ForceState(i, LED_OFF);
+    vm.wait--;
+    return;
   }
-  
-  /* Allumage des LED selon l'étape */
-  switch (patternStep)
+
+  for (uint8_t budget = PATTERN_VM_BUDGET; budget > 0; budget--)
   {
-    case 0:
-      LED_ForceState(1, LED_ON);
-      break;
-    case 1:
-      LED_ForceState(1, LED_ON);
-      LED_ForceState(2, LED_ON);
-      break;
-    case 2:
-      LED_ForceState(1, LED_ON);
-      LED_ForceState(2, LED_ON);
-      LED_ForceState(3, LED_ON);
-      break;
-    case 3:
-      LED_ForceState(2, LED_ON);
-      LED_ForceState(3, LED_ON);
-      break;
-    case 4:
-      LED_ForceState(3, LED_ON);
-      break;
-    default:
-      break;
+    const uint8_t *insn = &activeCode[vm.pc * PATTERN_VM_INSN_SIZE];
+    /* Champ a non vérifié pour les instructions sans registre : masqué */
+    uint16_t *a = &vm.regs[insn[1] & (PATTERN_VM_REGISTERS - 1)];
+    uint16_t imm = (uint16_t)((insn[2] << 8) | insn[3]);
+
+    vm.pc = (vm.pc + 1 < count) ? vm.pc + 1 : 0;
+    switch (insn[0])
+    {
+      case PATTERN_OP_SET:  *a = imm; break;
+      case PATTERN_OP_MOV:  *a = vm.regs[insn[2]]; break;
+      case PATTERN_OP_ADD:  *a = (uint16_t)(*a + vm.regs[insn[2]]); break;
+      case PATTERN_OP_ADDI: *a = (uint16_t)(*a + imm); break;
+      case PATTERN_OP_ANDI: *a &= imm; break;
+      case PATTERN_OP_XORI: *a ^= imm; break;
+      case PATTERN_OP_SHLI: *a = (imm < 16) ? (uint16_t)(*a << imm) : 0; break;
+      case PATTERN_OP_SHRI: *a = (imm < 16) ? (uint16_t)(*a >> imm) : 0; break;
+      case PATTERN_OP_RAND: *a = Pattern_Random(imm); break;
+      case PATTERN_OP_LEDS: *a = (uint16_t)LED_GetMask(); break;
+
+      case PATTERN_OP_SHOW:
+        Pattern_ShowMask((uint8_t)(*a & LED_MASK_ALL));
+        return;
+      case PATTERN_OP_SHOWI:
+        Pattern_ShowMask((uint8_t)imm);
+        return;
+      case PATTERN_OP_WAIT:
+        vm.wait = imm - 1;
+        return;
+
+      case PATTERN_OP_PERIOD:
+      case PATTERN_OP_PERIODI:
+        if (!Pattern_SetPeriod((insn[0] == PATTERN_OP_PERIOD) ? *a : imm))
+        {
+          Pattern_ProgramFault();
+          return;
+        }
+        break;
+
+      case PATTERN_OP_JMP:  vm.pc = insn[3]; break;
+      case PATTERN_OP_JZ:   if (*a == 0) { vm.pc = insn[3]; } break;
+      case PATTERN_OP_JNZ:  if (*a != 0) { vm.pc = insn[3]; } break;
+      case PATTERN_OP_JLT:  if (*a < vm.regs[insn[2]]) { vm.pc = insn[3]; } break;
+      case PATTERN_OP_DJNZ: if (--*a != 0) { vm.pc = insn[3]; } break;
+
+      case PATTERN_OP_HALT:
+      default:
+        Pattern_Stop();
+        return;
+    }
   }
-  
-  /* Passage à l'étape suivante */
-  patternStep = (patternStep + 1) % 6;
+
+  /* Budget épuisé sans étape */
+  Pattern_ProgramFault();
 }
 
+/**
+  * @brief  Arrêt d'un programme fautif (compté, LED éteintes)
+  * @param  None
+  * @retval None
+  */
+static void Pattern_ProgramFault(void)
+{
+  programFaults++;
+  Pattern_Stop();
+}
+
+/**
+  * @brief  Tirage aléatoire (xorshift32) pour l'instruction RAND
+  * @param  bound: Borne exclue (0 : valeur 16 bits quelconque)
+  * @retval Valeur de 0 à bound - 1
+  */
+static uint16_t Pattern_Random(uint16_t bound)
+{
+  uint32_t x = vm.random;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  vm.random = x;
+  return (bound != 0) ? (uint16_t)(x % bound) : (uint16_t)x;
+}
+
+/**
+  * @brief  Vérification d'un programme avant son chargement
+  * @note   Chaque instruction doit avoir un code connu, des registres
+  *         existants, une cible de saut dans le programme et une valeur
+  *         immédiate acceptable (masque de LED, WAIT d'au moins une étape,
+  *         période dans les limites). L'exécution n'a ensuite plus à
+  *         contrôler ses opérandes.
+  * @param  code: Bytecode
+  * @param  length: Octets de bytecode
+  * @retval true si le programme est valide, false sinon
+  */
+static bool Pattern_VerifyProgram(const uint8_t *code, uint8_t length)
+{
+  uint8_t count = length / PATTERN_VM_INSN_SIZE;
+
+  if (length == 0 || length > PATTERN_PROGRAM_SIZE || (length % PATTERN_VM_INSN_SIZE) != 0)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    const uint8_t *insn = &code[i * PATTERN_VM_INSN_SIZE];
+    uint16_t imm = (uint16_t)((insn[2] << 8) | insn[3]);
+    bool validA = insn[1] < PATTERN_VM_REGISTERS;
+    bool validB = insn[2] < PATTERN_VM_REGISTERS;
+    bool validTarget = insn[3] < count;
+    bool valid;
+
+    switch (insn[0])
+    {
+      case PATTERN_OP_SET:
+      case PATTERN_OP_ADDI:
+      case PATTERN_OP_ANDI:
+      case PATTERN_OP_XORI:
+      case PATTERN_OP_SHLI:
+      case PATTERN_OP_SHRI:
+      case PATTERN_OP_RAND:
+      case PATTERN_OP_LEDS:
+      case PATTERN_OP_SHOW:
+      case PATTERN_OP_PERIOD:
+        valid = validA;
+        break;
+      case PATTERN_OP_MOV:
+      case PATTERN_OP_ADD:
+        valid = validA && validB;
+        break;
+      case PATTERN_OP_SHOWI:
+        valid = (imm & ~LED_MASK_ALL) == 0;
+        break;
+      case PATTERN_OP_WAIT:
+        valid = imm >= 1;
+        break;
+      case PATTERN_OP_PERIODI:
+        valid = imm >= PATTERN_PERIOD_MIN_MS && imm <= PATTERN_PERIOD_MAX_MS;
+        break;
+      case PATTERN_OP_JMP:
+        valid = validTarget;
+        break;
+      case PATTERN_OP_JZ:
+      case PATTERN_OP_JNZ:
+      case PATTERN_OP_DJNZ:
+        valid = validA && validTarget;
+        break;
+      case PATTERN_OP_JLT:
+        valid = validA && validB && validTarget;
+        break;
+      case PATTERN_OP_HALT:
+        valid = true;
+        break;
+      default:
+        valid = false;
+        break;
+    }
+    if (!valid)
+    {
+      return false;
+    }
+  }
+  return true;
+}
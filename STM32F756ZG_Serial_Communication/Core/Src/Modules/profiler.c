@@ -0,0 +1,186 @@
+/**
+  ******************************************************************************
+  * @file           : profiler.c
+  * @brief          : Profilage par compteur de cycles
+  * @author         :
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente le cumul des mesures des sondes PROFILE_BEGIN /
+  * PROFILE_END. Une mesure est la différence de deux lectures de CYCCNT,
+  * diminuée du coût de ces deux lectures (mesuré à l'initialisation, les
+  * interruptions masquées) : une sonde vide mesure 0 cycle.
+  *
+  * Chaque sonde n'est alimentée que depuis un seul contexte (boucle
+  * principale ou une interruption) : Profile_Record met à jour ses
+  * compteurs sans masquer les interruptions. La lecture et la remise à zéro,
+  * faites depuis la boucle, les masquent pour ne pas couper une mesure en
+  * cours depuis une interruption.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "Modules/profiler.h"
+#include "Modules/memory_sections.h"
+#include <string.h>
+
+/* Constantes privées --------------------------------------------------------*/
+#define PROFILE_CALIBRATION_RUNS  16    // Mesures du coût d'une sonde vide
+
+/* Variables privées ---------------------------------------------------------*/
+/* Noms affichés par la commande PROFILE, dans l'ordre de Profile_Probe */
+static const char * const probeNames[PROFILE_PROBE_COUNT] = {
+  "ProcessChar",
+  "ProcessCommands",
+  "PatternUpdate",
+  "USART3_IRQ",
+};
+
+#if PROFILE_ENABLED
+DTCM_DATA static Profile_Stats probes[PROFILE_PROBE_COUNT]; // Mesures par sonde
+static uint32_t overhead = 0;                    // Coût d'une sonde vide (cycles)
+#endif
+
+/* Prototypes des fonctions privées ------------------------------------------*/
+#if PROFILE_ENABLED
+static void Profile_Clear(void);
+#endif
+
+/**
+  * @brief  Initialisation des sondes
+  * @note   À appeler après Event_Init, qui active le compteur de cycles.
+  * @param  None
+  * @retval None
+  */
+void Profile_Init(void)
+{
+#if PROFILE_ENABLED
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  overhead = UINT32_MAX;
+  for (uint32_t i = 0; i < PROFILE_CALIBRATION_RUNS; i++)
+  {
+    uint32_t start = Profile_Now();
+    uint32_t cycles = Profile_Now() - start;
+    if (cycles < overhead)
+    {
+      overhead = cycles;
+    }
+  }
+  Profile_Clear();
+  __set_PRIMASK(primask);
+#endif
+}
+
+/**
+  * @brief  Ajout d'une mesure (appelée par PROFILE_END)
+  * @param  probe: Sonde mesurée
+  * @param  cycles: Cycles entre les deux lectures du compteur
+  * @retval None
+  */
+ITCM_CODE void Profile_Record(Profile_Probe probe, uint32_t cycles)
+{
+#if PROFILE_ENABLED
+  Profile_Stats *stats = &probes[probe];
+
+  cycles = (cycles > overhead) ? cycles - overhead : 0;
+
+  stats->count++;
+  stats->sum += cycles;
+  if (cycles < stats->min)
+  {
+    stats->min = cycles;
+  }
+  if (cycles > stats->max)
+  {
+    stats->max = cycles;
+  }
+  stats->histogram[(cycles != 0) ? 31u - __CLZ(cycles) : 0]++;
+#else
+  (void)probe;
+  (void)cycles;
+#endif
+}
+
+/**
+  * @brief  Lecture des mesures d'une sonde
+  * @param  probe: Sonde
+  * @param  stats: Structure à remplir (min à 0 si aucune mesure)
+  * @retval None
+  */
+void Profile_GetStats(Profile_Probe probe, Profile_Stats *stats)
+{
+#if PROFILE_ENABLED
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *stats = probes[probe];
+  __set_PRIMASK(primask);
+
+  if (stats->count == 0)
+  {
+    stats->min = 0;
+  }
+#else
+  (void)probe;
+  memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+/**
+  * @brief  Nom d'une sonde
+  * @param  probe: Sonde
+  * @retval Nom affiché par la commande PROFILE
+  */
+const char *Profile_GetName(Profile_Probe probe)
+{
+  return (probe < PROFILE_PROBE_COUNT) ? probeNames[probe] : "?";
+}
+
+/**
+  * @brief  Coût d'une sonde vide, retranché de chaque mesure
+  * @param  None
+  * @retval Cycles
+  */
+uint32_t Profile_GetOverhead(void)
+{
+#if PROFILE_ENABLED
+  return overhead;
+#else
+  return 0;
+#endif
+}
+
+/**
+  * @brief  Remise à zéro des mesures de toutes les sondes
+  * @param  None
+  * @retval None
+  */
+void Profile_Reset(void)
+{
+#if PROFILE_ENABLED
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  Profile_Clear();
+  __set_PRIMASK(primask);
+#endif
+}
+
+#if PROFILE_ENABLED
+/**
+  * @brief  Remise à zéro des mesures (interruptions masquées par l'appelant)
+  * @param  None
+  * @retval None
+  */
+static void Profile_Clear(void)
+{
+  memset(probes, 0, sizeof(probes));
+  for (uint32_t i = 0; i < PROFILE_PROBE_COUNT; i++)
+  {
+    probes[i].min = UINT32_MAX;
+  }
+}
+#endif
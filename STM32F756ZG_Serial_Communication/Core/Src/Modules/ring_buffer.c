@@ -0,0 +1,194 @@
+/**
+  ******************************************************************************
+  * @file           : ring_buffer.c
+  * @brief          : Buffer circulaire producteur/consommateur sans verrou
+  * @author         : 
+  * @date           : 07-04-2025
+  ******************************************************************************
+  * @description
+  * Ce fichier implémente un buffer circulaire d'octets à un seul producteur
+  * et un seul consommateur. Il sert de point de passage unique entre les
+  * interruptions UART et la boucle principale :
+  * - Réception : l'interruption (ou le DMA) produit, la boucle principale
+  *   consomme et alimente le parseur de commandes.
+  * - Émission : la boucle principale produit, l'interruption de fin de
+  *   transfert DMA consomme.
+  * 
+  * Aucune opération ne bloque ni ne masque les interruptions. L'ordre des
+  * accès mémoire est garanti par des barrières __DMB() :
+  * - le producteur écrit les données AVANT de publier head ;
+  * - le consommateur lit head AVANT les données, et finit de lire les
+  *   données AVANT de libérer la place en publiant tail.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "Modules/ring_buffer.h"
+#include "Modules/memory_sections.h"
+#include <string.h>
+
+/**
+  * @brief  Initialisation d'un buffer circulaire
+  * @param  ring: Buffer à initialiser
+  * @param  storage: Zone de stockage
+  * @param  size: Taille de la zone, puissance de 2
+  * @retval true si l'initialisation a réussi, false si la taille est invalide
+  */
+bool Ring_Buffer_Init(Ring_Buffer *ring, uint8_t *storage, uint32_t size)
+{
+  if (storage == NULL || size == 0 || (size & (size - 1)) != 0)
+  {
+    return false;
+  }
+
+  ring->buffer = storage;
+  ring->size = size;
+  ring->head = 0;
+  ring->tail = 0;
+  return true;
+}
+
+/**
+  * @brief  Vidage du buffer
+  * @note   À n'appeler que lorsque ni le producteur ni le consommateur ne
+  *         sont actifs (interruption arrêtée).
+  * @param  ring: Buffer à vider
+  * @retval None
+  */
+void Ring_Buffer_Reset(Ring_Buffer *ring)
+{
+  ring->head = 0;
+  ring->tail = 0;
+}
+
+/**
+  * @brief  Nombre d'octets publiés et non encore consommés
+  * @note   Un producteur qui écrit sans contrôle de place (DMA circulaire)
+  *         peut faire dépasser la taille du buffer : l'appelant doit alors
+  *         considérer les données comme écrasées.
+  * @param  ring: Buffer concerné
+  * @retval Nombre d'octets en attente
+  */
+ITCM_CODE uint32_t Ring_Buffer_Count(const Ring_Buffer *ring)
+{
+  return ring->head - ring->tail;
+}
+
+/**
+  * @brief  Place libre pour le producteur
+  * @param  ring: Buffer concerné
+  * @retval Nombre d'octets pouvant être écrits
+  */
+uint32_t Ring_Buffer_Space(const Ring_Buffer *ring)
+{
+  uint32_t count = Ring_Buffer_Count(ring);
+  return (count >= ring->size) ? 0 : ring->size - count;
+}
+
+/**
+  * @brief  Ajout d'un octet (producteur)
+  * @param  ring: Buffer concerné
+  * @param  byte: Octet à ajouter
+  * @retval true si l'octet a été ajouté, false si le buffer est plein
+  */
+ITCM_CODE bool Ring_Buffer_Push(Ring_Buffer *ring, uint8_t byte)
+{
+  uint32_t head = ring->head;
+
+  if (head - ring->tail >= ring->size)
+  {
+    return false;
+  }
+
+  ring->buffer[head & (ring->size - 1)] = byte;
+  __DMB();
+  ring->head = head + 1;
+  return true;
+}
+
+/**
+  * @brief  Ajout d'une suite d'octets (producteur)
+  * @note   Copie au plus la place disponible, en une ou deux zones
+  *         contiguës, puis publie l'ensemble en une seule écriture de head.
+  * @param  ring: Buffer concerné
+  * @param  data: Octets à ajouter
+  * @param  length: Nombre d'octets
+  * @retval Nombre d'octets effectivement ajoutés
+  */
+uint32_t Ring_Buffer_Write(Ring_Buffer *ring, const uint8_t *data, uint32_t length)
+{
+  uint32_t head = ring->head;
+  uint32_t space = Ring_Buffer_Space(ring);
+  uint32_t offset = head & (ring->size - 1);
+  uint32_t first;
+
+  if (length > space)
+  {
+    length = space;
+  }
+
+  first = ring->size - offset;
+  if (first > length)
+  {
+    first = length;
+  }
+  memcpy(&ring->buffer[offset], data, first);
+  memcpy(ring->buffer, data + first, length - first);
+
+  __DMB();
+  ring->head = head + length;
+  return length;
+}
+
+/**
+  * @brief  Publication d'octets déjà écrits dans la zone (producteur)
+  * @note   Utilisé quand les données sont écrites par le DMA : le producteur
+  *         ne fait qu'avancer head du nombre d'octets transférés.
+  * @param  ring: Buffer concerné
+  * @param  count: Nombre d'octets à publier
+  * @retval None
+  */
+ITCM_CODE void Ring_Buffer_Commit(Ring_Buffer *ring, uint32_t count)
+{
+  __DMB();
+  ring->head += count;
+}
+
+/**
+  * @brief  Accès à la zone contiguë suivante (consommateur)
+  * @note   Les données restent réservées jusqu'à Ring_Buffer_Consume. Une
+  *         zone qui fait le tour du buffer est rendue en deux appels.
+  * @param  ring: Buffer concerné
+  * @param  data: Reçoit l'adresse du premier octet
+  * @retval Nombre d'octets contigus lisibles
+  */
+ITCM_CODE uint32_t Ring_Buffer_PeekSpan(const Ring_Buffer *ring, const uint8_t **data)
+{
+  uint32_t tail = ring->tail;
+  uint32_t count = ring->head - tail;
+  uint32_t offset = tail & (ring->size - 1);
+  uint32_t span = ring->size - offset;
+
+  /* head est lu avant les données qu'il publie */
+  __DMB();
+
+  if (span > count)
+  {
+    span = count;
+  }
+  *data = &ring->buffer[offset];
+  return span;
+}
+
+/**
+  * @brief  Libération d'octets lus (consommateur)
+  * @param  ring: Buffer concerné
+  * @param  count: Nombre d'octets à libérer
+  * @retval None
+  */
+ITCM_CODE void Ring_Buffer_Consume(Ring_Buffer *ring, uint32_t count)
+{
+  /* Les lectures doivent être terminées avant de rendre la place */
+  __DMB();
+  ring->tail += count;
+}
@@ -6,24 +6,27 @@
   * @date           : 07-04-2025
   ******************************************************************************
   * @description
-  * Ce fichier implémente les fonctions pour la gestion des timers du
-  * microcontrôleur STM32F756ZG.
+  * Ce fichier implémente les timers logiciels du microcontrôleur STM32F756ZG.
   * 
-  * Le module gère trois timers avec des périodes différentes :
-  * - TIM2 : 500ms
-  * - TIM3 : 1s
-  * - TIM4 : 3s
+  * Un seul timer matériel est utilisé :
+  * - TIM2 : base de temps de 1 ms (TIMER_TICK_MS), seule interruption
   * 
-  * Chaque timer peut être :
-  * - Initialisé
-  * - Démarré
-  * - Arrêté
-  * - Vérifié (état actif/inactif)
+  * L'interruption ne fait qu'incrémenter le compteur de ticks et, quand la
+  * prochaine échéance (timerNextDue) est atteinte, publier EVENT_TIMER pour
+  * réveiller la boucle principale : les ticks sans échéance ne la
+  * réveillent pas. Timer_Process saute directement les ticks antérieurs à
+  * cette échéance. Les échéances
+  * sont rangées dans une roue de TIMER_WHEEL_SLOTS cases (case = échéance
+  * modulo le nombre de cases), chaque case étant une liste doublement
+  * chaînée :
+  * - Armement et annulation en O(1) (insertion en tête, retrait direct)
+  * - À chaque tick, seule la case du tick courant est parcourue
+  * - Une échéance au-delà d'un tour de roue reste dans sa case jusqu'au
+  *   tour où elle correspond au tick courant
   * 
-  * Les timers sont configurés en mode :
-  * - Comptage vers le haut
-  * - Auto-rechargement
-  * - Interruption à la fin du comptage
+  * Les fonctions d'échéance sont appelées par Timer_Process depuis la
+  * boucle principale, jamais sous interruption : elles peuvent armer ou
+  * annuler des timers et émettre sur l'UART.
   ******************************************************************************
   */
 
@@ -31,166 +34,307 @@
 #include "main.h"
 #include "tim.h"
 #include "Modules/timer_handler.h"
-#include "Modules/pattern_controller.h"
+#include "Modules/event_flags.h"
+#include "Modules/memory_sections.h"
 #include "stm32f7xx_hal.h"
-#include <stdio.h>
+#include <stddef.h>
+
+/* Constantes privées --------------------------------------------------------*/
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_IDLE_TICKS 0x40000000u    // Échéance fictive sans timer armé
 
 /* Variables privées ---------------------------------------------------------*/
-// Ces handles sont déjà déclarés dans tim.h
-// Ne pas les redéclarer ici
-// Tableaux des états des timers
-static bool timerActive[TIMER_COUNT] = {false, false, false};
+DTCM_DATA static Soft_Timer *wheel[TIMER_WHEEL_SLOTS]; // Listes des timers par case
+DTCM_DATA static volatile uint32_t timerTicks = 0; // Ticks comptés par TIM2
+DTCM_DATA static uint32_t wheelTime = 0;        // Dernier tick traité
+DTCM_DATA static volatile uint32_t timerNextDue = TIMER_IDLE_TICKS; // Aucun timer avant ce tick
+
+/* Prototypes des fonctions privées ------------------------------------------*/
+static void Timer_Link(Soft_Timer *timer);
+static void Timer_Unlink(Soft_Timer *timer);
+static void Timer_FindNextDue(void);
 
 /**
-  * @brief  Initialise les timers
+  * @brief  Initialise la roue de timers et démarre la base de temps
+  * @note   TIM2 est configuré par MX_TIM2_Init (1 kHz) ; seule
+  *         l'interruption de mise à jour est activée ici.
   * @param  Aucun
   * @retval Aucun
   */
 void Timer_Init(void)
 {
-  // Les timers sont initialisés par la fonction MX_TIMx_Init générée par CubeMX
-  // Rien à faire ici car les timers sont déjà configurés
-  
-  // Assurez-vous que tous les timers sont arrêtés initialement
-  for (int i = 0; i < TIMER_COUNT; i++) {
-    timerActive[i] = false;
+  for (uint32_t i = 0; i < TIMER_WHEEL_SLOTS; i++)
+  {
+    wheel[i] = NULL;
   }
-  
-  // Ne pas renvoyer de valeur dans une fonction void
+  timerTicks = 0;
+  wheelTime = 0;
+  timerNextDue = TIMER_IDLE_TICKS;
+
+  HAL_TIM_Base_Start_IT(&htim2);
 }
 
 /**
-  * @brief  Démarre un timer
-  * @param  timerType: Type du timer à démarrer
-  * @retval true si le démarrage a réussi, false sinon
+  * @brief  Arme (ou réarme) un timer logiciel
+  * @note   Un timer déjà armé est d'abord retiré de sa case. L'échéance est
+  *         comptée à partir du tick courant ; un délai nul vaut un tick.
+  *         Un timer périodique garde sa phase : l'échéance suivante est
+  *         l'échéance précédente plus la période.
+  * @param  timer: Timer à armer (structure fournie par l'appelant)
+  * @param  delayMs: Délai avant la première échéance en millisecondes
+  * @param  periodMs: Période en millisecondes (0 pour un timer unique)
+  * @param  handler: Fonction appelée à chaque échéance
+  * @param  context: Pointeur transmis à la fonction
+  * @retval true si le timer a été armé, false sinon
   */
-bool Timer_Start(uint8_t timerType)
+bool Timer_Arm(Soft_Timer *timer, uint32_t delayMs, uint32_t periodMs,
+               Timer_Handler handler, void *context)
 {
-  TIM_HandleTypeDef* htim;
-  
-  /* Sélection du timer approprié */
-  switch (timerType)
+  if (timer == NULL || handler == NULL)
   {
-    case PATTERN_FREQ_500MS:
-      htim = &htim2;
-      break;
-    
-    case PATTERN_FREQ_1S:
-      htim = &htim3;
-      break;
-    
-    case PATTERN_FREQ_3S:
-      htim = &htim4;
-      break;
-    
-    default:
-      return false;
+    return false;
   }
-  
-  /* Démarrage du timer */
-  if (HAL_TIM_Base_Start_IT(htim) != HAL_OK)
+
+  if (timer->armed)
   {
-    return false;
+    Timer_Unlink(timer);
   }
-  
-  // --- DEBUG --- 
-  // char debugMsg[50];
-  // snprintf(debugMsg, sizeof(debugMsg), "Timer %d (TIM%d) START\r\n", timerType, (timerType == PATTERN_FREQ_500MS) ? 2 : ((timerType == PATTERN_FREQ_1S) ? 3 : 4));
-  // UART_SendString(debugMsg);
-  // --- Fin DEBUG ---
-  
-  /* Mise à jour de l'état */
-  timerActive[timerType] = true;
-  
+
+  uint32_t delay = delayMs / TIMER_TICK_MS;
+  timer->expiry = timerTicks + ((delay == 0) ? 1 : delay);
+  timer->period = periodMs / TIMER_TICK_MS;
+  timer->handler = handler;
+  timer->context = context;
+  Timer_Link(timer);
+
   return true;
 }
 
 /**
-  * @brief  Arrête un timer
-  * @param  timerType: Type du timer à arrêter
-  * @retval true si l'arrêt a réussi, false sinon
+  * @brief  Annule un timer logiciel
+  * @note   Sans effet si le timer n'est pas armé.
+  * @param  timer: Timer à annuler
+  * @retval Aucun
   */
-bool Timer_Stop(uint8_t timerType)
+void Timer_Cancel(Soft_Timer *timer)
 {
-  TIM_HandleTypeDef* htim;
-  
-  /* Sélection du timer approprié */
-  switch (timerType)
+  if (timer != NULL && timer->armed)
   {
-    case PATTERN_FREQ_500MS:
-      htim = &htim2;
-      break;
-    
-    case PATTERN_FREQ_1S:
-      htim = &htim3;
-      break;
-    
-    case PATTERN_FREQ_3S:
-      htim = &htim4;
-      break;
-    
-    default:
-      return false;
+    Timer_Unlink(timer);
   }
-  
-  /* Arrêt du timer */
-  if (HAL_TIM_Base_Stop_IT(htim) != HAL_OK)
+}
+
+/**
+  * @brief  Change la période d'un timer périodique armé sans perdre sa phase
+  * @note   La période en cours garde la fraction déjà écoulée : après un
+  *         quart de l'ancienne période, l'échéance tombe aux trois quarts de
+  *         la nouvelle. Les échéances suivantes sont espacées de la nouvelle
+  *         période. La fraction est comptée au dernier tick traité par
+  *         Timer_Process : une échéance passée mais pas encore traitée
+  *         appartient toujours à l'étape en cours.
+  * @param  timer: Timer périodique armé
+  * @param  periodMs: Nouvelle période en millisecondes (non nulle)
+  * @retval true si la période a été changée, false sinon
+  */
+bool Timer_SetPeriod(Soft_Timer *timer, uint32_t periodMs)
+{
+  uint32_t period = periodMs / TIMER_TICK_MS;
+
+  if (timer == NULL || !timer->armed || timer->period == 0 || period == 0)
   {
     return false;
   }
-  
-  /* Mise à jour de l'état */
-  timerActive[timerType] = false;
-  
+
+  int32_t elapsed = (int32_t)(wheelTime - (timer->expiry - timer->period));
+  if (elapsed < 0)
+  {
+    elapsed = 0;                  // Premier délai plus long que la période
+  }
+  uint32_t remaining = period - (uint32_t)(((uint64_t)(uint32_t)elapsed * period) / timer->period);
+
+  Timer_Unlink(timer);
+  timer->expiry = wheelTime + ((remaining == 0) ? 1 : remaining);
+  timer->period = period;
+  Timer_Link(timer);
+
   return true;
 }
 
 /**
-  * @brief  Vérifie si un timer est actif
-  * @param  timerType: Type du timer à vérifier
-  * @retval true si le timer est actif, false sinon
+  * @brief  Vérifie si un timer logiciel est armé
+  * @param  timer: Timer à vérifier
+  * @retval true si le timer est dans la roue, false sinon
   */
-bool Timer_IsActive(uint8_t timerType)
+bool Timer_IsArmed(const Soft_Timer *timer)
 {
-  if (timerType >= TIMER_COUNT)
+  return (timer != NULL && timer->armed);
+}
+
+/**
+  * @brief  Lecture de la base de temps
+  * @param  Aucun
+  * @retval Nombre de ticks (TIMER_TICK_MS) depuis Timer_Init
+  */
+uint32_t Timer_GetTicks(void)
+{
+  return timerTicks;
+}
+
+/**
+  * @brief  Traitement des échéances (boucle principale)
+  * @note   Les ticks écoulés depuis le dernier appel sont traités un par
+  *         un : pour chacun, les timers de sa case dont l'échéance est
+  *         atteinte sont retirés (ou reprogrammés s'ils sont périodiques)
+  *         puis leur fonction est appelée. Le parcours de la case reprend
+  *         au début après chaque appel, la fonction ayant pu armer ou
+  *         annuler d'autres timers. Les ticks antérieurs à la prochaine
+  *         échéance connue sont sautés d'un coup ; une fois celle-ci
+  *         traitée, la suivante est recherchée dans la roue.
+  *         Appelée à chaque passage de la boucle : le dernier tick traité
+  *         reste ainsi à jour pour Timer_SetPeriod.
+  * @param  Aucun
+  * @retval Aucun
+  */
+void Timer_Process(void)
+{
+  uint32_t now = timerTicks;
+
+  while (wheelTime != now)
   {
-    return false;
+    bool fired;
+
+    /* Aucune échéance d'ici à now, ou avant timerNextDue : saut direct */
+    if ((int32_t)(timerNextDue - now) > 0)
+    {
+      wheelTime = now;
+      break;
+    }
+    if ((int32_t)(timerNextDue - wheelTime) > 1)
+    {
+      wheelTime = timerNextDue - 1;
+    }
+
+    wheelTime++;
+    do
+    {
+      fired = false;
+      for (Soft_Timer *timer = wheel[wheelTime & TIMER_WHEEL_MASK]; timer != NULL; timer = timer->next)
+      {
+        if (timer->expiry != wheelTime)
+        {
+          continue;
+        }
+
+        Timer_Unlink(timer);
+        if (timer->period != 0)
+        {
+          timer->expiry += timer->period;
+          Timer_Link(timer);
+        }
+        timer->handler(timer, timer->context);
+        fired = true;
+        break;
+      }
+    } while (fired);
+
+    if ((int32_t)(timerNextDue - wheelTime) <= 0)
+    {
+      Timer_FindNextDue();
+    }
   }
-  
-  return timerActive[timerType];
 }
 
 /**
-  * @brief  Callbacks d'interruption des timers
-  * @note   Ces fonctions sont appelées lorsqu'une interruption timer se produit
+  * @brief  Insertion d'un timer en tête de la case de son échéance
+  * @param  timer: Timer à insérer (non armé)
+  * @retval Aucun
   */
-void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+static void Timer_Link(Soft_Timer *timer)
 {
-  // --- DEBUG --- 
-  /*
-  uint8_t timerId = 0;
-  if (htim->Instance == TIM2) timerId = 2;
-  else if (htim->Instance == TIM3) timerId = 3;
-  else if (htim->Instance == TIM4) timerId = 4;
-  if (timerId != 0) {
-      char debugMsg[30];
-      snprintf(debugMsg, sizeof(debugMsg), "TIM%d Interrupt!\r\n", timerId);
-      UART_SendString(debugMsg);
+  Soft_Timer **slot = &wheel[timer->expiry & TIMER_WHEEL_MASK];
+
+  timer->prev = NULL;
+  timer->next = *slot;
+  if (*slot != NULL)
+  {
+    (*slot)->prev = timer;
   }
-  */
-  // --- Fin DEBUG ---
+  *slot = timer;
+  timer->armed = true;
 
-  if (htim->Instance == TIM2)
+  /* Échéance plus proche que celle attendue par l'interruption */
+  if ((int32_t)(timer->expiry - timerNextDue) < 0)
+  {
+    timerNextDue = timer->expiry;
+  }
+}
+
+/**
+  * @brief  Retrait d'un timer de sa case
+  * @param  timer: Timer à retirer (armé)
+  * @retval Aucun
+  */
+static void Timer_Unlink(Soft_Timer *timer)
+{
+  if (timer->prev != NULL)
   {
-    Pattern_TimerCallback(PATTERN_FREQ_500MS);
+    timer->prev->next = timer->next;
   }
-  else if (htim->Instance == TIM3)
+  else
   {
-    Pattern_TimerCallback(PATTERN_FREQ_1S);
+    wheel[timer->expiry & TIMER_WHEEL_MASK] = timer->next;
   }
-  else if (htim->Instance == TIM4)
+  if (timer->next != NULL)
   {
-    Pattern_TimerCallback(PATTERN_FREQ_3S);
+    timer->next->prev = timer->prev;
   }
+  timer->next = NULL;
+  timer->prev = NULL;
+  timer->armed = false;
 }
 
+/**
+  * @brief  Recherche de la prochaine échéance dans la roue
+  * @note   Appelée quand l'échéance attendue vient d'être traitée : tous
+  *         les timers armés ont alors une échéance postérieure à wheelTime.
+  *         Un timer annulé depuis peut laisser une échéance trop proche,
+  *         qui ne coûte qu'un réveil inutile.
+  * @param  Aucun
+  * @retval Aucun
+  */
+static void Timer_FindNextDue(void)
+{
+  uint32_t nearest = TIMER_IDLE_TICKS;
+
+  for (uint32_t i = 0; i < TIMER_WHEEL_SLOTS; i++)
+  {
+    for (Soft_Timer *timer = wheel[i]; timer != NULL; timer = timer->next)
+    {
+      uint32_t delay = timer->expiry - wheelTime;
+      if (delay < nearest)
+      {
+        nearest = delay;
+      }
+    }
+  }
+  timerNextDue = wheelTime + nearest;
+}
+
+/**
+  * @brief  Callback d'interruption des timers
+  * @note   Appelée à chaque débordement de TIM2 (1 ms) : le compteur de
+  *         ticks est mis à jour et la boucle principale n'est réveillée
+  *         (EVENT_TIMER) que si une échéance est atteinte ; les échéances
+  *         sont traitées par Timer_Process.
+  */
+ITCM_CODE void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM2)
+  {
+    timerTicks++;
+    if ((int32_t)(timerTicks - timerNextDue) >= 0)
+    {
+      Event_Post(EVENT_TIMER);
+    }
+  }
+}
@@ -16,13 +16,33 @@
   * - La gestion des erreurs de communication
   * 
   * Configuration UART :
-  * - Baudrate : 115200
+  * - Baudrate : UART_BAUDRATE (115200 par défaut)
   * - Format : 8 bits de données, pas de parité, 1 bit de stop
   * - Mode : Asynchrone
-  * - Buffer de réception : 64 octets
+  * - Buffer de réception : UART_RX_DMA_BUFFER_SIZE octets (circulaire)
   * 
-  * Le module utilise des interruptions pour la réception des données
-  * et gère un buffer circulaire pour stocker les caractères reçus.
+  * Les interruptions ne font que déplacer des octets : elles échangent avec
+  * la boucle principale par deux buffers circulaires sans verrou
+  * (voir ring_buffer.c), et l'analyse des commandes n'a lieu que dans la
+  * boucle principale (UART_ProcessReceived). Chaque publication d'octets
+  * reçus réveille la boucle par l'événement EVENT_UART_RX.
+  * 
+  * La réception se fait par DMA circulaire (DMA1 Stream1 Channel4) avec
+  * détection de ligne inactive (IDLE) : le DMA écrit seul dans le buffer et
+  * l'interruption, levée à mi-buffer, en fin de buffer ou sur IDLE, ne fait
+  * que publier la position d'écriture. Avec UART_RX_USE_DMA à 0, la
+  * réception revient à une interruption par octet, qui ne fait qu'ajouter
+  * l'octet au même buffer.
+  * 
+  * En mode binaire (voir frame_protocol.h), les réponses sont envoyées en
+  * trames par UART_SendFrame, par le même buffer d'émission.
+  * 
+  * L'émission est non bloquante : UART_SendString copie la chaîne dans un
+  * buffer circulaire (UART_TX_RING_SIZE octets) et rend la main. Le buffer
+  * est vidé par DMA (DMA1 Stream3 Channel4), chaque fin de transfert
+  * relançant le transfert suivant depuis l'interruption. Le comportement
+  * quand le buffer est plein est choisi à la compilation par
+  * UART_TX_OVERFLOW_POLICY (attente de vidage ou abandon des octets).
   ******************************************************************************
   */
 
@@ -31,32 +51,73 @@
 #include "usart.h"
 #include "Modules/uart_handler.h"
 #include "Modules/command_parser.h"
+#include "Modules/ring_buffer.h"
+#include "Modules/frame_protocol.h"
+#include "Modules/event_flags.h"
+#include "Modules/memory_sections.h"
 #include <string.h>
 
 /* Définitions privées ------------------------------------------------------*/
 #define UART_TIMEOUT 100  // Timeout pour les transmissions UART en ms
 
+#if (UART_RX_DMA_BUFFER_SIZE & (UART_RX_DMA_BUFFER_SIZE - 1)) != 0
+#error "UART_RX_DMA_BUFFER_SIZE doit etre une puissance de 2"
+#endif
+
+#if (UART_TX_RING_SIZE & (UART_TX_RING_SIZE - 1)) != 0
+#error "UART_TX_RING_SIZE doit etre une puissance de 2"
+#endif
+
 /* Variables privées ---------------------------------------------------------*/
 // Ce handle est déjà déclaré dans usart.h
 // Ne pas le redéclarer ici
-// static uint8_t receivedChar;               // Variable inutilisée supprimée
-static uint8_t rxBuffer[UART_BUFFER_SIZE]; // Buffer de réception
-static uint8_t rxIndex = 0;                // Index dans le buffer
-// static bool rxReady = false;               // Variable inutilisée supprimée
-static bool rxOverflow = false;            // Drapeau de dépassement de buffer
+/* Réception : l'interruption est le producteur, la boucle principale le
+ * consommateur. En mode DMA, les octets sont écrits par le DMA et
+ * l'interruption ne fait que publier leur nombre (Ring_Buffer_Commit) : le
+ * DMA n'attend pas le consommateur, un retard de plus d'un tour est donc
+ * détecté par un nombre d'octets en attente supérieur à la taille. */
+DMA_BUFFER static uint8_t rxStorage[UART_RX_DMA_BUFFER_SIZE]; // Zone écrite par le DMA
+DTCM_DATA static Ring_Buffer rxRing;                   // Réception (ISR -> main)
+static volatile uint32_t rxResyncStart = 0;            // Fin des octets reçus avant l'erreur
+static volatile uint32_t rxResyncTotal = 0;            // Position de reprise après erreur
+static volatile bool rxResync = false;                 // Réception relancée par l'ISR
+static volatile bool rxOverflow = false;               // Drapeau de perte de données
+static UART_RxStats rxStats;                           // Compteurs de réception
+#if !UART_RX_USE_DMA
+static uint8_t rxByte;                                 // Octet reçu par interruption
+#endif
+
+/* Émission : la boucle principale est le producteur, l'interruption de fin
+ * de transfert le consommateur. txInFlight vaut la longueur du transfert
+ * DMA en cours, 0 si le DMA est au repos : seule la boucle principale le
+ * fait passer de 0 à une longueur, seule l'interruption le ramène à 0. */
+DMA_BUFFER static uint8_t txStorage[UART_TX_RING_SIZE]; // Zone lue par le DMA
+DTCM_DATA static Ring_Buffer txRing;                   // Émission (main -> ISR)
+static volatile uint16_t txInFlight = 0;               // Longueur du transfert DMA en cours
+static UART_TxStats txStats;                           // Compteurs d'émission
+
+/* Prototypes de fonctions privées -------------------------------------------*/
+static bool UART_StartReception(void);
+static void UART_DeliverReceived(uint32_t count);
+static void UART_StartTransmit(void);
+#if UART_TX_OVERFLOW_POLICY == UART_TX_OVERFLOW_FLUSH
+static bool UART_WaitTxSpace(void);
+#endif
 
 /**
   * @brief  Initialisation du module UART
   * @note   Cette fonction initialise l'UART avec les paramètres suivants :
-  *         - Baudrate : 115200
+  *         - Baudrate : UART_BAUDRATE
   *         - Format : 8N1
   *         - Pas de parité
   *         - 1 bit de stop
   *         - Pas de contrôle de flux
   *         Elle configure également :
-  *         - Les interruptions de réception
-  *         - Le buffer de réception
-  *         - Les flags d'état
+  *         - Les interruptions de l'UART (IDLE, erreurs)
+  *         - La réception DMA circulaire (ou par interruption)
+  *         - Les buffers de réception et d'émission
+  *         Au-delà de 460800 bauds, le suréchantillonnage passe à 8 pour
+  *         garder une erreur de débit faible avec l'horloge HSI de 16 MHz.
   * @param  None
   * @retval true si l'initialisation a réussi, false sinon
   */
@@ -64,79 +125,363 @@ bool UART_Init(void)
 {
   /* Configuration de l'UART */
   huart3.Instance = USART3;
-  huart3.Init.BaudRate = 115200;
+  huart3.Init.BaudRate = UART_BAUDRATE;
   huart3.Init.WordLength = UART_WORDLENGTH_8B;
   huart3.Init.StopBits = UART_STOPBITS_1;
   huart3.Init.Parity = UART_PARITY_NONE;
   huart3.Init.Mode = UART_MODE_TX_RX;
   huart3.Init.HwFlowCtl = UART_HWCONTROL_NONE;
-  huart3.Init.OverSampling = UART_OVERSAMPLING_16;
-  
+  huart3.Init.OverSampling = (UART_BAUDRATE > 460800) ? UART_OVERSAMPLING_8 : UART_OVERSAMPLING_16;
+
   /* Initialisation de l'UART */
   if (HAL_UART_Init(&huart3) != HAL_OK)
   {
     return false;
   }
-  
+
   /* Activation des interruptions de réception */
   HAL_NVIC_SetPriority(USART3_IRQn, 0, 0);
   HAL_NVIC_EnableIRQ(USART3_IRQn);
-  
+
+  /* Buffers vides */
+  Ring_Buffer_Init(&txRing, txStorage, UART_TX_RING_SIZE);
+  Ring_Buffer_Init(&rxRing, rxStorage, UART_RX_DMA_BUFFER_SIZE);
+  txInFlight = 0;
+  memset(&txStats, 0, sizeof(txStats));
+  memset(&rxStats, 0, sizeof(rxStats));
+  rxResync = false;
+  rxOverflow = false;
+
   /* Démarrage de la réception */
-  HAL_UART_Receive_IT(&huart3, &rxBuffer[rxIndex], 1);
-  
-  return true;
+  return UART_StartReception();
 }
 
 /**
  * @brief  Envoie une chaîne de caractères par UART
+ * @note   La chaîne est copiée dans le buffer d'émission et la fonction
+ *         retourne sans attendre la fin de l'envoi.
  * @param  str: Chaîne à envoyer
  * @retval Aucun
  */
 void UART_SendString(const char* str)
 {
-  HAL_UART_Transmit(&huart3, (uint8_t*)str, strlen(str), UART_TIMEOUT);
-  // Ne pas renvoyer de valeur dans une fonction void
+  UART_Write((const uint8_t*)str, strlen(str));
 }
 
 /**
-  * @brief  Callback de réception UART
-  * @note   Cette fonction est appelée lorsqu'un caractère est reçu.
-  *         Elle :
-  *         - Traite le caractère reçu
-  *         - Gère le dépassement de buffer
-  *         - Transmet le caractère au parseur de commandes
-  *         - Redémarre la réception
+ * @brief  Copie des octets dans le buffer d'émission
+ * @note   À n'appeler que depuis la boucle principale (producteur unique).
+ *         Si le buffer est plein, UART_TX_OVERFLOW_FLUSH attend que le DMA
+ *         libère de la place (au plus UART_TIMEOUT ms sans progression),
+ *         UART_TX_OVERFLOW_DROP abandonne les octets restants. Les octets
+ *         abandonnés sont comptés dans txStats.dropped.
+ * @param  data: Octets à envoyer
+ * @param  length: Nombre d'octets
+ * @retval Aucun
+ */
+void UART_Write(const uint8_t* data, size_t length)
+{
+  while (length > 0)
+  {
+    uint32_t written = Ring_Buffer_Write(&txRing, data, (uint32_t)length);
+
+    if (written == 0)
+    {
+#if UART_TX_OVERFLOW_POLICY == UART_TX_OVERFLOW_FLUSH
+      txStats.flushes++;
+      if (UART_WaitTxSpace())
+      {
+        continue;
+      }
+#endif
+      txStats.dropped += length;
+      break;
+    }
+
+    uint32_t used = Ring_Buffer_Count(&txRing);
+    if (used > txStats.highWater)
+    {
+      txStats.highWater = used;
+    }
+    data += written;
+    length -= written;
+  }
+
+  /* Démarrage du DMA s'il est au repos ; sinon l'interruption de fin de
+   * transfert reprendra les nouveaux octets */
+  if (txInFlight == 0)
+  {
+    UART_StartTransmit();
+  }
+}
+
+/**
+ * @brief  Envoi d'une trame binaire
+ * @note   La trame est construite puis copiée d'un bloc dans le buffer
+ *         d'émission (voir frame_protocol.h pour le format).
+ * @param  opcode: Code d'opération
+ * @param  payload: Données (NULL si length vaut 0)
+ * @param  length: Nombre d'octets de données
+ * @retval Aucun
+ */
+void UART_SendFrame(uint8_t opcode, const uint8_t* payload, uint8_t length)
+{
+  uint8_t frame[FRAME_MAX_SIZE];
+  size_t size = Frame_Encode(opcode, payload, length, frame);
+
+  if (size > 0)
+  {
+    UART_Write(frame, size);
+  }
+}
+
+/**
+ * @brief  Lecture des compteurs d'émission
+ * @param  stats: Structure à remplir
+ * @retval Aucun
+ */
+void UART_GetTxStats(UART_TxStats* stats)
+{
+  *stats = txStats;
+}
+
+/**
+ * @brief  Lecture des compteurs de réception
+ * @note   Contrairement à UART_HasOverflow, la lecture ne remet rien à zéro.
+ * @param  stats: Structure à remplir
+ * @retval Aucun
+ */
+void UART_GetRxStats(UART_RxStats* stats)
+{
+  *stats = rxStats;
+}
+
+/**
+  * @brief  Transmission des octets reçus au parseur de commandes
+  * @note   Appelée depuis la boucle principale, seul consommateur du buffer
+  *         de réception. Les octets publiés depuis le dernier appel sont
+  *         transmis en une ou deux plages contiguës. Après une relance de
+  *         la réception par HAL_UART_ErrorCallback, les octets reçus avant
+  *         l'erreur sont d'abord transmis, puis la fin du tour, que le DMA
+  *         n'a pas écrite, est sautée.
+  * @param  None
+  * @retval None
+  */
+void UART_ProcessReceived(void)
+{
+  if (rxResync)
+  {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    uint32_t gapStart = rxResyncStart;
+    uint32_t gapEnd = rxResyncTotal;
+    rxResync = false;
+    __set_PRIMASK(primask);
+
+    UART_DeliverReceived(gapStart - rxRing.tail);
+    Ring_Buffer_Consume(&rxRing, gapEnd - rxRing.tail);
+  }
+
+  UART_DeliverReceived(Ring_Buffer_Count(&rxRing));
+}
+
+/**
+  * @brief  Transmission au parseur des prochains octets reçus
+  * @note   Si le DMA a pris plus d'un tour d'avance, les données non lues
+  *         ont été écrasées : elles sont abandonnées et le débordement est
+  *         signalé.
+  * @param  count: Nombre d'octets publiés à transmettre
+  * @retval None
+  */
+static void UART_DeliverReceived(uint32_t count)
+{
+  const uint8_t* span;
+  uint32_t length;
+  uint32_t pending = count;
+
+  if (pending > UART_RX_DMA_BUFFER_SIZE)
+  {
+    rxOverflow = true;
+    rxStats.lost += pending;
+    Ring_Buffer_Consume(&rxRing, pending);
+    return;
+  }
+
+  while (pending > 0 && (length = Ring_Buffer_PeekSpan(&rxRing, &span)) > 0)
+  {
+    if (length > pending)
+    {
+      length = pending;
+    }
+    Command_Parser_ProcessBuffer(span, (uint16_t)length);
+    Ring_Buffer_Consume(&rxRing, length);
+    rxStats.bytes += length;
+    pending -= length;
+  }
+}
+
+#if UART_RX_USE_DMA
+/**
+  * @brief  Callback d'événement de réception (mi-buffer, fin de buffer, IDLE)
+  * @note   En mode circulaire, Size est la position d'écriture du DMA dans le
+  *         buffer (UART_RX_DMA_BUFFER_SIZE en fin de tour). L'interruption
+  *         se contente de publier les octets écrits depuis l'appel
+  *         précédent ; les événements mi-buffer et fin de buffer garantissent
+  *         au moins deux appels par tour, l'écart entre deux appels est donc
+  *         toujours inférieur à la taille du buffer.
   * @param  huart: Handle de l'UART
+  * @param  Size: Position d'écriture du DMA
   * @retval None
   */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+ITCM_CODE void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 {
   /* Vérification que c'est bien notre UART */
   if (huart->Instance != USART3)
   {
     return;
   }
-  
-  /* Traitement du caractère reçu */
-  char receivedChar = (char)rxBuffer[rxIndex];
-  
-  /* Gestion du dépassement de buffer */
-  if (rxIndex >= UART_BUFFER_SIZE - 1)
+
+  uint32_t lastPosition = rxRing.head & (UART_RX_DMA_BUFFER_SIZE - 1);
+  uint32_t newPosition = Size & (UART_RX_DMA_BUFFER_SIZE - 1);
+
+  Ring_Buffer_Commit(&rxRing, (newPosition - lastPosition) & (UART_RX_DMA_BUFFER_SIZE - 1));
+  Event_Post(EVENT_UART_RX);
+}
+#else
+/**
+  * @brief  Callback de réception UART (un octet)
+  * @note   L'octet est seulement ajouté au buffer de réception ; il est
+  *         analysé plus tard par la boucle principale.
+  * @param  huart: Handle de l'UART
+  * @retval None
+  */
+ITCM_CODE void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+  /* Vérification que c'est bien notre UART */
+  if (huart->Instance != USART3)
   {
-    rxOverflow = true;
-    rxIndex = 0;
+    return;
   }
-  else
+
+  if (!Ring_Buffer_Push(&rxRing, rxByte))
   {
-    rxIndex++;
+    rxOverflow = true;
+    rxStats.lost++;
   }
-  
-  /* Transmission du caractère au parseur de commandes */
-  Command_Parser_ProcessChar(receivedChar);
-  
+  Event_Post(EVENT_UART_RX);
+
   /* Redémarrage de la réception */
-  HAL_UART_Receive_IT(&huart3, &rxBuffer[rxIndex], 1);
+  HAL_UART_Receive_IT(&huart3, &rxByte, 1);
+}
+#endif
+
+/**
+  * @brief  Callback de fin de transfert DMA en émission
+  * @note   Libère la zone émise et lance le transfert suivant s'il reste
+  *         des octets dans le buffer.
+  * @param  huart: Handle de l'UART
+  * @retval None
+  */
+ITCM_CODE void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance != USART3)
+  {
+    return;
+  }
+
+  Ring_Buffer_Consume(&txRing, txInFlight);
+  txStats.bytes += txInFlight;
+  UART_StartTransmit();
+}
+
+/**
+  * @brief  Callback d'erreur UART
+  * @note   En réception DMA, la HAL arrête la réception sur toute erreur
+  *         (débordement, bruit, trame, parité ou DMA) ; par interruption,
+  *         seul le débordement l'arrête. Une fois la réception arrêtée, les
+  *         octets écrits par le DMA depuis la dernière publication sont
+  *         publiés (position lue dans son compteur) : reçus avant l'erreur,
+  *         ils restent analysés. Le DMA est relancé au début du buffer ; la
+  *         fin du tour en cours, jamais écrite, est sautée par la boucle
+  *         principale après l'analyse de ces octets. Un transfert
+  *         d'émission interrompu est repris depuis le début de la zone non
+  *         émise. Chaque erreur signalée par la HAL est comptée
+  *         (UART_GetRxStats).
+  * @param  huart: Handle de l'UART
+  * @retval None
+  */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance != USART3)
+  {
+    return;
+  }
+
+  uint32_t errors = huart->ErrorCode;
+  if (errors & HAL_UART_ERROR_ORE)
+  {
+    rxStats.overrun++;
+  }
+  if (errors & HAL_UART_ERROR_FE)
+  {
+    rxStats.framing++;
+  }
+  if (errors & HAL_UART_ERROR_NE)
+  {
+    rxStats.noise++;
+  }
+  if (errors & HAL_UART_ERROR_PE)
+  {
+    rxStats.parity++;
+  }
+  if (errors & HAL_UART_ERROR_DMA)
+  {
+    rxStats.dma++;
+  }
+
+  /* Une erreur DMA en émission abandonne le transfert : il est relancé */
+  if (txInFlight != 0 && huart->gState == HAL_UART_STATE_READY)
+  {
+    UART_StartTransmit();
+  }
+
+  if (huart->RxState == HAL_UART_STATE_READY)
+  {
+#if UART_RX_USE_DMA
+    uint32_t lastPosition = rxRing.head & (UART_RX_DMA_BUFFER_SIZE - 1);
+    uint32_t position = (UART_RX_DMA_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx)) & (UART_RX_DMA_BUFFER_SIZE - 1);
+    Ring_Buffer_Commit(&rxRing, (position - lastPosition) & (UART_RX_DMA_BUFFER_SIZE - 1));
+
+    /* Reprise au tour suivant (ou sur place en début de tour). Un saut
+     * encore en attente de la boucle principale est prolongé : les octets
+     * reçus entre les deux erreurs sont abandonnés avec lui et signalés. */
+    uint32_t head = rxRing.head;
+    uint32_t restart = (head + UART_RX_DMA_BUFFER_SIZE - 1) & ~(uint32_t)(UART_RX_DMA_BUFFER_SIZE - 1);
+    Ring_Buffer_Commit(&rxRing, restart - head);
+    if (!rxResync)
+    {
+      rxResyncStart = head;
+    }
+    else
+    {
+      if (head != rxResyncTotal)
+      {
+        rxStats.lost += head - rxResyncTotal;
+        rxOverflow = true;
+      }
+    }
+    rxResyncTotal = restart;
+    rxResync = true;
+#endif
+    /* Seuls le débordement et l'erreur DMA perdent des octets */
+    if (errors & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_DMA))
+    {
+      rxOverflow = true;
+    }
+    UART_StartReception();
+    Event_Post(EVENT_UART_RX);
+  }
 }
 
 /**
@@ -156,8 +501,8 @@ bool UART_HasOverflow(void)
 /**
   * @brief  Réinitialisation du module UART
   * @note   Cette fonction réinitialise complètement le module UART :
+  *         - Arrête la réception
   *         - Vide le buffer de réception
-  *         - Réinitialise l'index
   *         - Désactive le flag de dépassement
   *         - Redémarre la réception
   * @param  None
@@ -165,12 +510,159 @@ bool UART_HasOverflow(void)
   */
 void UART_Reset(void)
 {
+  HAL_UART_AbortReceive(&huart3);
+
   /* Réinitialisation des variables */
-  memset(rxBuffer, 0, UART_BUFFER_SIZE);
-  rxIndex = 0;
+  memset(rxStorage, 0, UART_RX_DMA_BUFFER_SIZE);
+  Ring_Buffer_Reset(&rxRing);
+  rxResync = false;
   rxOverflow = false;
-  
+
   /* Redémarrage de la réception */
-  HAL_UART_Receive_IT(&huart3, &rxBuffer[rxIndex], 1);
+  UART_StartReception();
+}
+
+/**
+  * @brief  Attente de la fin de l'émission en cours
+  * @note   Le buffer d'émission est vidé par le DMA, puis le dernier octet
+  *         quitte le registre à décalage (drapeau TC). L'attente est
+  *         abandonnée si aucun octet n'a été émis pendant UART_TIMEOUT ms.
+  *         À appeler avant de changer l'horloge de l'UART.
+  * @param  None
+  * @retval true si tout a été émis, false sur timeout
+  */
+bool UART_Flush(void)
+{
+  uint32_t tail = txRing.tail;
+  uint32_t start = HAL_GetTick();
+
+  while (Ring_Buffer_Count(&txRing) > 0 || txInFlight != 0 ||
+         !__HAL_UART_GET_FLAG(&huart3, UART_FLAG_TC))
+  {
+    if (txInFlight == 0 && Ring_Buffer_Count(&txRing) > 0)
+    {
+      UART_StartTransmit();
+    }
+    if (txRing.tail != tail)
+    {
+      tail = txRing.tail;
+      start = HAL_GetTick();
+    }
+    if (HAL_GetTick() - start > UART_TIMEOUT)
+    {
+      return false;
+    }
+  }
+  return true;
 }
 
+/**
+  * @brief  Recalcul du diviseur de débit après un changement d'horloge
+  * @note   USART3 est cadencé par PCLK1 : BRR est recalculé pour garder
+  *         UART_BAUDRATE avec le suréchantillonnage choisi à
+  *         l'initialisation. BRR ne s'écrit qu'UART désactivé (UE à 0) ;
+  *         les registres de contrôle et le DMA de réception sont conservés,
+  *         la réception reprend dès la réactivation. Un octet en cours de
+  *         réception pendant le changement est perdu.
+  * @param  None
+  * @retval None
+  */
+void UART_UpdateBaudRate(void)
+{
+  uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+  uint32_t brr;
+
+  if (huart3.Init.OverSampling == UART_OVERSAMPLING_8)
+  {
+    uint32_t div = UART_DIV_SAMPLING8(pclk, huart3.Init.BaudRate);
+    brr = (div & 0xFFF0u) | ((div & 0x000Fu) >> 1);
+  }
+  else
+  {
+    brr = UART_DIV_SAMPLING16(pclk, huart3.Init.BaudRate);
+  }
+
+  __HAL_UART_DISABLE(&huart3);
+  huart3.Instance->BRR = brr;
+  __HAL_UART_ENABLE(&huart3);
+}
+
+/**
+  * @brief  Démarrage de la réception
+  * @note   En mode DMA, l'interruption mi-buffer est conservée : elle publie
+  *         la position lors d'une longue rafale sans silence sur la ligne.
+  * @param  None
+  * @retval true si la réception a démarré, false sinon
+  */
+static bool UART_StartReception(void)
+{
+#if UART_RX_USE_DMA
+  if (HAL_UARTEx_ReceiveToIdle_DMA(&huart3, rxStorage, UART_RX_DMA_BUFFER_SIZE) != HAL_OK)
+#else
+  if (HAL_UART_Receive_IT(&huart3, &rxByte, 1) != HAL_OK)
+#endif
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+  * @brief  Lancement du transfert DMA suivant depuis le buffer d'émission
+  * @note   Appelée par la boucle principale quand le DMA est au repos, ou par
+  *         l'interruption de fin de transfert. Un transfert ne couvre qu'une
+  *         zone contiguë : une zone qui fait le tour du buffer est envoyée
+  *         en deux transferts.
+  * @param  None
+  * @retval None
+  */
+ITCM_CODE static void UART_StartTransmit(void)
+{
+  const uint8_t* span;
+  uint32_t length = Ring_Buffer_PeekSpan(&txRing, &span);
+
+  if (length == 0)
+  {
+    txInFlight = 0;
+    return;
+  }
+
+  txInFlight = (uint16_t)length;
+  if (HAL_UART_Transmit_DMA(&huart3, (uint8_t*)span, (uint16_t)length) != HAL_OK)
+  {
+    txInFlight = 0;
+  }
+}
+
+#if UART_TX_OVERFLOW_POLICY == UART_TX_OVERFLOW_FLUSH
+/**
+  * @brief  Attente de place libre dans le buffer d'émission
+  * @note   Relance le DMA s'il est au repos. L'attente est abandonnée si
+  *         aucun octet n'a été émis pendant UART_TIMEOUT ms.
+  * @param  None
+  * @retval true si de la place s'est libérée, false sur timeout
+  */
+static bool UART_WaitTxSpace(void)
+{
+  uint32_t tail = txRing.tail;
+  uint32_t start = HAL_GetTick();
+
+  while (Ring_Buffer_Space(&txRing) == 0)
+  {
+    if (txInFlight == 0)
+    {
+      UART_StartTransmit();
+    }
+    if (txRing.tail != tail)
+    {
+      tail = txRing.tail;
+      start = HAL_GetTick();
+    }
+    if (HAL_GetTick() - start > UART_TIMEOUT)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
@@ -18,6 +18,7 @@
 /* USER CODE END Header */
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "dma.h"
 #include "tim.h"
 #include "usart.h"
 #include "gpio.h"
@@ -30,6 +31,9 @@
 #include "Modules/timer_handler.h"
 #include "Modules/uart_handler.h"
 #include "Modules/command_parser.h"
+#include "Modules/event_flags.h"
+#include "Modules/clock_profile.h"
+#include "Modules/memory_sections.h"
 #include "Modules/module_wrappers.h"
 /* USER CODE END Includes */
 
@@ -98,12 +102,19 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_TIM2_Init();
+  MX_USART3_UART_Init();
+  MX_TIM8_Init();
   MX_TIM3_Init();
   MX_TIM4_Init();
-  MX_USART3_UART_Init();
+  MX_TIM12_Init();
   /* USER CODE BEGIN 2 */
   // Initialize modules
+  // Caches et profil d'horloge (recalcule timers et UART configurés ci-dessus)
+  CLOCK_Init();
+  EVENT_Init();
+  PROFILE_Init();
   LED_Init();
   PATTERN_Init();
   TIMER_Init();
@@ -124,7 +135,13 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-    COMMAND_Process();
+    // Sommeil (WFI) jusqu'au prochain événement publié par une interruption
+    uint32_t events = EVENT_Wait();
+
+    TIMER_Process();
+    if (events & EVENT_UART_RX) {
+        COMMAND_Process();
+    }
     PATTERN_Process();
   /* USER CODE END WHILE */
 
@@ -200,6 +217,23 @@ void MPU_Config(void)
   MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
   MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
 
+  HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+  /** SRAM2 (DMA buffers, .dma_buffer): normal memory, non-cacheable, so the
+  * D-cache never holds a stale copy of a DMA buffer
+  */
+  MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+  MPU_InitStruct.Number = MPU_REGION_NUMBER1;
+  MPU_InitStruct.BaseAddress = MEMORY_DMA_BASE;
+  MPU_InitStruct.Size = MPU_REGION_SIZE_16KB;
+  MPU_InitStruct.SubRegionDisable = 0x0;
+  MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL1;
+  MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
+  MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+  MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
+  MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+  MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+
   HAL_MPU_ConfigRegion(&MPU_InitStruct);
   /* Enables the MPU */
   HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
@@ -43,6 +43,16 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* load, start and end addresses of the ITCM code and DTCM data, and
+   bounds of the DMA buffers. defined in linker script */
+.word  _siitcm
+.word  _sitcm
+.word  _eitcm
+.word  _sidtcm
+.word  _sdtcm
+.word  _edtcm
+.word  _sdma
+.word  _edma
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -94,6 +104,58 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Copy the hot code from flash to ITCM-RAM */
+  ldr r0, =_sitcm
+  ldr r1, =_eitcm
+  ldr r2, =_siitcm
+  movs r3, #0
+  b LoopCopyItcmInit
+
+CopyItcmInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyItcmInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyItcmInit
+
+/* Copy the hot data initializers from flash to DTCM */
+  ldr r0, =_sdtcm
+  ldr r1, =_edtcm
+  ldr r2, =_sidtcm
+  movs r3, #0
+  b LoopCopyDtcmInit
+
+CopyDtcmInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyDtcmInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyDtcmInit
+
+/* Zero fill the DMA buffers */
+  ldr r2, =_sdma
+  ldr r4, =_edma
+  movs r3, #0
+  b LoopFillZeroDma
+
+FillZeroDma:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroDma:
+  cmp r2, r4
+  bcc FillZeroDma
+
+/* Make the copied code visible to instruction fetches */
+  dsb
+  isb
+
 
 /* Call static constructors */
     bl __libc_init_array
@@ -5,26 +5,47 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Core/Src/Modules/clock_profile.c \
 ../Core/Src/Modules/command_parser.c \
+../Core/Src/Modules/command_timeline.c \
+../Core/Src/Modules/dma_player.c \
+../Core/Src/Modules/event_flags.c \
+../Core/Src/Modules/frame_protocol.c \
 ../Core/Src/Modules/led_controller.c \
 ../Core/Src/Modules/module_wrappers.c \
 ../Core/Src/Modules/pattern_controller.c \
+../Core/Src/Modules/profiler.c \
+../Core/Src/Modules/ring_buffer.c \
 ../Core/Src/Modules/timer_handler.c \
 ../Core/Src/Modules/uart_handler.c 
 
 OBJS += \
+./Core/Src/Modules/clock_profile.o \
 ./Core/Src/Modules/command_parser.o \
+./Core/Src/Modules/command_timeline.o \
+./Core/Src/Modules/dma_player.o \
+./Core/Src/Modules/event_flags.o \
+./Core/Src/Modules/frame_protocol.o \
 ./Core/Src/Modules/led_controller.o \
 ./Core/Src/Modules/module_wrappers.o \
 ./Core/Src/Modules/pattern_controller.o \
+./Core/Src/Modules/profiler.o \
+./Core/Src/Modules/ring_buffer.o \
 ./Core/Src/Modules/timer_handler.o \
 ./Core/Src/Modules/uart_handler.o 
 
 C_DEPS += \
+./Core/Src/Modules/clock_profile.d \
 ./Core/Src/Modules/command_parser.d \
+./Core/Src/Modules/command_timeline.d \
+./Core/Src/Modules/dma_player.d \
+./Core/Src/Modules/event_flags.d \
+./Core/Src/Modules/frame_protocol.d \
 ./Core/Src/Modules/led_controller.d \
 ./Core/Src/Modules/module_wrappers.d \
 ./Core/Src/Modules/pattern_controller.d \
+./Core/Src/Modules/profiler.d \
+./Core/Src/Modules/ring_buffer.d \
 ./Core/Src/Modules/timer_handler.d \
 ./Core/Src/Modules/uart_handler.d 
 
@@ -36,7 +57,7 @@ Core/Src/Modules/%.o Core/Src/Modules/%.su Core/Src/Modules/%.cyclo: ../Core/Src
 clean: clean-Core-2f-Src-2f-Modules
 
 clean-Core-2f-Src-2f-Modules:
-	-$(RM) ./Core/Src/Modules/command_parser.cyclo ./Core/Src/Modules/command_parser.d ./Core/Src/Modules/command_parser.o ./Core/Src/Modules/command_parser.su ./Core/Src/Modules/led_controller.cyclo ./Core/Src/Modules/led_controller.d ./Core/Src/Modules/led_controller.o ./Core/Src/Modules/led_controller.su ./Core/Src/Modules/module_wrappers.cyclo ./Core/Src/Modules/module_wrappers.d ./Core/Src/Modules/module_wrappers.o ./Core/Src/Modules/module_wrappers.su ./Core/Src/Modules/pattern_controller.cyclo ./Core/Src/Modules/pattern_controller.d ./Core/Src/Modules/pattern_controller.o ./Core/Src/Modules/pattern_controller.su ./Core/Src/Modules/timer_handler.cyclo ./Core/Src/Modules/timer_handler.d ./Core/Src/Modules/timer_handler.o ./Core/Src/Modules/timer_handler.su ./Core/Src/Modules/uart_handler.cyclo ./Core/Src/Modules/uart_handler.d ./Core/Src/Modules/uart_handler.o ./Core/Src/Modules/uart_handler.su
+	-$(RM) ./Core/Src/Modules/clock_profile.cyclo ./Core/Src/Modules/clock_profile.d ./Core/Src/Modules/clock_profile.o ./Core/Src/Modules/clock_profile.su ./Core/Src/Modules/command_parser.cyclo ./Core/Src/Modules/command_parser.d ./Core/Src/Modules/command_parser.o ./Core/Src/Modules/command_parser.su ./Core/Src/Modules/command_timeline.cyclo ./Core/Src/Modules/command_timeline.d ./Core/Src/Modules/command_timeline.o ./Core/Src/Modules/command_timeline.su ./Core/Src/Modules/dma_player.cyclo ./Core/Src/Modules/dma_player.d ./Core/Src/Modules/dma_player.o ./Core/Src/Modules/dma_player.su ./Core/Src/Modules/event_flags.cyclo ./Core/Src/Modules/event_flags.d ./Core/Src/Modules/event_flags.o ./Core/Src/Modules/event_flags.su ./Core/Src/Modules/frame_protocol.cyclo ./Core/Src/Modules/frame_protocol.d ./Core/Src/Modules/frame_protocol.o ./Core/Src/Modules/frame_protocol.su ./Core/Src/Modules/led_controller.cyclo ./Core/Src/Modules/led_controller.d ./Core/Src/Modules/led_controller.o ./Core/Src/Modules/led_controller.su ./Core/Src/Modules/module_wrappers.cyclo ./Core/Src/Modules/module_wrappers.d ./Core/Src/Modules/module_wrappers.o ./Core/Src/Modules/module_wrappers.su ./Core/Src/Modules/pattern_controller.cyclo ./Core/Src/Modules/pattern_controller.d ./Core/Src/Modules/pattern_controller.o ./Core/Src/Modules/pattern_controller.su ./Core/Src/Modules/profiler.cyclo ./Core/Src/Modules/profiler.d ./Core/Src/Modules/profiler.o ./Core/Src/Modules/profiler.su ./Core/Src/Modules/ring_buffer.cyclo ./Core/Src/Modules/ring_buffer.d ./Core/Src/Modules/ring_buffer.o ./Core/Src/Modules/ring_buffer.su ./Core/Src/Modules/timer_handler.cyclo ./Core/Src/Modules/timer_handler.d ./Core/Src/Modules/timer_handler.o ./Core/Src/Modules/timer_handler.su ./Core/Src/Modules/uart_handler.cyclo ./Core/Src/Modules/uart_handler.d ./Core/Src/Modules/uart_handler.o ./Core/Src/Modules/uart_handler.su
 
 .PHONY: clean-Core-2f-Src-2f-Modules
 
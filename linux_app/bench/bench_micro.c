@@ -0,0 +1,614 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include "main.h"
+#include "tim.h"
+#include "Modules/command_parser.h"
+#include "Modules/led_controller.h"
+#include "Modules/module_wrappers.h"
+#include "Modules/pattern_controller.h"
+#include "Modules/timer_handler.h"
+#include "../vboard/vboard.h"
+#include "../command_validator.h"
+#include "../special_commands.h"
+
+/**
+ * @file bench_micro.c
+ * @brief Micro-mesures des chemins critiques et contrôle de régression
+ * @author
+ * @date 07-04-2025
+ *
+ * Les modules du firmware sont compilés tels quels avec la HAL de la carte
+ * virtuelle (vboard/hal, horloge à événements discrets) ; les validateurs
+ * de la console sont liés directement. Chaque mesure exécute une opération
+ * sur un corpus réaliste :
+ * - parser.line : une ligne reçue octet par octet (Command_Parser_ProcessChar)
+ *   puis exécutée (Command_Parser_ProcessCommands), réponse comprise ;
+ * - parser.buffer : la même ligne reçue par blocs DMA de plusieurs
+ *   commandes (Command_Parser_ProcessBuffer) ;
+ * - pattern.step : un tick de TIM2, Timer_Process et l'étape d'un
+ *   chenillard de période 1 ms (Pattern_Controller_Update) ;
+ * - led.state, led.mask, led.level : écriture d'une LED, du masque des
+ *   trois LED, d'une luminosité (PWM) ;
+ * - host.validate, host.special : Command_Validate et
+ *   Special_IsSpecialCommand sur des saisies de la console.
+ * Le coût d'une opération (ns) est la médiane de BENCH_REPEATS séries
+ * d'au moins BENCH_MIN_NS ; les appels à malloc, calloc et realloc du code
+ * mesuré sont comptés sur toutes les séries (pas les allocations internes
+ * de la glibc, strdup par exemple). Les registres émulés (GPIOB, fin des
+ * transferts DMA de l'UART) sont inclus dans les mesures : elles servent à
+ * comparer deux versions du code sur le même hôte, pas à estimer les
+ * durées sur la carte.
+ *
+ * Les résultats sont écrits en JSON. Avec -b, ils sont comparés à une
+ * référence enregistrée : le programme échoue si une mesure dépasse la
+ * référence de plus du seuil (-t, en %) et d'au moins BENCH_NOISE_NS, ou
+ * si elle alloue davantage. Un calcul fixe (mesure "reference") met la
+ * référence à l'échelle de l'hôte du moment : la comparaison tolère les
+ * écarts de fréquence entre deux exécutions. L'écart absolu minimal évite
+ * d'échouer sur la gigue des opérations de quelques dizaines de ns, où
+ * quelques ns dépassent déjà le seuil relatif.
+ */
+
+#define BENCH_MIN_NS        20000000ull     // Durée minimale d'une série
+#define BENCH_REPEATS       9               // Séries par mesure (médiane retenue)
+#define BENCH_THRESHOLD     30.0            // Seuil de régression par défaut (%)
+#define BENCH_NOISE_NS      20.0            // Hausse minimale d'une régression (ns/op)
+#define BENCH_NAME_MAX      32
+#define BENCH_LINE_MAX      128
+
+/* Calcul fixe indépendant du code mesuré : ses variations d'une exécution
+ * à l'autre sont celles de l'hôte (fréquence, charge) */
+#define BENCH_REFERENCE     "reference"
+#define BENCH_REFERENCE_OPS 64
+#define BENCH_REFERENCE_TABLE 256
+
+/* Commandes reçues par le firmware (une ligne par opération) */
+static const char *FIRMWARE_CORPUS[] = {
+    "LED1 ON", "LED2 OFF", "LED3 ON", "LEDS 101", "DIM2 128", "FADE3 255 1000",
+    "PAT3", "FREQ 750", "PATFADE ON", "STOP", "STATUS", "STATS", "PROFILE",
+    "LOAD", "#42 LED1 ON", "PATDEF4 1247", "PAT4", "FREQ2", "PATFADE OFF",
+    "CLOCK", "LED4 ON", "BONJOUR", "LED"
+};
+#define FIRMWARE_CORPUS_SIZE (sizeof(FIRMWARE_CORPUS) / sizeof(FIRMWARE_CORPUS[0]))
+
+/* Saisies de la console (validation avant envoi) */
+static const char *HOST_CORPUS[] = {
+    "led1 on", "LED2 OFF", "led3 blink", "LEDS 101", "pat3", "FREQ 750",
+    "dim2 128", "fade3 255 1000", "PATDEF4 1247", "status", "stats", "help",
+    "clear", "quit", "HELP", "stop", "patlist", "clock balanced", "bonjour",
+    "led9 on"
+};
+#define HOST_CORPUS_SIZE (sizeof(HOST_CORPUS) / sizeof(HOST_CORPUS[0]))
+
+/* Commandes d'un bloc DMA (la file du parseur en garde DEPTH - 1) */
+#define BENCH_BLOCK_LINES   (COMMAND_QUEUE_DEPTH - 1)
+
+/* Une mesure */
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(uint32_t count);    // count opérations
+} Micro_Bench;
+
+/* Résultat d'une mesure (et d'une entrée de la référence) */
+typedef struct {
+    char name[BENCH_NAME_MAX];
+    double nsPerOp;
+    double allocsPerOp;
+} Micro_Result;
+
+/* Allocations de la glibc, appelées par les remplacements ci-dessous */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+/* Initialisation de l'UART (uart_handler.c, déclarée comme dans main.c) */
+bool UART_Init(void);
+
+/* Variables privées */
+static volatile uint64_t allocations = 0;
+static volatile uint32_t sink = 0;          // Résultats consommés (non éliminés)
+static uint32_t corpusIndex = 0;
+static uint32_t ledIndex = 0;
+static char stream[2 * FIRMWARE_CORPUS_SIZE * (COMMAND_BUFFER_SIZE + 1)];
+static size_t streamOffsets[2 * FIRMWARE_CORPUS_SIZE + 1];
+static volatile uint32_t referenceTable[BENCH_REFERENCE_TABLE];
+
+/* Prototypes de fonctions privées */
+static void usage(const char *program);
+static uint64_t Bench_Ns(void);
+static void Bench_Measure(Micro_Result *results);
+static int Bench_CompareNs(const void *a, const void *b);
+static bool Bench_Write(const char *path, const Micro_Result *results, size_t count);
+static int Bench_LoadBaseline(const char *path, Micro_Result *baseline, size_t capacity);
+static const Micro_Result *Bench_Find(const Micro_Result *entries, size_t count, const char *name);
+static bool Bench_Compare(const Micro_Result *results, size_t count,
+                          const Micro_Result *baseline, int baselineCount, double threshold);
+static void Bench_ResetCorpus(void);
+static uint32_t Bench_ReferenceStep(uint32_t state);
+static void Bench_Reference(uint32_t count);
+static uint32_t (*volatile referenceStep)(uint32_t) = Bench_ReferenceStep;
+static void Bench_StopPattern(void);
+static void Bench_StartPattern(void);
+static void Bench_ParserLine(uint32_t count);
+static void Bench_ParserBuffer(uint32_t count);
+static void Bench_PatternStep(uint32_t count);
+static void Bench_LedState(uint32_t count);
+static void Bench_LedMask(uint32_t count);
+static void Bench_LedLevel(uint32_t count);
+static void Bench_HostValidate(uint32_t count);
+static void Bench_HostSpecial(uint32_t count);
+
+/* Mesures, dans l'ordre d'exécution */
+static const Micro_Bench BENCHES[] = {
+    { BENCH_REFERENCE, Bench_ResetCorpus,  Bench_Reference },
+    { "led.state",     Bench_StopPattern,  Bench_LedState },
+    { "led.mask",      Bench_StopPattern,  Bench_LedMask },
+    { "led.level",     Bench_StopPattern,  Bench_LedLevel },
+    { "parser.line",   Bench_ResetCorpus,  Bench_ParserLine },
+    { "parser.buffer", Bench_ResetCorpus,  Bench_ParserBuffer },
+    { "pattern.step",  Bench_StartPattern, Bench_PatternStep },
+    { "host.validate", Bench_ResetCorpus,  Bench_HostValidate },
+    { "host.special",  Bench_ResetCorpus,  Bench_HostSpecial },
+};
+#define BENCH_COUNT (sizeof(BENCHES) / sizeof(BENCHES[0]))
+
+/* Remplacements des allocations : comptage ------------------------------------*/
+void *malloc(size_t size)
+{
+    allocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+/* Affichage de la console, inutilisé par Special_IsSpecialCommand */
+void UI_DisplayHelp(void) { }
+void UI_ClearScreen(void) { }
+
+/**
+ * @brief Point d'entrée du banc
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return EXIT_FAILURE en cas de régression ou d'erreur
+ */
+int main(int argc, char *argv[])
+{
+    Micro_Result results[BENCH_COUNT];
+    Micro_Result baseline[BENCH_COUNT * 2];
+    const char *outputPath = NULL;
+    const char *baselinePath = NULL;
+    double threshold = BENCH_THRESHOLD;
+    int option;
+
+    while ((option = getopt(argc, argv, "o:b:t:h")) != -1) {
+        switch (option) {
+            case 'o':
+                outputPath = optarg;
+                break;
+            case 'b':
+                baselinePath = optarg;
+                break;
+            case 't':
+                threshold = atof(optarg);
+                if (threshold <= 0.0) {
+                    fprintf(stderr, "Erreur: seuil invalide\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    /* Corpus du firmware, deux fois de suite : un bloc de
+     * BENCH_BLOCK_LINES lignes est contigu quelle que soit sa première */
+    size_t length = 0;
+    for (size_t i = 0; i < 2 * FIRMWARE_CORPUS_SIZE; i++) {
+        const char *command = FIRMWARE_CORPUS[i % FIRMWARE_CORPUS_SIZE];
+        streamOffsets[i] = length;
+        length += (size_t)sprintf(stream + length, "%s\r", command);
+    }
+    streamOffsets[2 * FIRMWARE_CORPUS_SIZE] = length;
+
+    /* Même séquence que main.c, sur l'horloge à événements discrets ; les
+     * réponses ne sont écrites nulle part */
+    Vboard_ClockSelect(VBOARD_CLOCK_DISCRETE, 1);
+    Vboard_Init(-1, -1, false);
+    CLOCK_Init();
+    EVENT_Init();
+    PROFILE_Init();
+    LED_Init();
+    PATTERN_Init();
+    TIMER_Init();
+    if (!UART_Init()) {
+        fprintf(stderr, "Erreur: initialisation de l'UART\n");
+        return EXIT_FAILURE;
+    }
+    COMMAND_Init();
+    Command_Init();
+    Special_Init();
+
+    Bench_Measure(results);
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        fprintf(stderr, "%-16s %10.1f ns/op %6.2f alloc/op\n",
+                results[i].name, results[i].nsPerOp, results[i].allocsPerOp);
+    }
+
+    if (!Bench_Write(outputPath, results, BENCH_COUNT)) {
+        return EXIT_FAILURE;
+    }
+
+    if (baselinePath != NULL) {
+        int baselineCount = Bench_LoadBaseline(baselinePath, baseline,
+                                               sizeof(baseline) / sizeof(baseline[0]));
+        if (baselineCount < 0) {
+            fprintf(stderr, "Erreur: reference %s illisible (make benchbaseline)\n", baselinePath);
+            return EXIT_FAILURE;
+        }
+        if (!Bench_Compare(results, BENCH_COUNT, baseline, baselineCount, threshold)) {
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Affichage de l'aide de la ligne de commande
+ * @param program Nom du programme
+ */
+static void usage(const char *program)
+{
+    printf("Usage: %s [-o resultats.json] [-b reference.json] [-t seuil]\n", program);
+    printf("  -o fichier : resultats JSON (sortie standard par defaut)\n");
+    printf("  -b fichier : reference ; echec si une mesure regresse\n");
+    printf("  -t seuil   : hausse toleree du temps par operation (%%, %.0f par defaut)\n", BENCH_THRESHOLD);
+}
+
+/**
+ * @brief Temps monotone
+ * @return Nanosecondes
+ */
+static uint64_t Bench_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Exécution des mesures
+ * @note Le nombre d'opérations d'une série est d'abord doublé, pour chaque
+ *       mesure, jusqu'à durer BENCH_MIN_NS (mise en route comprise). Les
+ *       BENCH_REPEATS séries passent ensuite d'une mesure à l'autre : un
+ *       ralentissement passager de l'hôte ne pénalise pas une seule mesure.
+ *       La médiane des séries écarte aussi bien une série ralentie qu'une
+ *       série exceptionnellement rapide (fréquence plus haute un instant).
+ * @param results Temps (série médiane) et allocations par opération
+ */
+static void Bench_Measure(Micro_Result *results)
+{
+    uint32_t counts[BENCH_COUNT];
+    uint64_t allocated[BENCH_COUNT] = { 0 };
+    double samples[BENCH_COUNT][BENCH_REPEATS];
+
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        counts[i] = 64;
+        BENCHES[i].setup();
+        for (;;) {
+            uint64_t start = Bench_Ns();
+            BENCHES[i].run(counts[i]);
+            if (Bench_Ns() - start >= BENCH_MIN_NS || counts[i] >= (1u << 30)) {
+                break;
+            }
+            counts[i] *= 2;
+        }
+    }
+
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        for (size_t i = 0; i < BENCH_COUNT; i++) {
+            BENCHES[i].setup();
+
+            uint64_t before = allocations;
+            uint64_t start = Bench_Ns();
+            BENCHES[i].run(counts[i]);
+            double ns = (double)(Bench_Ns() - start) / counts[i];
+
+            allocated[i] += allocations - before;
+            samples[i][repeat] = ns;
+        }
+    }
+
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        qsort(samples[i], BENCH_REPEATS, sizeof(samples[i][0]), Bench_CompareNs);
+        results[i].nsPerOp = samples[i][BENCH_REPEATS / 2];
+        snprintf(results[i].name, sizeof(results[i].name), "%s", BENCHES[i].name);
+        results[i].allocsPerOp = (double)allocated[i] / ((double)counts[i] * BENCH_REPEATS);
+    }
+}
+
+/**
+ * @brief Ordre croissant de deux durées (qsort)
+ */
+static int Bench_CompareNs(const void *a, const void *b)
+{
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+
+    return (left > right) - (left < right);
+}
+
+/**
+ * @brief Écriture des résultats en JSON (une mesure par ligne)
+ * @param path Fichier (NULL : sortie standard)
+ * @param results Résultats
+ * @param count Nombre de résultats
+ * @return false en cas d'erreur d'écriture
+ */
+static bool Bench_Write(const char *path, const Micro_Result *results, size_t count)
+{
+    FILE *file = (path != NULL) ? fopen(path, "w") : stdout;
+
+    if (file == NULL) {
+        perror("Erreur ecriture des resultats");
+        return false;
+    }
+
+    fprintf(file, "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(file, "    { \"name\": \"%s\", \"ns_per_op\": %.1f, \"allocs_per_op\": %.2f }%s\n",
+                results[i].name, results[i].nsPerOp, results[i].allocsPerOp,
+                (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    bool ok = !ferror(file);
+    if (file != stdout) {
+        ok = (fclose(file) == 0) && ok;
+    }
+    return ok;
+}
+
+/**
+ * @brief Lecture d'une référence écrite par Bench_Write
+ * @param path Fichier
+ * @param baseline Entrées lues
+ * @param capacity Nombre maximal d'entrées
+ * @return Nombre d'entrées, -1 si le fichier est illisible
+ */
+static int Bench_LoadBaseline(const char *path, Micro_Result *baseline, size_t capacity)
+{
+    char line[BENCH_LINE_MAX];
+    FILE *file = fopen(path, "r");
+    int count = 0;
+
+    if (file == NULL) {
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL && (size_t)count < capacity) {
+        Micro_Result *entry = &baseline[count];
+        const char *start = strstr(line, "\"name\"");
+
+        if (start != NULL &&
+            sscanf(start, "\"name\": \"%31[^\"]\", \"ns_per_op\": %lf, \"allocs_per_op\": %lf",
+                   entry->name, &entry->nsPerOp, &entry->allocsPerOp) == 3) {
+            count++;
+        }
+    }
+
+    fclose(file);
+    return count;
+}
+
+/**
+ * @brief Recherche d'une mesure par son nom
+ * @return Entrée trouvée, NULL si absente
+ */
+static const Micro_Result *Bench_Find(const Micro_Result *entries, size_t count, const char *name)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Comparaison des résultats à la référence
+ * @note Les temps de la référence sont d'abord mis à l'échelle de l'hôte
+ *       (rapport des mesures BENCH_REFERENCE), puis chaque mesure est
+ *       comparée au seuil ; une hausse de moins de BENCH_NOISE_NS n'est
+ *       jamais une régression. Une mesure absente de la référence est signalée
+ *       sans échec.
+ * @param results Résultats
+ * @param count Nombre de résultats
+ * @param baseline Référence
+ * @param baselineCount Nombre d'entrées de la référence
+ * @param threshold Hausse tolérée du temps par opération (%)
+ * @return false si au moins une mesure régresse
+ */
+static bool Bench_Compare(const Micro_Result *results, size_t count,
+                          const Micro_Result *baseline, int baselineCount, double threshold)
+{
+    const Micro_Result *hostNow = Bench_Find(results, count, BENCH_REFERENCE);
+    const Micro_Result *hostThen = Bench_Find(baseline, (size_t)baselineCount, BENCH_REFERENCE);
+    double scale = 1.0;
+    bool ok = true;
+
+    if (hostNow != NULL && hostThen != NULL && hostThen->nsPerOp > 0.0) {
+        scale = hostNow->nsPerOp / hostThen->nsPerOp;
+    }
+    fprintf(stderr, "Comparaison a la reference (seuil %.0f %%, hote x%.2f)\n", threshold, scale);
+
+    for (size_t i = 0; i < count; i++) {
+        const Micro_Result *reference = Bench_Find(baseline, (size_t)baselineCount, results[i].name);
+
+        if (strcmp(results[i].name, BENCH_REFERENCE) == 0) {
+            continue;
+        }
+        if (reference == NULL) {
+            fprintf(stderr, "%-16s absente de la reference\n", results[i].name);
+            continue;
+        }
+
+        double expected = reference->nsPerOp * scale;
+        double change = (expected > 0.0) ? 100.0 * (results[i].nsPerOp - expected) / expected : 0.0;
+        bool slower = change > threshold && results[i].nsPerOp - expected > BENCH_NOISE_NS;
+        bool allocates = results[i].allocsPerOp > reference->allocsPerOp + 0.005;
+
+        fprintf(stderr, "%-16s %+7.1f %%%s%s\n", results[i].name, change,
+                slower ? "  REGRESSION (temps)" : "",
+                allocates ? "  REGRESSION (allocations)" : "");
+        ok = ok && !slower && !allocates;
+    }
+    return ok;
+}
+
+/**
+ * @brief Mesures sur corpus : reprise à la première entrée
+ */
+static void Bench_ResetCorpus(void)
+{
+    corpusIndex = 0;
+}
+
+/**
+ * @brief Mesures des LED : aucun chenillard ne les pilote
+ */
+static void Bench_StopPattern(void)
+{
+    Pattern_Stop();
+    ledIndex = 0;
+}
+
+/**
+ * @brief Chenillard 1 de période 1 ms, sans fondu : une étape par tick
+ */
+static void Bench_StartPattern(void)
+{
+    Pattern_SetFade(false);
+    Pattern_SetPeriod(PATTERN_PERIOD_MIN_MS);
+    Pattern_Start(PATTERN_1);
+}
+
+/**
+ * @brief Pas du calcul de référence : appel indirect, xorshift et écriture
+ *        en mémoire, comme les accès aux registres des modules mesurés
+ */
+static uint32_t Bench_ReferenceStep(uint32_t state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    referenceTable[state & (BENCH_REFERENCE_TABLE - 1)] = state;
+    return state;
+}
+
+/**
+ * @brief Mesure de référence
+ */
+static void Bench_Reference(uint32_t count)
+{
+    uint32_t state = sink | 1u;
+
+    for (uint32_t i = 0; i < count; i++) {
+        for (int j = 0; j < BENCH_REFERENCE_OPS; j++) {
+            state = referenceStep(state);
+        }
+    }
+    sink = state;
+}
+
+static void Bench_ParserLine(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        const char *command = FIRMWARE_CORPUS[corpusIndex];
+
+        while (*command != '\0') {
+            Command_Parser_ProcessChar(*command++);
+        }
+        Command_Parser_ProcessChar('\r');
+        Command_Parser_ProcessCommands();
+        corpusIndex = (corpusIndex + 1) % FIRMWARE_CORPUS_SIZE;
+    }
+}
+
+static void Bench_ParserBuffer(uint32_t count)
+{
+    while (count > 0) {
+        uint32_t lines = (count < BENCH_BLOCK_LINES) ? count : BENCH_BLOCK_LINES;
+        size_t first = streamOffsets[corpusIndex];
+        size_t last = streamOffsets[corpusIndex + lines];
+
+        Command_Parser_ProcessBuffer((const uint8_t *)stream + first, (uint16_t)(last - first));
+        Command_Parser_ProcessCommands();
+        corpusIndex = (corpusIndex + lines) % FIRMWARE_CORPUS_SIZE;
+        count -= lines;
+    }
+}
+
+static void Bench_PatternStep(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        HAL_TIM_PeriodElapsedCallback(&htim2);
+        Timer_Process();
+        Pattern_Controller_Update();
+    }
+}
+
+static void Bench_LedState(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++, ledIndex++) {
+        LED_SetState((uint8_t)(ledIndex % LED_COUNT + 1), ((ledIndex / LED_COUNT) & 1) ? LED_ON : LED_OFF);
+    }
+}
+
+static void Bench_LedMask(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++, ledIndex++) {
+        LED_SetMask(ledIndex & LED_MASK_ALL);
+    }
+}
+
+static void Bench_LedLevel(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++, ledIndex++) {
+        LED_SetLevel((uint8_t)(ledIndex % LED_COUNT + 1), (uint8_t)ledIndex);
+    }
+}
+
+static void Bench_HostValidate(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        sink += Command_Validate(HOST_CORPUS[corpusIndex]);
+        corpusIndex = (corpusIndex + 1) % HOST_CORPUS_SIZE;
+    }
+}
+
+static void Bench_HostSpecial(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        sink += Special_IsSpecialCommand(HOST_CORPUS[corpusIndex]);
+        corpusIndex = (corpusIndex + 1) % HOST_CORPUS_SIZE;
+    }
+}
@@ -0,0 +1,252 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/* Le module du firmware est inclus directement pour accéder à ses fonctions
+ * privées (analyse à la réception et file des commandes). */
+#include "Modules/led_controller.h"
+#include "Modules/pattern_controller.h"
+#include "../../STM32F756ZG_Serial_Communication/Core/Src/Modules/command_parser.c"
+
+/**
+ * @file bench_parser.c
+ * @brief Mesure du coût d'analyse des commandes par le parseur du firmware
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce programme compile command_parser.c sur l'hôte (les LED, chenillards et
+ * l'UART sont remplacés par des fonctions vides) et mesure, pour chaque
+ * commande d'un corpus :
+ * - l'analyse de la ligne octet par octet jusqu'au '\r' (mot-clé recherché
+ *   dans la table, arguments convertis) ;
+ * - le traitement complet d'une ligne (réception, exécution, réponse).
+ * Le corpus par défaut couvre toutes les commandes ; un fichier d'une
+ * commande par ligne peut être passé en argument.
+ * Les mesures sont en cycles du compteur TSC sur x86, en nanosecondes
+ * ailleurs.
+ */
+
+#define BENCH_ITERATIONS 200000
+#define BENCH_MAX_CORPUS 64
+
+/* Corpus par défaut */
+static const char *DEFAULT_CORPUS[] = {
+    "LED1 ON", "LED2 OFF", "LED3 ON", "LED4 ON", "LED1 BLINK", "LEDS 101",
+    "CHENILLARD1 ON", "CHENILLARD FREQUENCE2", "PAT3", "PATDEF4 1247", "PATPROG5 0 0A000007", "AT +500 LED1 ON", "FREQ1",
+    "FREQ 750", "PLAYBACK DMA", "DIM2 128", "FADE3 255 1000", "PATFADE ON", "LOAD", "CLOCK", "PROFILE", "STATS", "STOP", "STATUS", "#42 LED1 ON", "BONJOUR", "LED"
+};
+#define DEFAULT_CORPUS_SIZE (sizeof(DEFAULT_CORPUS) / sizeof(DEFAULT_CORPUS[0]))
+
+/* Variables privées */
+static size_t uartBytes = 0;        // Octets "émis" par le parseur
+static LED_State ledStates[LED_COUNT + 1];
+
+/* Remplacements des modules matériels ---------------------------------------*/
+void UART_SendString(const char *str) { uartBytes += strlen(str); }
+void UART_SendFrame(uint8_t opcode, const uint8_t *payload, uint8_t length) { (void)opcode; (void)payload; uartBytes += length + FRAME_OVERHEAD; }
+void UART_GetTxStats(UART_TxStats *stats) { memset(stats, 0, sizeof(*stats)); }
+void UART_GetRxStats(UART_RxStats *stats) { memset(stats, 0, sizeof(*stats)); }
+uint32_t Timer_GetTicks(void) { return 0; }
+uint32_t Pattern_GetMissedSteps(void) { return 0; }
+void Timeline_Init(Timeline_Handler handler) { (void)handler; }
+bool Timeline_Add(uint32_t due, bool held, const char *command) { (void)due; (void)held; (void)command; return true; }
+uint8_t Timeline_Go(void) { return 0; }
+void Timeline_Clear(void) { }
+uint8_t Timeline_GetCount(void) { return 0; }
+uint8_t Timeline_GetHeldCount(void) { return 0; }
+bool Timeline_GetNext(uint32_t *due) { (void)due; return false; }
+void Timeline_GetStats(Timeline_Stats *stats) { memset(stats, 0, sizeof(*stats)); }
+bool UART_HasOverflow(void) { return false; }
+void Event_GetStats(Event_Stats *stats) { memset(stats, 0, sizeof(*stats)); }
+void Event_ResetStats(void) { }
+static const Clock_ProfileInfo clockInfo = { "LOW", 16000000u, 16000000u, 16000000u, 0, 3, false };
+Clock_Profile Clock_GetProfile(void) { return CLOCK_PROFILE_LOW; }
+const Clock_ProfileInfo* Clock_GetInfo(Clock_Profile profile) { (void)profile; return &clockInfo; }
+bool Clock_FindProfile(const char *name, Clock_Profile *profile) { *profile = CLOCK_PROFILE_LOW; return strcmp(name, clockInfo.name) == 0; }
+bool Clock_SetProfile(Clock_Profile profile) { return profile == CLOCK_PROFILE_LOW; }
+uint32_t Clock_GetAccelerators(void) { return 0; }
+bool Clock_Benchmark(Clock_Workload workload, uint32_t lineLength, Clock_BenchResult results[CLOCK_PROFILE_COUNT]) { (void)workload; (void)lineLength; (void)results; return false; }
+void Profile_Record(Profile_Probe probe, uint32_t cycles) { (void)probe; (void)cycles; }
+void Profile_GetStats(Profile_Probe probe, Profile_Stats *stats) { (void)probe; memset(stats, 0, sizeof(*stats)); }
+const char *Profile_GetName(Profile_Probe probe) { (void)probe; return "sonde"; }
+uint32_t Profile_GetOverhead(void) { return 0; }
+void Profile_Reset(void) { }
+bool LED_SetState(uint8_t ledNumber, LED_State state) { ledStates[ledNumber] = state; return true; }
+LED_State LED_GetState(uint8_t ledNumber) { return ledStates[ledNumber]; }
+bool LED_IsValidNumber(uint8_t ledNumber) { return ledNumber >= 1 && ledNumber <= LED_COUNT; }
+bool LED_SetMask(uint32_t mask) { for (uint8_t i = 1; i <= LED_COUNT; i++) ledStates[i] = (mask & LED_MASK(i)) ? LED_ON : LED_OFF; return true; }
+bool LED_SetLevel(uint8_t ledNumber, uint8_t level) { ledStates[ledNumber] = level ? LED_ON : LED_OFF; return true; }
+uint8_t LED_GetLevel(uint8_t ledNumber) { return ledStates[ledNumber] == LED_ON ? LED_LEVEL_MAX : 0; }
+bool LED_Fade(uint8_t ledNumber, uint8_t level, uint32_t durationMs) { (void)durationMs; return LED_SetLevel(ledNumber, level); }
+bool Pattern_Start(Pattern_Type pattern) { (void)pattern; return true; }
+bool Pattern_Stop(void) { return true; }
+bool Pattern_SetFrequency(Pattern_Frequency freq) { (void)freq; return true; }
+Pattern_Type Pattern_GetActive(void) { return PATTERN_NONE; }
+Pattern_Frequency Pattern_GetFrequency(void) { return PATTERN_FREQ_1S; }
+bool Pattern_SetPeriod(uint32_t periodMs) { (void)periodMs; return true; }
+uint32_t Pattern_GetPeriod(void) { return 1000; }
+bool Pattern_SetPlayback(Pattern_Playback mode) { (void)mode; return true; }
+Pattern_Playback Pattern_GetPlayback(void) { return PATTERN_PLAYBACK_CPU; }
+void Pattern_SetFade(bool enabled) { (void)enabled; }
+bool Pattern_GetFade(void) { return false; }
+uint8_t Pattern_GetCount(void) { return PATTERN_BUILTIN_COUNT + PATTERN_USER_SLOTS; }
+bool Pattern_GetDefinition(uint8_t pattern, Pattern_Definition *definition)
+{
+    static const uint8_t steps[] = { 1, 2, 4 };
+    definition->name = "SEQUENTIEL";
+    definition->steps = steps;
+    definition->length = sizeof(steps);
+    definition->code = NULL;
+    definition->codeLength = 0;
+    return pattern >= 1 && pattern <= Pattern_GetCount();
+}
+bool Pattern_Define(uint8_t pattern, const uint8_t *steps, uint8_t length) { (void)pattern; (void)steps; (void)length; return true; }
+bool Pattern_DefineProgram(uint8_t pattern, const uint8_t *code, uint8_t length) { (void)pattern; (void)code; (void)length; return true; }
+uint32_t Pattern_GetProgramFaults(void) { return 0; }
+
+/**
+ * @brief Lecture du compteur de temps (cycles TSC ou nanosecondes)
+ */
+static inline unsigned long long Bench_Ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Coût moyen de l'analyse d'une ligne à la réception
+ * @note  Les octets passent par l'analyseur au fil de l'eau jusqu'au '\r' ;
+ *        la commande analysée est ensuite retirée de la file sans être
+ *        exécutée.
+ * @param command Commande (en majuscules)
+ * @return Ticks par commande
+ */
+static double Bench_Dispatch(const char *command)
+{
+    char line[COMMAND_BUFFER_SIZE + 1];
+    size_t length = strlen(command);
+
+    memcpy(line, command, length);
+    line[length++] = '\r';
+
+    unsigned long long start = Bench_Ticks();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        Command_Parser_ProcessBuffer((const uint8_t *)line, (uint16_t)length);
+        queueTail = queueHead;
+    }
+    unsigned long long end = Bench_Ticks();
+
+    return (double)(end - start) / BENCH_ITERATIONS;
+}
+
+/**
+ * @brief Coût moyen du traitement complet d'une ligne
+ * @param command Commande (en majuscules)
+ * @return Ticks par commande
+ */
+static double Bench_Full(const char *command)
+{
+    char line[COMMAND_BUFFER_SIZE + 1];
+    size_t length = strlen(command);
+
+    memcpy(line, command, length);
+    line[length++] = '\r';
+
+    unsigned long long start = Bench_Ticks();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        Command_Parser_ProcessBuffer((const uint8_t *)line, (uint16_t)length);
+        Command_Parser_ProcessCommands();
+    }
+    unsigned long long end = Bench_Ticks();
+
+    return (double)(end - start) / BENCH_ITERATIONS;
+}
+
+/**
+ * @brief Chargement d'un corpus (une commande par ligne)
+ * @param path Fichier à lire
+ * @param corpus Tableau de sortie (chaînes allouées)
+ * @return Nombre de commandes lues, -1 en cas d'erreur
+ */
+static int Bench_LoadCorpus(const char *path, char **corpus)
+{
+    FILE *file = fopen(path, "r");
+    char buffer[COMMAND_BUFFER_SIZE];
+    int count = 0;
+
+    if (file == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (count < BENCH_MAX_CORPUS && fgets(buffer, sizeof(buffer), file) != NULL) {
+        buffer[strcspn(buffer, "\r\n")] = '\0';
+        if (buffer[0] == '\0') {
+            continue;
+        }
+        for (char *p = buffer; *p; p++) {
+            *p = (char)toupper((unsigned char)*p);
+        }
+        corpus[count++] = strdup(buffer);
+    }
+
+    fclose(file);
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    char *loaded[BENCH_MAX_CORPUS];
+    const char **corpus = DEFAULT_CORPUS;
+    int count = (int)DEFAULT_CORPUS_SIZE;
+    double dispatchTotal = 0.0;
+    double fullTotal = 0.0;
+
+    if (argc > 1) {
+        count = Bench_LoadCorpus(argv[1], loaded);
+        if (count <= 0) {
+            fprintf(stderr, "Corpus vide ou illisible: %s\n", argv[1]);
+            return 1;
+        }
+        corpus = (const char **)loaded;
+    }
+
+    Command_Parser_Init();
+
+#if defined(__x86_64__) || defined(__i386__)
+    const char *unit = "cycles";
+#else
+    const char *unit = "ns";
+#endif
+    printf("Parseur de commandes du firmware (%d iterations, %s par commande)\n",
+           BENCH_ITERATIONS, unit);
+    printf("%-26s %12s %12s\n", "commande", "analyse", "complet");
+
+    for (int i = 0; i < count; i++) {
+        double dispatch = Bench_Dispatch(corpus[i]);
+        double full = Bench_Full(corpus[i]);
+        dispatchTotal += dispatch;
+        fullTotal += full;
+        printf("%-26s %12.1f %12.1f\n", corpus[i], dispatch, full);
+    }
+
+    printf("%-26s %12.1f %12.1f\n", "moyenne", dispatchTotal / count, fullTotal / count);
+
+    if (corpus != DEFAULT_CORPUS) {
+        for (int i = 0; i < count; i++) {
+            free(loaded[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,437 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <sys/mman.h>
+#include "../serial_handler.h"
+#include "../command_pipeline.h"
+
+/**
+ * @file bench_protocol.c
+ * @brief Mesure du débit de commandes : heuristique de silence contre réponses tramées
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce programme crée un pseudo-terminal et lance, dans un processus fils, une
+ * carte émulée qui répond aux commandes comme le firmware (latence USB-CDC
+ * et débit de la liaison à 115200 bauds simulés). Le processus père envoie ensuite une série
+ * de commandes avec :
+ * - l'ancienne méthode : fin de réponse après 50 ms de silence ;
+ * - la méthode tramée : fin de réponse sur le marqueur [END] ;
+ * - le pipeline : commandes numérotées, PIPELINE_WINDOW_MAX en vol ;
+ * - le mode binaire : mêmes commandes en trames (Serial_SendFrame et
+ *   Serial_ReceiveFrame), une à la fois.
+ * Le nombre de commandes traitées par seconde et l'occupation de la liaison
+ * descendante (carte vers hôte) sont affichés pour chacune.
+ */
+
+#define BYTE_TIME_US 87             // Durée d'un octet 8N1 à 115200 bauds
+#define LEGACY_SILENCE_MS 50        // Heuristique de l'ancienne réception
+#define LEGACY_COMMANDS 40
+#define FRAMED_COMMANDS 400
+#define PIPELINED_COMMANDS 400
+#define BINARY_COMMANDS 400
+#define LINK_LATENCY_US 1000        // Latence d'une trame USB-CDC
+#define BOARD_MAX_PENDING 16        // Réponses en cours de transmission
+
+/* Modes de réception mesurés */
+typedef enum {
+    MODE_LEGACY = 0,    // Fin de réponse sur 50 ms de silence
+    MODE_FRAMED,        // Fin de réponse sur [END]
+    MODE_PIPELINED,     // Commandes numérotées en pipeline
+    MODE_BINARY         // Trames binaires
+} BenchMode;
+
+/* Commandes envoyées en boucle pendant la mesure */
+static const char *COMMANDS[] = { "LED1 ON", "LED1 OFF", "STATUS", "FREQ2" };
+#define COMMAND_COUNT (sizeof(COMMANDS) / sizeof(COMMANDS[0]))
+
+/* Équivalent binaire de chaque commande de COMMANDS */
+typedef struct {
+    uint8_t opcode;
+    uint8_t payload[2];
+    size_t length;
+} BenchFrame;
+
+static const BenchFrame FRAMES[] = {
+    { SERIAL_OP_LED, { 1, 1 }, 2 },
+    { SERIAL_OP_LED, { 1, 0 }, 2 },
+    { SERIAL_OP_STATUS, { 0 }, 0 },
+    { SERIAL_OP_FREQ, { 2 }, 1 }
+};
+
+/* Réponse de la carte émulée en attente de transmission */
+typedef struct {
+    char text[256];
+    size_t length;      // Octets à émettre (les trames contiennent des zéros)
+    double deliverAt;   // Instant de fin de transmission du dernier octet
+} PendingReply;
+
+/* Variables privées */
+static size_t *boardBytes = NULL;   // Octets émis par la carte (mémoire partagée)
+static int completedReplies = 0;    // Réponses complètes (mode pipeline)
+
+/**
+ * @brief Temps monotone courant en secondes
+ */
+static double Bench_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Construction de la réponse de la carte émulée à une commande
+ * @param command Commande reçue (avec son éventuel préfixe "#n ")
+ * @param mode Mode mesuré (format des réponses)
+ * @param reply Buffer de sortie
+ * @param size Taille du buffer
+ */
+static void Board_FormatReply(const char *command, BenchMode mode, char *reply, size_t size)
+{
+    // Préfixe "#n " : balises numérotées et pas de prompt, comme le firmware
+    char tag[16] = "";
+    const char *text = command;
+    const char *prompt = "STM32> ";
+    if (command[0] == '#') {
+        const char *space = strchr(command, ' ');
+        if (space != NULL) {
+            snprintf(tag, sizeof(tag), "#%.*s", (int)(space - command - 1), command + 1);
+            text = space + 1;
+            prompt = "";
+        }
+    }
+    char end[24] = "";
+    if (mode != MODE_LEGACY) {
+        snprintf(end, sizeof(end), "[END%s]\r\n", tag);
+    }
+
+    if (strcmp(text, "STATUS") == 0) {
+        snprintf(reply, size,
+                 "--- Statut ---\r\nLED 1: OFF\r\nLED 2: OFF\r\nLED 3: OFF\r\n"
+                 "Chenillard: INACTIF (Freq select: 1S, Lecture: CPU, Fondu: OFF)\r\n%s%s", end, prompt);
+    } else {
+        snprintf(reply, size, "[OK%s] %s\r\n%s%s", tag, text, end, prompt);
+    }
+}
+
+/**
+ * @brief Construction de la réponse de la carte émulée à une trame
+ * @param frame Trame reçue complète (SYNC compris)
+ * @param reply Buffer de sortie
+ * @return Taille de la trame de réponse
+ */
+static size_t Board_FormatFrame(const uint8_t *frame, uint8_t *reply)
+{
+    uint8_t opcode = frame[1];
+    uint8_t length = 1;
+
+    reply[3] = SERIAL_STATUS_OK;
+    if (opcode == SERIAL_OP_STATUS) {
+        // LED éteintes, aucun chenillard, fréquence 1S (1000 ms)
+        memset(reply + 4, 0, 4);
+        reply[8] = 2;
+        reply[9] = 1000 >> 8;
+        reply[10] = 1000 & 0xFF;
+        length = 8;
+    }
+    reply[0] = SERIAL_FRAME_SYNC;
+    reply[1] = opcode | SERIAL_FRAME_REPLY_FLAG;
+    reply[2] = length;
+    uint16_t crc = Serial_Crc16(reply + 1, (size_t)length + 2);
+    reply[3 + length] = (uint8_t)(crc >> 8);
+    reply[4 + length] = (uint8_t)(crc & 0xFF);
+    return (size_t)length + SERIAL_FRAME_OVERHEAD;
+}
+
+/**
+ * @brief Boucle de la carte émulée
+ * @note  Chaque commande est disponible LINK_LATENCY_US après sa lecture
+ *        (latence USB-CDC) ; les réponses sont ensuite sérialisées sur la
+ *        liaison descendante à BYTE_TIME_US par octet. Une réponse n'est
+ *        écrite qu'à l'instant où son dernier octet aurait été transmis.
+ * @param fd Côté maître du pseudo-terminal
+ * @param mode Mode mesuré (format des réponses)
+ */
+static void Board_Run(int fd, BenchMode mode)
+{
+    PendingReply replies[BOARD_MAX_PENDING];
+    size_t replyHead = 0;
+    size_t replyCount = 0;
+    double linkFreeAt = 0.0;
+    char command[128];
+    size_t length = 0;
+
+    while (true) {
+        double now = Bench_Now();
+
+        // Livraison des réponses dont la transmission est terminée
+        if (replyCount > 0 && now >= replies[replyHead].deliverAt) {
+            PendingReply *reply = &replies[replyHead];
+            size_t len = reply->length;
+            if (write(fd, reply->text, len) < 0) {
+                _exit(EXIT_FAILURE);
+            }
+            *boardBytes += len;
+            replyHead = (replyHead + 1) % BOARD_MAX_PENDING;
+            replyCount--;
+            continue;
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        struct timeval timeout;
+        struct timeval *timeoutPtr = NULL;
+        if (replyCount > 0) {
+            double wait = replies[replyHead].deliverAt - now;
+            timeout.tv_sec = (time_t)wait;
+            timeout.tv_usec = (suseconds_t)((wait - (double)timeout.tv_sec) * 1e6);
+            timeoutPtr = &timeout;
+        }
+        int result = select(fd + 1, &readfds, NULL, NULL, timeoutPtr);
+        if (result < 0 && errno != EINTR) {
+            _exit(EXIT_FAILURE);
+        }
+        if (result <= 0) {
+            continue;
+        }
+
+        char buffer[256];
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            _exit(EXIT_SUCCESS);
+        }
+        now = Bench_Now();
+
+        for (ssize_t i = 0; i < n; i++) {
+            if (mode == MODE_BINARY) {
+                // Accumulation jusqu'à une trame complète (reçue intacte)
+                if (length < sizeof(command)) {
+                    command[length++] = buffer[i];
+                }
+                if (length < 3 || length < (size_t)(uint8_t)command[2] + SERIAL_FRAME_OVERHEAD) {
+                    continue;
+                }
+                length = 0;
+            } else if (buffer[i] != '\r') {
+                if (length < sizeof(command) - 1) {
+                    command[length++] = buffer[i];
+                }
+                continue;
+            }
+            command[length] = '\0';
+            length = 0;
+
+            if (replyCount == BOARD_MAX_PENDING) {
+                continue;
+            }
+            PendingReply *reply = &replies[(replyHead + replyCount) % BOARD_MAX_PENDING];
+            if (mode == MODE_BINARY) {
+                reply->length = Board_FormatFrame((const uint8_t *)command, (uint8_t *)reply->text);
+            } else {
+                Board_FormatReply(command, mode, reply->text, sizeof(reply->text));
+                reply->length = strlen(reply->text);
+            }
+
+            double start = now + LINK_LATENCY_US / 1e6;
+            if (start < linkFreeAt) {
+                start = linkFreeAt;
+            }
+            reply->deliverAt = start + (double)reply->length * BYTE_TIME_US / 1e6;
+            linkFreeAt = reply->deliverAt;
+            replyCount++;
+        }
+    }
+}
+
+/**
+ * @brief Réception selon l'ancienne méthode (50 ms de silence)
+ * @return true si des données ont été reçues
+ */
+static bool Legacy_ReceiveResponse(void)
+{
+    int fd = Serial_GetFd();
+    char buffer[512];
+    size_t total = 0;
+
+    while (true) {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        struct timeval timeout = { 0, LEGACY_SILENCE_MS * 1000 };
+        int result = select(fd + 1, &readfds, NULL, NULL, &timeout);
+        if (result <= 0) {
+            break;
+        }
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        total += (size_t)n;
+    }
+
+    return total > 0;
+}
+
+/**
+ * @brief Fin d'une requête du pipeline
+ */
+static void Pipelined_OnReply(const char *command, const char *response, bool completed)
+{
+    (void)command;
+    (void)response;
+    if (completed) {
+        completedReplies++;
+    }
+}
+
+/**
+ * @brief Envoi de commandes numérotées avec PIPELINE_WINDOW_MAX en vol
+ * @param count Nombre de commandes à envoyer
+ * @return Nombre de réponses complètes
+ */
+static int Pipelined_Run(int count)
+{
+    int fd = Serial_GetFd();
+    int sent = 0;
+    char line[512];
+
+    completedReplies = 0;
+    Pipeline_Init(PIPELINE_WINDOW_MAX, Pipelined_OnReply, NULL);
+
+    while (completedReplies + (int)Pipeline_Outstanding() < count || Pipeline_Outstanding() > 0) {
+        while (sent < count && Pipeline_CanSubmit()) {
+            if (!Pipeline_Submit(COMMANDS[sent % COMMAND_COUNT])) {
+                return completedReplies;
+            }
+            sent++;
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(fd, &readfds);
+        struct timeval timeout = { 0, 100 * 1000 };
+        if (select(fd + 1, &readfds, NULL, NULL, &timeout) < 0) {
+            return completedReplies;
+        }
+
+        if (Serial_Poll() < 0) {
+            return completedReplies;
+        }
+
+        SerialLineType type;
+        while ((type = Serial_NextLine(line, sizeof(line))) != SERIAL_LINE_NONE) {
+            Pipeline_HandleLine(type, line);
+        }
+        Pipeline_CheckTimeouts();
+    }
+
+    return completedReplies;
+}
+
+/**
+ * @brief Mesure d'une méthode de réception
+ * @param name Nom affiché
+ * @param mode Mode mesuré
+ * @param count Nombre de commandes à envoyer
+ * @return true si toutes les commandes ont reçu une réponse
+ */
+static bool Bench_Run(const char *name, BenchMode mode, int count)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("Erreur création pseudo-terminal");
+        return false;
+    }
+
+    // Le côté esclave est ouvert avant le fork pour que la carte ne voie pas
+    // de raccrochage entre deux ouvertures
+    Serial_Init();
+    if (!Serial_Open(ptsname(master))) {
+        close(master);
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        Board_Run(master, mode);
+    }
+
+    int ok = 0;
+    *boardBytes = 0;
+    double start = Bench_Now();
+    if (mode == MODE_PIPELINED) {
+        ok = Pipelined_Run(count);
+    } else if (mode == MODE_BINARY) {
+        for (int i = 0; i < count; i++) {
+            const BenchFrame *frame = &FRAMES[i % COMMAND_COUNT];
+            uint8_t opcode;
+            uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+            size_t length;
+            if (!Serial_SendFrame(frame->opcode, frame->payload, frame->length)) {
+                break;
+            }
+            if (Serial_ReceiveFrame(&opcode, payload, sizeof(payload), &length) &&
+                opcode == (frame->opcode | SERIAL_FRAME_REPLY_FLAG) && payload[0] == SERIAL_STATUS_OK) {
+                ok++;
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            const char *command = COMMANDS[i % COMMAND_COUNT];
+            char response[512];
+            if (!Serial_SendCommand(command)) {
+                break;
+            }
+            bool received = (mode == MODE_FRAMED) ? Serial_ReceiveResponse(response, sizeof(response))
+                                                  : Legacy_ReceiveResponse();
+            if (received) {
+                ok++;
+            }
+        }
+    }
+    double elapsed = Bench_Now() - start;
+
+    Serial_Close();
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    close(master);
+
+    // Occupation de la liaison descendante : temps de transmission des
+    // octets reçus rapporté à la durée de la mesure
+    double linkUsage = 100.0 * (double)*boardBytes * BYTE_TIME_US / 1e6 / elapsed;
+    printf("%-22s %8d %10.3f %12.1f %14.3f %10.1f%%\n", name, ok, elapsed,
+           ok / elapsed, elapsed * 1000.0 / count, linkUsage);
+    return ok == count;
+}
+
+/**
+ * @brief Point d'entrée du banc de mesure
+ */
+int main(void)
+{
+    // Compteur partagé avec les processus de la carte émulée
+    boardBytes = mmap(NULL, sizeof(*boardBytes), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (boardBytes == MAP_FAILED) {
+        perror("Erreur mmap()");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-22s %8s %10s %12s %14s %11s\n", "methode", "reponses", "duree (s)",
+           "commandes/s", "latence (ms)", "liaison");
+    bool ok = Bench_Run("silence 50 ms", MODE_LEGACY, LEGACY_COMMANDS);
+    ok = Bench_Run("trame [END]", MODE_FRAMED, FRAMED_COMMANDS) && ok;
+    ok = Bench_Run("pipeline numerote", MODE_PIPELINED, PIPELINED_COMMANDS) && ok;
+    ok = Bench_Run("trames binaires", MODE_BINARY, BINARY_COMMANDS) && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
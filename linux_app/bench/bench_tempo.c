@@ -0,0 +1,250 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* Les modules du firmware sont inclus directement pour accéder au timer
+ * des étapes du chenillard (patternTimer) et rejouer l'ancien réglage. */
+#include "Modules/led_controller.h"
+#include "../../STM32F756ZG_Serial_Communication/Core/Src/Modules/timer_handler.c"
+#include "../../STM32F756ZG_Serial_Communication/Core/Src/Modules/pattern_controller.c"
+
+/**
+ * @file bench_tempo.c
+ * @brief Simulation de la gigue des étapes d'un chenillard autour d'un changement de période
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce programme compile timer_handler.c et pattern_controller.c sur l'hôte et
+ * simule, milliseconde par milliseconde, l'interruption de TIM2 et la boucle
+ * principale (Timer_Process, commande, Pattern_Controller_Update). Chaque
+ * essai démarre un chenillard à une période P0, demande une période P1 à un
+ * instant tiré au hasard dans une étape (appliquée au passage suivant de la
+ * boucle, comme une commande FREQ), puis relève l'instant de chaque étape
+ * (appel de LED_ForceMask). Deux réglages sont comparés :
+ * - redémarrage : le timer est réarmé à la nouvelle période, la fraction
+ *   écoulée de l'étape en cours est perdue (comportement précédent) ;
+ * - phase conservée : Pattern_SetPeriod (Timer_SetPeriod).
+ * Pour chaque réglage sont affichés, en millisecondes, l'écart des étapes à
+ * leur instant nominal avant le changement, l'écart de l'étape du
+ * changement à l'instant idéal (fraction écoulée de P0 puis fraction
+ * restante de P1) et l'écart des intervalles à P1 après le changement.
+ * La boucle principale peut être occupée pendant une durée aléatoire de 0 à
+ * N ms entre deux passages (argument, 0 par défaut).
+ */
+
+#define BENCH_TRIALS 1000
+#define BENCH_STEPS_BEFORE 5        // Étapes complètes avant le changement
+#define BENCH_STEPS_AFTER 5         // Étapes complètes après le changement
+#define BENCH_MAX_STEPS 64
+#define BENCH_SEED 0x2545F491u
+
+/* Périodes tirées pour P0 et P1 (ms) */
+static const uint32_t PERIODS[] = { 7, 50, 100, 250, 500, 1000, 3000 };
+#define PERIOD_COUNT (sizeof(PERIODS) / sizeof(PERIODS[0]))
+
+/* Réglages comparés */
+typedef enum {
+    TEMPO_RESTART = 0,      // Réarmement à la nouvelle période
+    TEMPO_PHASE             // Pattern_SetPeriod
+} TempoMode;
+
+/* Écarts accumulés sur tous les essais */
+typedef struct {
+    double sumSquares;
+    double maxAbs;
+    unsigned long count;
+} Deviation;
+
+/* Variables privées */
+TIM_HandleTypeDef htim2 = { TIM2 };
+static uint32_t stepTicks[BENCH_MAX_STEPS];
+static int stepCount = 0;
+static bool recording = false;
+static uint32_t busyUntil = 0;
+static uint32_t loopLatencyMax = 0;
+static uint32_t randomState = BENCH_SEED;
+static TempoMode changeMode = TEMPO_PHASE;
+static uint32_t changePeriod = 0;           // Période demandée (0 : aucune)
+static uint32_t changeTick = 0;             // Tick où elle a été appliquée
+static int changeStep = 0;                  // Première étape après le changement
+
+/* Remplacements des modules matériels ---------------------------------------*/
+int HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim) { (void)htim; return 0; }
+void Event_Post(uint32_t events) { (void)events; }
+void Profile_Record(Profile_Probe probe, uint32_t cycles) { (void)probe; (void)cycles; }
+bool DMA_Player_Start(const uint32_t *words, uint8_t length, volatile uint32_t *target, uint32_t periodMs) { (void)words; (void)length; (void)target; (void)periodMs; return false; }
+void DMA_Player_Stop(void) { }
+bool DMA_Player_SetPeriod(uint32_t periodMs) { (void)periodMs; return false; }
+bool DMA_Player_IsRunning(void) { return false; }
+uint32_t LED_MaskToBsrr(uint32_t mask) { return mask; }
+volatile uint32_t *LED_GetBsrrAddress(void) { return NULL; }
+void LED_FadeMask(uint32_t mask, uint32_t durationMs) { (void)mask; (void)durationMs; }
+uint32_t LED_GetMask(void) { return 0; }
+void LED_ForceMask(uint32_t mask)
+{
+    (void)mask;
+    if (recording && stepCount < BENCH_MAX_STEPS) {
+        stepTicks[stepCount++] = Timer_GetTicks();
+    }
+}
+
+/**
+ * @brief Générateur pseudo-aléatoire (xorshift32, reproductible)
+ * @param bound Borne exclue
+ * @return Valeur de 0 à bound - 1
+ */
+static uint32_t Bench_Random(uint32_t bound)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState % bound;
+}
+
+/**
+ * @brief Application de la période demandée (commande reçue)
+ */
+static void Bench_ApplyChange(void)
+{
+    // Une étape échue à ce passage (Timer_Process) précède le changement
+    changeTick = Timer_GetTicks();
+    changeStep = stepCount + (patternNeedsUpdate ? 1 : 0);
+    if (changeMode == TEMPO_PHASE) {
+        Pattern_SetPeriod(changePeriod);
+    } else {
+        stepPeriodMs = changePeriod;
+        Timer_Arm(&patternTimer, changePeriod, changePeriod, Pattern_TimerExpired, NULL);
+    }
+    changePeriod = 0;
+}
+
+/**
+ * @brief Simulation de la carte pendant une durée donnée
+ * @note  Chaque milliseconde, l'interruption de TIM2 incrémente les ticks ;
+ *        la boucle principale passe si elle n'est pas occupée.
+ * @param ms Durée simulée en millisecondes
+ */
+static void Bench_Run(uint32_t ms)
+{
+    for (uint32_t i = 0; i < ms; i++) {
+        HAL_TIM_PeriodElapsedCallback(&htim2);
+        if ((int32_t)(Timer_GetTicks() - busyUntil) >= 0) {
+            Timer_Process();
+            if (changePeriod != 0) {
+                Bench_ApplyChange();
+            }
+            Pattern_Controller_Update();
+            busyUntil = Timer_GetTicks() + Bench_Random(loopLatencyMax + 1);
+        }
+    }
+}
+
+/**
+ * @brief Ajout d'un écart
+ * @param deviation Accumulateur
+ * @param value Écart en millisecondes
+ */
+static void Bench_Accumulate(Deviation *deviation, double value)
+{
+    deviation->sumSquares += value * value;
+    if (fabs(value) > deviation->maxAbs) {
+        deviation->maxAbs = fabs(value);
+    }
+    deviation->count++;
+}
+
+/**
+ * @brief Un essai : chenillard à P0, changement vers P1 en cours d'étape
+ * @param mode Réglage de la nouvelle période
+ * @param p0 Période initiale (ms)
+ * @param p1 Nouvelle période (ms)
+ * @param before Écarts des étapes avant le changement
+ * @param change Écart de l'étape du changement
+ * @param after Écarts des intervalles après le changement
+ */
+static void Bench_Trial(TempoMode mode, uint32_t p0, uint32_t p1,
+                        Deviation *before, Deviation *change, Deviation *after)
+{
+    uint32_t offset = Bench_Random(p0);
+
+    Pattern_Controller_Init();
+    Timer_Init();
+    busyUntil = 0;
+    stepCount = 0;
+    recording = true;
+
+    Pattern_SetPeriod(p0);
+    Pattern_Start(PATTERN_1);
+    Pattern_Controller_Update();    // Première étape au tick 0
+    Bench_Run(p0 * BENCH_STEPS_BEFORE + offset);
+
+    changeMode = mode;
+    changePeriod = p1;
+    Bench_Run(p1 * (BENCH_STEPS_AFTER + 1) + loopLatencyMax);
+    int firstAfter = changeStep;
+    recording = false;
+    Pattern_Stop();
+
+    // Étapes avant le changement : grille nominale k * P0
+    for (int i = 0; i < firstAfter; i++) {
+        Bench_Accumulate(before, (double)stepTicks[i] - (double)i * p0);
+    }
+
+    // Étape du changement : fraction restante de l'étape à la période P1
+    if (firstAfter < stepCount) {
+        uint32_t lastNominal = changeTick / p0 * p0;
+        double fraction = (double)(changeTick - lastNominal) / p0;
+        double ideal = changeTick + (1.0 - fraction) * p1;
+        Bench_Accumulate(change, (double)stepTicks[firstAfter] - ideal);
+    }
+
+    // Étapes suivantes : intervalles comparés à P1
+    for (int i = firstAfter + 1; i < stepCount; i++) {
+        Bench_Accumulate(after, (double)(stepTicks[i] - stepTicks[i - 1]) - p1);
+    }
+}
+
+/**
+ * @brief Affichage d'un écart (RMS / maximum)
+ * @param deviation Accumulateur
+ */
+static void Bench_Print(const Deviation *deviation)
+{
+    double rms = deviation->count ? sqrt(deviation->sumSquares / deviation->count) : 0.0;
+    printf(" %9.2f / %-9.2f", rms, deviation->maxAbs);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *MODE_NAMES[] = { "redemarrage", "phase conservee" };
+
+    if (argc > 1) {
+        loopLatencyMax = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+
+    printf("Changement de periode d'un chenillard (%d essais, boucle occupee 0-%u ms, ecarts en ms RMS / max)\n",
+           BENCH_TRIALS, (unsigned)loopLatencyMax);
+    printf("%-16s %21s %21s %21s\n", "reglage", "avant", "changement", "apres");
+
+    for (int mode = TEMPO_RESTART; mode <= TEMPO_PHASE; mode++) {
+        Deviation before = { 0 }, change = { 0 }, after = { 0 };
+
+        randomState = BENCH_SEED;
+        for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+            uint32_t p0 = PERIODS[Bench_Random(PERIOD_COUNT)];
+            uint32_t p1 = PERIODS[Bench_Random(PERIOD_COUNT)];
+            Bench_Trial((TempoMode)mode, p0, p1, &before, &change, &after);
+        }
+
+        printf("%-16s", MODE_NAMES[mode]);
+        Bench_Print(&before);
+        Bench_Print(&change);
+        Bench_Print(&after);
+        printf("\n");
+    }
+
+    return 0;
+}
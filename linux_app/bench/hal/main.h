@@ -0,0 +1,49 @@
+#ifndef BENCH_HAL_MAIN_H
+#define BENCH_HAL_MAIN_H
+
+/**
+ * @file main.h
+ * @brief Remplacement minimal de main.h pour compiler des modules du firmware sur l'hôte
+ * @author
+ * @date 07-04-2025
+ *
+ * Les modules du firmware incluent "main.h", qui tire toute la HAL STM32.
+ * Les bancs de mesure placent ce répertoire avant Core/Inc dans le chemin
+ * d'inclusion : seuls les types et macros réellement utilisés par les
+ * modules compilés sur l'hôte sont fournis ici.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Handle UART (seulement référencé par des prototypes) */
+typedef struct {
+    int unused;
+} UART_HandleTypeDef;
+
+/* Timer matériel : seule l'instance est comparée par les modules */
+typedef struct {
+    int unused;
+} TIM_TypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+} TIM_HandleTypeDef;
+
+#define TIM2 ((TIM_TypeDef *)0x40000000UL)
+
+/* Fournie par le banc qui compile timer_handler.c */
+int HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+
+/* Compteur de cycles DWT : lu par les sondes de profilage (profiler.h) */
+typedef struct {
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+static DWT_Type benchDwt __attribute__((unused));
+#define DWT (&benchDwt)
+
+/* Barrière mémoire : un seul fil d'exécution sur l'hôte */
+#define __DMB() __asm__ volatile ("" ::: "memory")
+
+#endif /* BENCH_HAL_MAIN_H */
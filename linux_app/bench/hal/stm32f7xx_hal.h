@@ -0,0 +1,15 @@
+#ifndef BENCH_HAL_STM32F7XX_HAL_H
+#define BENCH_HAL_STM32F7XX_HAL_H
+
+/**
+ * @file stm32f7xx_hal.h
+ * @brief Remplacement de l'en-tête HAL pour compiler des modules du firmware sur l'hôte
+ * @author
+ * @date 07-04-2025
+ *
+ * Les types utilisés sont fournis par le main.h de ce répertoire.
+ */
+
+#include "main.h"
+
+#endif /* BENCH_HAL_STM32F7XX_HAL_H */
@@ -0,0 +1,126 @@
+#!/bin/sh
+#
+# map_report.sh - Rapport de placement mémoire du firmware
+#
+# Lit le fichier .map produit par l'éditeur de liens GNU et affiche, pour les
+# sections ITCM (.itcm_text), DTCM (.dtcm_data) et DMA (.dma_buffer), leur
+# adresse, leur taille, la contribution de chaque objet et les symboles
+# placés. Une section absente du .map (firmware lié avant l'ajout des
+# sections) est signalée et le script se termine en erreur.
+#
+# Usage : ./bench/map_report.sh [fichier.map]
+#
+
+MAP=${1:-../STM32F756ZG_Serial_Communication/Debug/STM32F756ZG_Serial_Communication.map}
+
+if [ ! -r "$MAP" ]; then
+    echo "map_report: $MAP introuvable" >&2
+    exit 1
+fi
+
+awk '
+# Conversion "0x..." -> entier (awk POSIX, sans strtonum)
+function hex(text,    i, digit, value) {
+    value = 0
+    text = tolower(text)
+    sub(/^0x/, "", text)
+    for (i = 1; i <= length(text); i++) {
+        digit = index("0123456789abcdef", substr(text, i, 1)) - 1
+        value = value * 16 + digit
+    }
+    return value
+}
+
+function flush_pending() {
+    pending = ""
+}
+
+function report_header(name, addr, size, load) {
+    printf "\n%-12s %s  %6d octets", name, addr, hex(size)
+    if (load != "")
+        printf "  (chargée depuis %s)", load
+    printf "  [%s]\n", zone[name]
+    found[name] = 1
+    total[name] = hex(size)
+}
+
+BEGIN {
+    zone[".itcm_text"]  = "ITCM-RAM 0x00000000"
+    zone[".dtcm_data"]  = "DTCM-RAM 0x20000000"
+    zone[".dma_buffer"] = "SRAM2 0x2004C000, non cachable"
+    order[1] = ".itcm_text"; order[2] = ".dtcm_data"; order[3] = ".dma_buffer"
+    current = ""
+    pending = ""
+}
+
+# Début de section de sortie : "nom adresse taille [load address x]",
+# éventuellement coupé sur deux lignes quand le nom est long
+/^\.[A-Za-z_]/ {
+    current = ""
+    flush_pending()
+    if ($1 in zone) {
+        if (NF >= 3) {
+            report_header($1, $2, $3, (NF >= 6) ? $6 : "")
+            current = $1
+        } else {
+            header = $1
+        }
+    }
+    next
+}
+
+header != "" {
+    if ($1 ~ /^0x/)
+        report_header(header, $1, $2, (NF >= 5) ? $5 : "")
+    current = header
+    header = ""
+    next
+}
+
+current == "" { next }
+
+# Fin de la section courante
+/^$/ { current = ""; next }
+
+# Section d entrée : " .section adresse taille objet", coupée sur deux
+# lignes quand le nom de la section d entrée est long
+/^ \.[^ ]/ || /^ COMMON/ {
+    if (NF >= 4) {
+        printf "  %-36s %6d  %s\n", $1, hex($3), $4
+        contributions[current]++
+    } else {
+        pending = $1
+    }
+    next
+}
+
+pending != "" && $1 ~ /^0x/ && NF >= 3 {
+    printf "  %-36s %6d  %s\n", pending, hex($2), $3
+    contributions[current]++
+    flush_pending()
+    next
+}
+
+# Symbole : "adresse nom" (les affectations du script contiennent "=")
+$1 ~ /^0x/ && NF == 2 && $0 !~ /=/ {
+    printf "      %s %s\n", $1, $2
+    symbols[current]++
+    next
+}
+
+END {
+    missing = 0
+    printf "\n"
+    for (i = 1; i <= 3; i++) {
+        name = order[i]
+        if (name in found) {
+            printf "%-12s %6d octets, %d contributions, %d symboles\n", \
+                   name, total[name], contributions[name], symbols[name]
+        } else {
+            printf "%-12s ABSENTE du fichier map (firmware à relier)\n", name
+            missing = 1
+        }
+    }
+    exit missing
+}
+' "$MAP"
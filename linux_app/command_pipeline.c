@@ -0,0 +1,331 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "command_pipeline.h"
+
+/**
+ * @file command_pipeline.c
+ * @brief Module d'envoi de commandes en pipeline
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce fichier implémente l'envoi de plusieurs commandes sans attendre les
+ * réponses précédentes. Le firmware traite les commandes dans l'ordre et
+ * envoie chaque réponse d'un seul bloc : une balise numérotée identifie la
+ * requête concernée. Une réponse [END#n] termine la requête n ; les
+ * requêtes plus anciennes encore en attente sont considérées comme perdues.
+ *
+ * Les lignes non balisées sont mises de côté : elles appartiennent à la
+ * requête dont la balise suit (corps de STATUS ou de STATS), ou forment un
+ * message spontané de la carte si un [END] non balisé ou un prompt les
+ * termine (bannière après un reset, erreur sans numéro). Un [END] non
+ * balisé ne termine jamais une requête.
+ */
+
+#define SEQUENCE_MODULO 10000       // Numéros de séquence de 0 à 9999
+
+/* Requête en attente de réponse */
+typedef struct {
+    unsigned int sequence;
+    char command[128];
+    char response[1024];
+    size_t responseLength;
+} PendingRequest;
+
+/* Variables privées */
+static PendingRequest requests[PIPELINE_WINDOW_MAX];
+static size_t requestHead = 0;          // Requête la plus ancienne
+static size_t requestCount = 0;
+static unsigned int windowSize = 1;
+static unsigned int nextSequence = 0;
+static Pipeline_ReplyCallback replyCallback = NULL;
+static Pipeline_MessageCallback messageCallback = NULL;
+static PendingRequest untagged;         // Lignes non balisées en attente d'attribution
+static struct timespec lastActivity;    // Dernier envoi ou dernière ligne reçue
+
+/* Prototypes de fonctions privées */
+static int Pipeline_ParseTag(const char *line, char *display, size_t size, bool *isEnd);
+static PendingRequest* Pipeline_Find(unsigned int sequence, size_t *position);
+static void Pipeline_AppendLine(PendingRequest *request, const char *line);
+static void Pipeline_CompleteHead(bool completed);
+static void Pipeline_ReleaseUntagged(void);
+static void Pipeline_Touch(void);
+
+/**
+ * @brief Initialisation du pipeline
+ * @param window Nombre de commandes en vol (1 à PIPELINE_WINDOW_MAX)
+ * @param callback Fonction appelée à la fin de chaque requête
+ * @param message Fonction appelée pour chaque ligne d'un message spontané
+ *        reçu pendant que des requêtes sont en vol (NULL : ignorées)
+ */
+void Pipeline_Init(unsigned int window, Pipeline_ReplyCallback callback,
+                   Pipeline_MessageCallback message)
+{
+    if (window < 1) {
+        window = 1;
+    }
+    if (window > PIPELINE_WINDOW_MAX) {
+        window = PIPELINE_WINDOW_MAX;
+    }
+    windowSize = window;
+    replyCallback = callback;
+    messageCallback = message;
+    untagged.response[0] = '\0';
+    untagged.responseLength = 0;
+    requestHead = 0;
+    requestCount = 0;
+    nextSequence = 0;
+    Pipeline_Touch();
+}
+
+/**
+ * @brief Vérification qu'une nouvelle commande peut être envoyée
+ * @return true si la fenêtre n'est pas pleine
+ */
+bool Pipeline_CanSubmit(void)
+{
+    return requestCount < windowSize;
+}
+
+/**
+ * @brief Envoi d'une commande numérotée
+ * @param command Commande validée à envoyer
+ * @return true si la commande a été envoyée, false sinon
+ */
+bool Pipeline_Submit(const char *command)
+{
+    if (command == NULL || !Pipeline_CanSubmit()) {
+        return false;
+    }
+
+    PendingRequest *request = &requests[(requestHead + requestCount) % PIPELINE_WINDOW_MAX];
+    request->sequence = nextSequence;
+    snprintf(request->command, sizeof(request->command), "%s", command);
+    request->response[0] = '\0';
+    request->responseLength = 0;
+
+    char tagged[160];
+    snprintf(tagged, sizeof(tagged), "#%u %s", request->sequence, command);
+    if (!Serial_SendCommand(tagged)) {
+        return false;
+    }
+
+    nextSequence = (nextSequence + 1) % SEQUENCE_MODULO;
+    if (requestCount == 0) {
+        Pipeline_Touch();
+    }
+    requestCount++;
+    return true;
+}
+
+/**
+ * @brief Nombre de commandes en attente de réponse
+ * @return Nombre de requêtes en vol
+ */
+size_t Pipeline_Outstanding(void)
+{
+    return requestCount;
+}
+
+/**
+ * @brief Traitement d'un élément reçu du microcontrôleur
+ * @param type Type de l'élément (Serial_NextLine)
+ * @param line Contenu de la ligne
+ * @return true si la ligne est prise en charge par le pipeline, false si
+ *         aucune requête n'est en vol
+ */
+bool Pipeline_HandleLine(SerialLineType type, const char *line)
+{
+    if (type == SERIAL_LINE_NONE) {
+        return false;
+    }
+    if (type == SERIAL_LINE_PROMPT) {
+        // Le prompt ne suit qu'une réponse non numérotée
+        Pipeline_ReleaseUntagged();
+        return true;
+    }
+    if (requestCount == 0) {
+        return false;
+    }
+    Pipeline_Touch();
+
+    char display[256];
+    bool isEnd = false;
+    int sequence = Pipeline_ParseTag(line, display, sizeof(display), &isEnd);
+
+    // Ligne non balisée : attribuée par la balise qui la suit
+    if (sequence < 0) {
+        if (type == SERIAL_LINE_END) {
+            Pipeline_ReleaseUntagged();
+        } else {
+            Pipeline_AppendLine(&untagged, line);
+        }
+        return true;
+    }
+
+    size_t position;
+    PendingRequest *request = Pipeline_Find((unsigned int)sequence, &position);
+    if (request == NULL) {
+        // Réponse à une requête déjà abandonnée : ignorée avec son corps
+        untagged.response[0] = '\0';
+        untagged.responseLength = 0;
+        return true;
+    }
+
+    // Les requêtes plus anciennes n'auront plus de réponse
+    while (position-- > 0) {
+        Pipeline_CompleteHead(false);
+    }
+
+    // Le corps reçu avant la balise appartient à cette requête
+    if (untagged.responseLength > 0) {
+        Pipeline_AppendLine(request, untagged.response);
+        untagged.response[0] = '\0';
+        untagged.responseLength = 0;
+    }
+
+    if (isEnd) {
+        Pipeline_CompleteHead(true);
+    } else {
+        Pipeline_AppendLine(request, display);
+    }
+    return true;
+}
+
+/**
+ * @brief Abandon des requêtes sans activité depuis SERIAL_RESPONSE_TIMEOUT_MS
+ */
+void Pipeline_CheckTimeouts(void)
+{
+    if (requestCount == 0) {
+        return;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long elapsedMs = (now.tv_sec - lastActivity.tv_sec) * 1000L +
+                     (now.tv_nsec - lastActivity.tv_nsec) / 1000000L;
+    if (elapsedMs >= SERIAL_RESPONSE_TIMEOUT_MS) {
+        // Une seule requête abandonnée par expiration : les suivantes
+        // disposent à nouveau d'un délai complet
+        Pipeline_ReleaseUntagged();
+        Pipeline_CompleteHead(false);
+        Pipeline_Touch();
+    }
+}
+
+/**
+ * @brief Analyse d'une balise numérotée ("[OK#n] ...", "[ERR#n] ...", "[END#n]")
+ * @param line Ligne reçue
+ * @param display Ligne sans le numéro de séquence (pour l'affichage)
+ * @param size Taille du buffer display
+ * @param isEnd Mis à true pour une balise END
+ * @return Numéro de séquence, ou -1 si la ligne n'est pas balisée
+ */
+static int Pipeline_ParseTag(const char *line, char *display, size_t size, bool *isEnd)
+{
+    static const char *TAGS[] = { "[OK#", "[ERR#", "[END#" };
+
+    for (size_t i = 0; i < sizeof(TAGS) / sizeof(TAGS[0]); i++) {
+        size_t tagLen = strlen(TAGS[i]);
+        if (strncmp(line, TAGS[i], tagLen) != 0 || !isdigit((unsigned char)line[tagLen])) {
+            continue;
+        }
+
+        char *end;
+        long sequence = strtol(line + tagLen, &end, 10);
+        if (*end != ']') {
+            return -1;
+        }
+
+        *isEnd = (i == 2);
+        snprintf(display, size, "%.*s]%s", (int)(tagLen - 1), line, end + 1);
+        return (int)sequence;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Recherche d'une requête en vol par numéro de séquence
+ * @param sequence Numéro recherché
+ * @param position Rang de la requête depuis la plus ancienne
+ * @return Pointeur vers la requête, ou NULL si absente
+ */
+static PendingRequest* Pipeline_Find(unsigned int sequence, size_t *position)
+{
+    for (size_t i = 0; i < requestCount; i++) {
+        PendingRequest *request = &requests[(requestHead + i) % PIPELINE_WINDOW_MAX];
+        if (request->sequence == sequence) {
+            *position = i;
+            return request;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Ajout d'une ligne à la réponse d'une requête
+ * @param request Requête concernée
+ * @param line Ligne à ajouter
+ */
+static void Pipeline_AppendLine(PendingRequest *request, const char *line)
+{
+    size_t space = sizeof(request->response) - request->responseLength;
+    int written = snprintf(request->response + request->responseLength, space, "%s%s",
+                           (request->responseLength > 0) ? "\n" : "", line);
+    if (written > 0) {
+        request->responseLength += ((size_t)written < space) ? (size_t)written : space - 1;
+    }
+}
+
+/**
+ * @brief Fin de la requête la plus ancienne
+ * @param completed true si sa réponse est complète
+ */
+static void Pipeline_CompleteHead(bool completed)
+{
+    if (requestCount == 0) {
+        return;
+    }
+
+    PendingRequest *request = &requests[requestHead];
+    requestHead = (requestHead + 1) % PIPELINE_WINDOW_MAX;
+    requestCount--;
+
+    if (replyCallback != NULL) {
+        replyCallback(request->command, request->response, completed);
+    }
+}
+
+/**
+ * @brief Transmission des lignes non balisées comme message spontané
+ */
+static void Pipeline_ReleaseUntagged(void)
+{
+    char *line = untagged.response;
+
+    while (untagged.responseLength > 0 && line != NULL) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        if (messageCallback != NULL && line[0] != '\0') {
+            messageCallback(line);
+        }
+        line = next;
+    }
+    untagged.response[0] = '\0';
+    untagged.responseLength = 0;
+}
+
+/**
+ * @brief Mémorisation de l'instant de la dernière activité
+ */
+static void Pipeline_Touch(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &lastActivity);
+}
@@ -0,0 +1,84 @@
+#ifndef COMMAND_PIPELINE_H
+#define COMMAND_PIPELINE_H
+
+/**
+ * @file command_pipeline.h
+ * @brief En-tête pour le module d'envoi de commandes en pipeline
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce fichier contient les prototypes des fonctions qui permettent d'avoir
+ * plusieurs commandes en vol : chaque commande est numérotée ("#n "), le
+ * microcontrôleur reprend ce numéro dans ses balises ([OK#n], [ERR#n],
+ * [END#n]) et les réponses sont associées aux requêtes en attente.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "serial_handler.h"
+
+/* Nombre maximal de commandes en vol ; doit rester inférieur à la profondeur
+ * de la file de commandes du firmware (COMMAND_QUEUE_DEPTH - 1 = 7) */
+#define PIPELINE_WINDOW_MAX 6
+
+/**
+ * @brief Fonction appelée à la fin de chaque requête, dans l'ordre d'envoi
+ * @param command Commande envoyée (sans numéro de séquence)
+ * @param response Réponse reçue, lignes séparées par \n (balises sans numéro)
+ * @param completed true si le marqueur de fin a été reçu, false si la
+ *        réponse a été perdue ou a expiré
+ */
+typedef void (*Pipeline_ReplyCallback)(const char *command, const char *response, bool completed);
+
+/**
+ * @brief Fonction appelée pour chaque ligne d'un message spontané de la carte
+ * @param line Ligne reçue hors réponse à une requête
+ */
+typedef void (*Pipeline_MessageCallback)(const char *line);
+
+/**
+ * @brief Initialisation du pipeline
+ * @param window Nombre de commandes en vol (1 à PIPELINE_WINDOW_MAX)
+ * @param callback Fonction appelée à la fin de chaque requête
+ * @param message Fonction appelée pour chaque ligne d'un message spontané
+ *        reçu pendant que des requêtes sont en vol (NULL : ignorées)
+ */
+void Pipeline_Init(unsigned int window, Pipeline_ReplyCallback callback,
+                   Pipeline_MessageCallback message);
+
+/**
+ * @brief Vérification qu'une nouvelle commande peut être envoyée
+ * @return true si la fenêtre n'est pas pleine
+ */
+bool Pipeline_CanSubmit(void);
+
+/**
+ * @brief Envoi d'une commande numérotée
+ * @param command Commande validée à envoyer
+ * @return true si la commande a été envoyée, false si la fenêtre est pleine
+ *         ou en cas d'erreur d'envoi
+ */
+bool Pipeline_Submit(const char *command);
+
+/**
+ * @brief Nombre de commandes en attente de réponse
+ * @return Nombre de requêtes en vol
+ */
+size_t Pipeline_Outstanding(void);
+
+/**
+ * @brief Traitement d'un élément reçu du microcontrôleur
+ * @param type Type de l'élément (Serial_NextLine)
+ * @param line Contenu de la ligne
+ * @return true si la ligne est prise en charge par le pipeline, false si
+ *         c'est un message spontané reçu sans requête en vol (ceux reçus
+ *         pendant une requête passent par la fonction message)
+ */
+bool Pipeline_HandleLine(SerialLineType type, const char *line);
+
+/**
+ * @brief Abandon des requêtes sans activité depuis SERIAL_RESPONSE_TIMEOUT_MS
+ */
+void Pipeline_CheckTimeouts(void);
+
+#endif /* COMMAND_PIPELINE_H */
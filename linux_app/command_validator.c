@@ -57,9 +57,17 @@ bool Command_Validate(const char *command)
     if (strcmp(upperCommand, "HELP") == 0) return true;
     if (strcmp(upperCommand, "STATUS") == 0) return true;
     if (strcmp(upperCommand, "STOP") == 0) return true;
+    if (strcmp(upperCommand, "PATLIST") == 0) return true;
+    if (strcmp(upperCommand, "LOAD") == 0) return true;
+    if (strcmp(upperCommand, "STATS") == 0) return true;
     if (strcmp(upperCommand, "CLEAR") == 0) return true;
     if (strcmp(upperCommand, "QUIT") == 0) return true;
 
+    // Toutes les LED: LEDS <0|1 par LED>
+    if (strncmp(upperCommand, "LEDS ", 5) == 0) {
+        return strlen(upperCommand + 5) == 3 && strspn(upperCommand + 5, "01") == 3;
+    }
+
     // Commandes LED: LED<N> ON/OFF
     if (strncmp(upperCommand, "LED", 3) == 0) {
         if (len >= 6 && // LED1 ON
@@ -93,12 +101,87 @@ bool Command_Validate(const char *command)
         }
     }
 
-    // Raccourcis: PAT<N> ou FREQ<F>
+    // Chargement d'un chenillard: PATDEF<N> <étapes 0-7>
+    if (strncmp(upperCommand, "PATDEF", 6) == 0) {
+        const char *steps = upperCommand + 8;
+        return len > 8 && isdigit((unsigned char)upperCommand[6]) && upperCommand[7] == ' ' &&
+               strspn(steps, "01234567") == strlen(steps);
+    }
+
+    // Chargement d'un programme: PATPROG<N> <offset> <hex> ou PATPROG<N> END
+    if (strncmp(upperCommand, "PATPROG", 7) == 0) {
+        const char *args = upperCommand + 9;
+        size_t offsetLen = strspn(args, "0123456789");
+        if (len <= 9 || !isdigit((unsigned char)upperCommand[7]) || upperCommand[8] != ' ') {
+            return false;
+        }
+        if (strcmp(args, "END") == 0) {
+            return true;
+        }
+        return offsetLen > 0 && args[offsetLen] == ' ' && args[offsetLen + 1] != '\0' &&
+               strspn(args + offsetLen + 1, "0123456789ABCDEF") == strlen(args + offsetLen + 1);
+    }
+
+    // Lecture des chenillards: PLAYBACK CPU|DMA
+    if (strcmp(upperCommand, "PLAYBACK CPU") == 0 || strcmp(upperCommand, "PLAYBACK DMA") == 0) {
+        return true;
+    }
+
+    // Luminosité: DIM<N> <niveau>, FADE<N> <niveau> <ms> (bornes vérifiées par le STM32)
+    if (strncmp(upperCommand, "DIM", 3) == 0) {
+        const char *level = upperCommand + 5;
+        return len > 5 && isdigit((unsigned char)upperCommand[3]) && upperCommand[4] == ' ' &&
+               strspn(level, "0123456789") == strlen(level);
+    }
+    if (strncmp(upperCommand, "FADE", 4) == 0) {
+        const char *args = upperCommand + 6;
+        size_t levelLen = strspn(args, "0123456789");
+        return len > 6 && isdigit((unsigned char)upperCommand[4]) && upperCommand[5] == ' ' &&
+               levelLen > 0 && args[levelLen] == ' ' && args[levelLen + 1] != '\0' &&
+               strspn(args + levelLen + 1, "0123456789") == strlen(args + levelLen + 1);
+    }
+
+    // Profil d'horloge: CLOCK [LOW|BALANCED|FULL|BENCH]
+    if (strcmp(upperCommand, "CLOCK") == 0 || strcmp(upperCommand, "CLOCK LOW") == 0 ||
+        strcmp(upperCommand, "CLOCK BALANCED") == 0 || strcmp(upperCommand, "CLOCK FULL") == 0 ||
+        strcmp(upperCommand, "CLOCK BENCH") == 0) {
+        return true;
+    }
+
+    // Profilage par compteur de cycles: PROFILE [RESET]
+    if (strcmp(upperCommand, "PROFILE") == 0 || strcmp(upperCommand, "PROFILE RESET") == 0) {
+        return true;
+    }
+
+    // Fondu des étapes des chenillards: PATFADE ON|OFF
+    if (strcmp(upperCommand, "PATFADE ON") == 0 || strcmp(upperCommand, "PATFADE OFF") == 0) {
+        return true;
+    }
+
+    // Commandes programmées: AT, AT GO, AT CLEAR ou AT <t|+t|@t> <commande>
+    if (strcmp(upperCommand, "AT") == 0 || strcmp(upperCommand, "AT GO") == 0 ||
+        strcmp(upperCommand, "AT CLEAR") == 0) {
+        return true;
+    }
+    if (strncmp(upperCommand, "AT ", 3) == 0) {
+        const char *time = upperCommand + 3;
+        size_t digits;
+        if (*time == '+' || *time == '@') {
+            time++;
+        }
+        digits = strspn(time, "0123456789");
+        return digits > 0 && time[digits] == ' ' && Command_Validate(time + digits + 1);
+    }
+
+    // Raccourcis: PAT<N>, FREQ<F> ou FREQ <ms>
     if (strncmp(upperCommand, "PAT", 3) == 0) {
         if (len == 4 && isdigit((unsigned char)upperCommand[3])) return true;
     }
     if (strncmp(upperCommand, "FREQ", 4) == 0) {
         if (len == 5 && isdigit((unsigned char)upperCommand[4])) return true;
+        // FREQ <ms> : période libre (bornes vérifiées par le STM32)
+        if (len > 5 && len <= 10 && upperCommand[4] == ' ' &&
+            strspn(upperCommand + 5, "0123456789") == len - 5) return true;
     }
 
     // Si aucun format ne correspond
@@ -0,0 +1,321 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+#include "event_loop.h"
+
+/**
+ * @file event_loop.c
+ * @brief Boucle d'événements basée sur epoll
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce fichier implémente une boucle d'événements unique qui remplace
+ * l'alternance fgets bloquant / select : l'entrée standard, le port série,
+ * les timers et les signaux sont tous des descripteurs surveillés par le
+ * même epoll, et chacun est associé à une fonction de traitement.
+ */
+
+/* Description d'une source surveillée */
+typedef struct {
+    int fd;
+    EventLoop_Callback callback;
+    void *context;
+    bool ownedFd;   // true si le descripteur a été créé par la boucle
+} EventSource;
+
+/* Variables privées */
+static int epollFd = -1;
+static EventSource sources[EVENT_LOOP_MAX_SOURCES];
+static bool running = false;
+static sigset_t watchedSignals;
+
+/* Prototypes de fonctions privées */
+static EventSource* EventLoop_FindSource(int fd);
+static bool EventLoop_Register(int fd, EventLoop_Callback callback, void *context, bool ownedFd);
+
+/**
+ * @brief Initialisation de la boucle d'événements
+ * @return true si l'initialisation a réussi, false sinon
+ */
+bool EventLoop_Init(void)
+{
+    for (int i = 0; i < EVENT_LOOP_MAX_SOURCES; i++) {
+        sources[i].fd = -1;
+        sources[i].callback = NULL;
+        sources[i].context = NULL;
+        sources[i].ownedFd = false;
+    }
+    sigemptyset(&watchedSignals);
+    running = false;
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        perror("Erreur epoll_create1()");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Libération des ressources de la boucle (timers, signaux, epoll)
+ */
+void EventLoop_Cleanup(void)
+{
+    for (int i = 0; i < EVENT_LOOP_MAX_SOURCES; i++) {
+        if (sources[i].fd >= 0 && sources[i].ownedFd) {
+            close(sources[i].fd);
+        }
+        sources[i].fd = -1;
+    }
+
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+
+    // Restauration de la délivrance normale des signaux surveillés
+    sigprocmask(SIG_UNBLOCK, &watchedSignals, NULL);
+    sigemptyset(&watchedSignals);
+}
+
+/**
+ * @brief Ajout d'un descripteur à surveiller en lecture
+ * @param fd Descripteur à surveiller
+ * @param callback Fonction appelée quand le descripteur est prêt
+ * @param context Pointeur transmis à la fonction
+ * @return true si l'ajout a réussi, false sinon
+ */
+bool EventLoop_AddFd(int fd, EventLoop_Callback callback, void *context)
+{
+    return EventLoop_Register(fd, callback, context, false);
+}
+
+/**
+ * @brief Retrait d'un descripteur surveillé
+ * @param fd Descripteur à retirer
+ */
+void EventLoop_RemoveFd(int fd)
+{
+    EventSource *source = EventLoop_FindSource(fd);
+    if (source == NULL) {
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL);
+    if (source->ownedFd) {
+        close(fd);
+    }
+    source->fd = -1;
+    source->callback = NULL;
+    source->context = NULL;
+    source->ownedFd = false;
+}
+
+/**
+ * @brief Création d'un timer (désarmé) surveillé par la boucle
+ * @param callback Fonction appelée à chaque expiration
+ * @param context Pointeur transmis à la fonction
+ * @return Descripteur du timer, ou -1 en cas d'erreur
+ */
+int EventLoop_CreateTimer(EventLoop_Callback callback, void *context)
+{
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd < 0) {
+        perror("Erreur timerfd_create()");
+        return -1;
+    }
+
+    if (!EventLoop_Register(timerFd, callback, context, true)) {
+        close(timerFd);
+        return -1;
+    }
+
+    return timerFd;
+}
+
+/**
+ * @brief Armement d'un timer
+ * @param timerFd Descripteur retourné par EventLoop_CreateTimer
+ * @param delayMs Délai avant expiration en millisecondes
+ * @param periodic true pour un timer périodique
+ * @return true si l'armement a réussi, false sinon
+ */
+bool EventLoop_ArmTimer(int timerFd, unsigned int delayMs, bool periodic)
+{
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+
+    // Un délai nul désarmerait le timer : on impose au moins 1 ns
+    spec.it_value.tv_sec = delayMs / 1000;
+    spec.it_value.tv_nsec = (long)(delayMs % 1000) * 1000000L;
+    if (delayMs == 0) {
+        spec.it_value.tv_nsec = 1;
+    }
+    if (periodic) {
+        spec.it_interval = spec.it_value;
+    }
+
+    if (timerfd_settime(timerFd, 0, &spec, NULL) != 0) {
+        perror("Erreur timerfd_settime()");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Désarmement d'un timer
+ * @param timerFd Descripteur retourné par EventLoop_CreateTimer
+ */
+void EventLoop_DisarmTimer(int timerFd)
+{
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    timerfd_settime(timerFd, 0, &spec, NULL);
+}
+
+/**
+ * @brief Surveillance de signaux via signalfd
+ * @param signals Tableau des numéros de signaux
+ * @param count Nombre de signaux
+ * @param callback Fonction appelée à la réception d'un signal
+ * @param context Pointeur transmis à la fonction
+ * @return true si la surveillance a été mise en place, false sinon
+ */
+bool EventLoop_WatchSignals(const int *signals, size_t count,
+                            EventLoop_Callback callback, void *context)
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (size_t i = 0; i < count; i++) {
+        sigaddset(&mask, signals[i]);
+    }
+
+    // Les signaux doivent être bloqués pour n'être délivrés que par signalfd
+    if (sigprocmask(SIG_BLOCK, &mask, NULL) != 0) {
+        perror("Erreur sigprocmask()");
+        return false;
+    }
+
+    int signalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFd < 0) {
+        perror("Erreur signalfd()");
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+        return false;
+    }
+
+    if (!EventLoop_Register(signalFd, callback, context, true)) {
+        close(signalFd);
+        sigprocmask(SIG_UNBLOCK, &mask, NULL);
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        sigaddset(&watchedSignals, signals[i]);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Exécution de la boucle jusqu'à l'appel de EventLoop_Stop
+ * @return true si la boucle s'est terminée normalement, false sur erreur
+ */
+bool EventLoop_Run(void)
+{
+    struct epoll_event events[EVENT_LOOP_MAX_SOURCES];
+
+    if (epollFd < 0) {
+        return false;
+    }
+
+    running = true;
+    while (running) {
+        int count = epoll_wait(epollFd, events, EVENT_LOOP_MAX_SOURCES, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Erreur epoll_wait()");
+            running = false;
+            return false;
+        }
+
+        for (int i = 0; i < count && running; i++) {
+            // La source a pu être retirée par une fonction appelée plus tôt
+            EventSource *source = EventLoop_FindSource(events[i].data.fd);
+            if (source != NULL && source->callback != NULL) {
+                source->callback(source->fd, events[i].events, source->context);
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Demande d'arrêt de la boucle (effective après le tour en cours)
+ */
+void EventLoop_Stop(void)
+{
+    running = false;
+}
+
+/**
+ * @brief Recherche de la source associée à un descripteur
+ * @param fd Descripteur recherché
+ * @return Pointeur vers la source, ou NULL si absente
+ */
+static EventSource* EventLoop_FindSource(int fd)
+{
+    for (int i = 0; i < EVENT_LOOP_MAX_SOURCES; i++) {
+        if (sources[i].fd == fd) {
+            return &sources[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Enregistrement d'un descripteur dans epoll et dans la table
+ * @param fd Descripteur à enregistrer
+ * @param callback Fonction de traitement
+ * @param context Pointeur utilisateur
+ * @param ownedFd true si la boucle doit fermer le descripteur
+ * @return true si l'enregistrement a réussi, false sinon
+ */
+static bool EventLoop_Register(int fd, EventLoop_Callback callback, void *context, bool ownedFd)
+{
+    if (epollFd < 0 || fd < 0 || callback == NULL) {
+        return false;
+    }
+
+    EventSource *slot = EventLoop_FindSource(-1);
+    if (slot == NULL) {
+        fprintf(stderr, "Erreur: trop de sources dans la boucle d'événements\n");
+        return false;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        perror("Erreur epoll_ctl()");
+        return false;
+    }
+
+    slot->fd = fd;
+    slot->callback = callback;
+    slot->context = context;
+    slot->ownedFd = ownedFd;
+    return true;
+}
@@ -0,0 +1,102 @@
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+/**
+ * @file event_loop.h
+ * @brief En-tête pour la boucle d'événements basée sur epoll
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce fichier contient les prototypes des fonctions de la boucle
+ * d'événements qui surveille en même temps l'entrée standard, le port
+ * série, les timers (timerfd) et les signaux (signalfd).
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Nombre maximal de descripteurs surveillés simultanément */
+#define EVENT_LOOP_MAX_SOURCES 16
+
+/**
+ * @brief Fonction appelée lorsqu'un descripteur surveillé est prêt
+ * @param fd Descripteur concerné
+ * @param events Masque epoll des événements reçus (EPOLLIN, EPOLLHUP, ...)
+ * @param context Pointeur utilisateur fourni à l'enregistrement
+ */
+typedef void (*EventLoop_Callback)(int fd, uint32_t events, void *context);
+
+/**
+ * @brief Initialisation de la boucle d'événements
+ * @return true si l'initialisation a réussi, false sinon
+ */
+bool EventLoop_Init(void);
+
+/**
+ * @brief Libération des ressources de la boucle (timers, signaux, epoll)
+ */
+void EventLoop_Cleanup(void);
+
+/**
+ * @brief Ajout d'un descripteur à surveiller en lecture
+ * @param fd Descripteur à surveiller
+ * @param callback Fonction appelée quand le descripteur est prêt
+ * @param context Pointeur transmis à la fonction
+ * @return true si l'ajout a réussi, false sinon
+ */
+bool EventLoop_AddFd(int fd, EventLoop_Callback callback, void *context);
+
+/**
+ * @brief Retrait d'un descripteur surveillé
+ * @param fd Descripteur à retirer
+ */
+void EventLoop_RemoveFd(int fd);
+
+/**
+ * @brief Création d'un timer (désarmé) surveillé par la boucle
+ * @param callback Fonction appelée à chaque expiration
+ * @param context Pointeur transmis à la fonction
+ * @return Descripteur du timer, ou -1 en cas d'erreur
+ */
+int EventLoop_CreateTimer(EventLoop_Callback callback, void *context);
+
+/**
+ * @brief Armement d'un timer
+ * @param timerFd Descripteur retourné par EventLoop_CreateTimer
+ * @param delayMs Délai avant expiration en millisecondes
+ * @param periodic true pour un timer périodique
+ * @return true si l'armement a réussi, false sinon
+ */
+bool EventLoop_ArmTimer(int timerFd, unsigned int delayMs, bool periodic);
+
+/**
+ * @brief Désarmement d'un timer
+ * @param timerFd Descripteur retourné par EventLoop_CreateTimer
+ */
+void EventLoop_DisarmTimer(int timerFd);
+
+/**
+ * @brief Surveillance de signaux via signalfd
+ * @note  Les signaux sont bloqués pour le processus et délivrés à la boucle.
+ * @param signals Tableau des numéros de signaux
+ * @param count Nombre de signaux
+ * @param callback Fonction appelée à la réception d'un signal
+ * @param context Pointeur transmis à la fonction
+ * @return true si la surveillance a été mise en place, false sinon
+ */
+bool EventLoop_WatchSignals(const int *signals, size_t count,
+                            EventLoop_Callback callback, void *context);
+
+/**
+ * @brief Exécution de la boucle jusqu'à l'appel de EventLoop_Stop
+ * @return true si la boucle s'est terminée normalement, false sur erreur
+ */
+bool EventLoop_Run(void);
+
+/**
+ * @brief Demande d'arrêt de la boucle (effective après le tour en cours)
+ */
+void EventLoop_Stop(void);
+
+#endif /* EVENT_LOOP_H */
@@ -1,16 +1,22 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include <signal.h>
+#include <stdint.h>
 #include <termios.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/stat.h>
 #include "serial_handler.h"
 #include "command_validator.h"
 #include "ui_handler.h"
 #include "special_commands.h"
+#include "event_loop.h"
+#include "command_pipeline.h"
 
 /**
  * @file main.c
@@ -21,13 +27,43 @@
  * Ce fichier contient le point d'entrée du programme et la boucle principale
  * pour l'application console Linux qui communique avec le microcontrôleur
  * STM32F756ZG via une liaison série.
+ *
+ * La boucle principale est une boucle d'événements (epoll) qui surveille
+ * l'entrée standard, le port série, le timer d'attente de réponse et les
+ * signaux d'arrêt. Les messages spontanés de la carte sont affichés dès leur
+ * arrivée et une réponse est terminée dès que son marqueur de fin ([END])
+ * est reçu.
+ *
+ * Les commandes sont envoyées numérotées par le module command_pipeline :
+ * plusieurs commandes peuvent être en vol (option -w), ce qui permet
+ * d'exécuter un script de commandes redirigé sur l'entrée standard sans
+ * payer un aller-retour par commande.
  */
 
 #define MAX_COMMAND_LENGTH 128
+#define MAX_RESPONSE_LENGTH 1024
+#define TIMEOUT_CHECK_MS 100        // Période de vérification des réponses expirées
+
+/* Variables privées */
+static int timeoutTimerFd = -1;     // Timer de vérification des réponses
+static bool timeoutArmed = false;   // Timer armé (des requêtes sont en vol)
+static bool interactive = true;     // Entrée standard sur un terminal
+static bool stdinIsFile = false;    // Entrée standard redirigée depuis un fichier
+static bool inputClosed = false;    // Fin de l'entrée standard atteinte
+static bool promptVisible = false;  // Le prompt est affiché sur la ligne courante
 
 /* Prototypes de fonctions privées */
 static void initialize(void);
 static void cleanup(void);
+static void usage(const char *program);
+static void OnStdinReady(int fd, uint32_t events, void *context);
+static void OnSerialReady(int fd, uint32_t events, void *context);
+static void OnTimeoutCheck(int fd, uint32_t events, void *context);
+static void OnSignal(int fd, uint32_t events, void *context);
+static void OnReply(const char *command, const char *response, bool completed);
+static void OnMessage(const char *line);
+static void ProcessPendingCommands(void);
+static bool ProcessCommand(const char *command);
 
 /**
  * @brief Point d'entrée principal du programme
@@ -37,17 +73,42 @@ static void cleanup(void);
  */
 int main(int argc, char *argv[])
 {
-    char command[MAX_COMMAND_LENGTH];
-    bool running = true;
     char *port = "/dev/ttyACM0"; // Port série par défaut
+    static const int STOP_SIGNALS[] = { SIGINT, SIGTERM, SIGHUP };
+    struct stat stdinStat;
+    int window = 0;
+    int option;
     
     // Traitement des arguments de ligne de commande
-    if (argc > 1) {
-        port = argv[1];
+    while ((option = getopt(argc, argv, "w:h")) != -1) {
+        switch (option) {
+            case 'w':
+                window = atoi(optarg);
+                if (window < 1 || window > PIPELINE_WINDOW_MAX) {
+                    fprintf(stderr, "Erreur: fenetre entre 1 et %d\n", PIPELINE_WINDOW_MAX);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (optind < argc) {
+        port = argv[optind];
+    }
+
+    // Un script redirigé est envoyé avec la fenêtre maximale, une saisie
+    // interactive une commande à la fois
+    interactive = isatty(STDIN_FILENO);
+    stdinIsFile = (fstat(STDIN_FILENO, &stdinStat) == 0 && S_ISREG(stdinStat.st_mode));
+    if (window == 0) {
+        window = interactive ? 1 : PIPELINE_WINDOW_MAX;
     }
     
     // Initialisation des modules
     initialize();
+    Pipeline_Init((unsigned int)window, OnReply, OnMessage);
     
     // Ouverture du port série
     if (!Serial_Open(port)) {
@@ -55,48 +116,32 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
     
+    // Mise en place de la boucle d'événements (un fichier régulier ne peut
+    // pas être surveillé par epoll : il est lu au fur et à mesure des envois)
+    if (!EventLoop_Init() ||
+        (!stdinIsFile && !EventLoop_AddFd(STDIN_FILENO, OnStdinReady, NULL)) ||
+        !EventLoop_AddFd(Serial_GetFd(), OnSerialReady, NULL) ||
+        !EventLoop_WatchSignals(STOP_SIGNALS, sizeof(STOP_SIGNALS) / sizeof(STOP_SIGNALS[0]), OnSignal, NULL) ||
+        (timeoutTimerFd = EventLoop_CreateTimer(OnTimeoutCheck, NULL)) < 0) {
+        UI_DisplayError("Impossible d'initialiser la boucle d'événements");
+        cleanup();
+        return EXIT_FAILURE;
+    }
+    
     // Affichage du message de bienvenue et des commandes disponibles
-    UI_DisplayWelcome();
-    UI_DisplayHelp();
+    if (interactive) {
+        UI_DisplayWelcome();
+        UI_DisplayHelp();
+    }
     
     // Boucle principale
-    while (running) {
-        // Affichage du prompt et lecture de la commande
-        UI_DisplayPrompt();
-        if (UI_ReadCommand(command, MAX_COMMAND_LENGTH)) {
-            
-            // Traitement des commandes spéciales
-            if (Special_IsSpecialCommand(command)) {
-                if (Special_ProcessCommand(command) == SPECIAL_CMD_QUIT) {
-                    running = false;
-                }
-                continue;
-            }
-            
-            // Validation de la commande
-            if (Command_Validate(command)) {
-                // Envoi de la commande au microcontrôleur
-                if (Serial_SendCommand(command)) {
-                    // Attente et affichage de la réponse
-                    char response[256];
-                    if (Serial_ReceiveResponse(response, sizeof(response))) {
-                        UI_DisplayResponse(response);
-                    } else {
-                        UI_DisplayError("Pas de réponse du microcontrôleur");
-                    }
-                } else {
-                    UI_DisplayError("Erreur lors de l'envoi de la commande");
-                }
-            } else {
-                UI_DisplayError("Commande invalide");
-            }
-        }
-    }
+    ProcessPendingCommands();
+    bool ok = EventLoop_Run();
     
     // Nettoyage avant de quitter
     cleanup();
     
-    return EXIT_SUCCESS;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
 /**
@@ -115,6 +160,224 @@ static void initialize(void)
  */
 static void cleanup(void)
 {
+    EventLoop_Cleanup();
     Serial_Close();
     UI_Cleanup();
 }
+
+/**
+ * @brief Affichage de la syntaxe de la ligne de commande
+ * @param program Nom du programme
+ */
+static void usage(const char *program)
+{
+    printf("Usage: %s [-w fenetre] [port_serie]\n", program);
+    printf("  -w fenetre : nombre de commandes en vol (1 a %d)\n", PIPELINE_WINDOW_MAX);
+    printf("               par defaut 1 en interactif, %d pour un script\n", PIPELINE_WINDOW_MAX);
+}
+
+/**
+ * @brief Traitement de l'entrée standard prête en lecture
+ * @param fd Descripteur de l'entrée standard
+ * @param events Événements epoll reçus
+ * @param context Non utilisé
+ */
+static void OnStdinReady(int fd, uint32_t events, void *context)
+{
+    (void)events;
+    (void)context;
+
+    if (!UI_FillInput()) {
+        // Fin de l'entrée standard : on quitte une fois les réponses reçues
+        inputClosed = true;
+        EventLoop_RemoveFd(fd);
+    }
+
+    ProcessPendingCommands();
+}
+
+/**
+ * @brief Traitement des octets reçus du microcontrôleur
+ * @param fd Descripteur du port série
+ * @param events Événements epoll reçus
+ * @param context Non utilisé
+ */
+static void OnSerialReady(int fd, uint32_t events, void *context)
+{
+    (void)fd;
+    (void)events;
+    (void)context;
+    char line[MAX_RESPONSE_LENGTH];
+
+    if (Serial_Poll() < 0) {
+        UI_DisplayError("Liaison série perdue");
+        EventLoop_Stop();
+        return;
+    }
+
+    SerialLineType type;
+    while ((type = Serial_NextLine(line, sizeof(line))) != SERIAL_LINE_NONE) {
+        if (!Pipeline_HandleLine(type, line) && line[0] != '\0') {
+            OnMessage(line);
+        }
+    }
+
+    ProcessPendingCommands();
+}
+
+/**
+ * @brief Vérification périodique des réponses expirées
+ * @param fd Descripteur du timer
+ * @param events Événements epoll reçus
+ * @param context Non utilisé
+ */
+static void OnTimeoutCheck(int fd, uint32_t events, void *context)
+{
+    (void)events;
+    (void)context;
+    uint64_t expirations;
+
+    // Acquittement du timer
+    if (read(fd, &expirations, sizeof(expirations)) < 0) {
+        return;
+    }
+
+    Pipeline_CheckTimeouts();
+    ProcessPendingCommands();
+}
+
+/**
+ * @brief Réception d'un signal d'arrêt (SIGINT, SIGTERM, SIGHUP)
+ * @param fd Descripteur signalfd
+ * @param events Événements epoll reçus
+ * @param context Non utilisé
+ */
+static void OnSignal(int fd, uint32_t events, void *context)
+{
+    (void)events;
+    (void)context;
+    char info[128];     // struct signalfd_siginfo (128 octets)
+
+    if (read(fd, info, sizeof(info)) < 0) {
+        return;
+    }
+
+    printf("\nAu revoir !\n");
+    EventLoop_Stop();
+}
+
+/**
+ * @brief Fin d'une requête : affichage de la réponse
+ * @param command Commande envoyée
+ * @param response Réponse reçue
+ * @param completed true si la réponse est complète
+ */
+static void OnReply(const char *command, const char *response, bool completed)
+{
+    if (!interactive) {
+        printf("> %s\n", command);
+    }
+    promptVisible = false;
+
+    if (response[0] != '\0') {
+        UI_DisplayResponse(response);
+    }
+    if (!completed) {
+        UI_DisplayError("Pas de réponse du microcontrôleur");
+    }
+}
+
+/**
+ * @brief Affichage d'un message spontané de la carte
+ * @param line Ligne reçue hors réponse à une commande
+ */
+static void OnMessage(const char *line)
+{
+    UI_DisplayAsync(line);
+    promptVisible = interactive;
+}
+
+/**
+ * @brief Envoi des commandes saisies tant que la fenêtre le permet
+ * @note  Gère aussi le prompt, le timer des réponses et l'arrêt en fin de
+ *        script.
+ */
+static void ProcessPendingCommands(void)
+{
+    char command[MAX_COMMAND_LENGTH];
+
+    while (Pipeline_CanSubmit()) {
+        if (!UI_NextCommand(command, sizeof(command))) {
+            // Un fichier est lu par morceaux au rythme des envois
+            if (stdinIsFile && !inputClosed) {
+                if (!UI_FillInput()) {
+                    inputClosed = true;
+                }
+                continue;
+            }
+            break;
+        }
+        // La saisie validée par Entrée a quitté la ligne du prompt
+        promptVisible = false;
+        if (!ProcessCommand(command)) {
+            return;
+        }
+    }
+
+    // Timer périodique armé une seule fois : le réarmer à chaque événement
+    // repousserait la vérification tant que les événements se succèdent
+    if (Pipeline_Outstanding() > 0) {
+        if (!timeoutArmed) {
+            timeoutArmed = EventLoop_ArmTimer(timeoutTimerFd, TIMEOUT_CHECK_MS, true);
+        }
+        return;
+    }
+    if (timeoutArmed) {
+        EventLoop_DisarmTimer(timeoutTimerFd);
+        timeoutArmed = false;
+    }
+
+    if (inputClosed) {
+        EventLoop_Stop();
+        return;
+    }
+
+    if (interactive && !promptVisible) {
+        UI_DisplayPrompt();
+        promptVisible = true;
+    }
+}
+
+/**
+ * @brief Traitement d'une commande saisie
+ * @param command Commande saisie
+ * @return false si l'application doit s'arrêter, true sinon
+ */
+static bool ProcessCommand(const char *command)
+{
+    // Ligne vide : simple réaffichage du prompt
+    if (command[0] == '\0') {
+        return true;
+    }
+
+    // Traitement des commandes spéciales
+    if (Special_IsSpecialCommand(command)) {
+        if (Special_ProcessCommand(command) == SPECIAL_CMD_QUIT) {
+            EventLoop_Stop();
+            return false;
+        }
+        return true;
+    }
+    
+    // Validation de la commande
+    if (!Command_Validate(command)) {
+        UI_DisplayError("Commande invalide");
+        return true;
+    }
+
+    // Envoi numéroté ; la réponse est rendue par OnReply()
+    if (!Pipeline_Submit(command)) {
+        UI_DisplayError("Erreur lors de l'envoi de la commande");
+    }
+    return true;
+}
@@ -0,0 +1,172 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "serial_handler.h"
+#include "pattern_compiler.h"
+
+/**
+ * @file patc.c
+ * @brief Compilateur et chargeur des programmes de chenillard
+ * @author
+ * @date 07-04-2025
+ *
+ * stm32_patc compile un programme de chenillard (pattern_compiler.c) et le
+ * charge dans un emplacement de la carte par des commandes PATPROG : le
+ * bytecode est envoyé par morceaux en hexadécimal, chaque morceau attend son
+ * [OK] avant le suivant, puis PATPROG<n> END fait vérifier et activer le
+ * programme. Avec -n, les commandes sont seulement affichées (script pour
+ * stm32_console, ou options -c de la carte virtuelle).
+ */
+
+#define PATC_MAX_SOURCE     16384
+#define PATC_DEFAULT_SLOT   4
+#define PATC_FIRST_SLOT     4           // PATTERN_BUILTIN_COUNT + 1
+#define PATC_LAST_SLOT      7           // PATTERN_BUILTIN_COUNT + PATTERN_USER_SLOTS
+
+/* Prototypes de fonctions privées */
+static void usage(const char *program);
+static bool ReadSource(const char *path, char *source, size_t size);
+static bool Upload(const char *port, unsigned int slot, const uint8_t *code, size_t length);
+
+/**
+ * @brief Point d'entrée du compilateur
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return Code de retour du programme
+ */
+int main(int argc, char *argv[])
+{
+    static char source[PATC_MAX_SOURCE];
+    uint8_t code[COMPILER_PROGRAM_SIZE];
+    char error[128];
+    char line[64];
+    size_t length;
+    size_t offset = 0;
+    const char *port = "/dev/ttyACM0";
+    unsigned int slot = PATC_DEFAULT_SLOT;
+    bool printOnly = false;
+    int option;
+
+    while ((option = getopt(argc, argv, "s:nh")) != -1) {
+        switch (option) {
+            case 's':
+                slot = (unsigned int)atoi(optarg);
+                if (slot < PATC_FIRST_SLOT || slot > PATC_LAST_SLOT) {
+                    fprintf(stderr, "Erreur: emplacement de %d a %d\n", PATC_FIRST_SLOT, PATC_LAST_SLOT);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'n':
+                printOnly = true;
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc || argc - optind > 2) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (argc - optind == 2) {
+        port = argv[optind + 1];
+    }
+
+    if (!ReadSource(argv[optind], source, sizeof(source))) {
+        return EXIT_FAILURE;
+    }
+    if (!Compiler_Compile(source, code, sizeof(code), &length, error, sizeof(error))) {
+        fprintf(stderr, "%s:%s\n", argv[optind], error);
+        return EXIT_FAILURE;
+    }
+
+    if (printOnly) {
+        while (Compiler_NextCommand(slot, code, length, &offset, line, sizeof(line))) {
+            printf("%s\n", line);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (!Upload(port, slot, code, length)) {
+        return EXIT_FAILURE;
+    }
+    printf("Programme charge dans PAT%u (%zu instructions), demarrer par PAT%u\n",
+           slot, length / COMPILER_INSN_SIZE, slot);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Affichage de l'aide de la ligne de commande
+ * @param program Nom du programme
+ */
+static void usage(const char *program)
+{
+    printf("Usage: %s [-s emplacement] [-n] programme.pat [port_serie]\n", program);
+    printf("  -s emplacement : PAT%d a PAT%d (%d par defaut)\n", PATC_FIRST_SLOT, PATC_LAST_SLOT, PATC_DEFAULT_SLOT);
+    printf("  -n             : affiche les commandes PATPROG sans les envoyer\n");
+}
+
+/**
+ * @brief Lecture du programme source
+ * @param path Fichier source ("-" : entrée standard)
+ * @param source Texte lu, terminé par un caractère nul
+ * @param size Taille de source
+ * @return true si le fichier a été lu en entier
+ */
+static bool ReadSource(const char *path, char *source, size_t size)
+{
+    FILE *file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    size_t length;
+
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+    length = fread(source, 1, size - 1, file);
+    source[length] = '\0';
+    bool complete = !ferror(file) && feof(file);
+    if (file != stdin) {
+        fclose(file);
+    }
+    if (!complete) {
+        fprintf(stderr, "Erreur: %s illisible ou trop long (%zu octets au plus)\n", path, size - 1);
+    }
+    return complete;
+}
+
+/**
+ * @brief Chargement du bytecode dans la carte (PATPROG)
+ * @param port Port série
+ * @param slot Emplacement visé
+ * @param code Bytecode compilé
+ * @param length Octets de bytecode
+ * @return true si chaque commande a reçu [OK]
+ */
+static bool Upload(const char *port, unsigned int slot, const uint8_t *code, size_t length)
+{
+    char line[64];
+    char response[1024];
+    size_t offset = 0;
+    bool ok = true;
+
+    Serial_Init();
+    if (!Serial_Open(port)) {
+        return false;
+    }
+
+    while (ok && Compiler_NextCommand(slot, code, length, &offset, line, sizeof(line))) {
+        if (!Serial_SendCommand(line) || !Serial_ReceiveResponse(response, sizeof(response))) {
+            fprintf(stderr, "Erreur: pas de reponse a '%s'\n", line);
+            ok = false;
+        } else if (strstr(response, "[OK") == NULL) {
+            fprintf(stderr, "Erreur: '%s' refuse:\n%s\n", line, response);
+            ok = false;
+        }
+    }
+
+    Serial_Close();
+    return ok;
+}
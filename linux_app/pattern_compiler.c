@@ -0,0 +1,459 @@
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "pattern_compiler.h"
+
+/**
+ * @file pattern_compiler.c
+ * @brief Compilateur de programmes de chenillard
+ * @author
+ * @date 07-04-2025
+ *
+ * Ce fichier traduit un programme texte en bytecode pour la machine
+ * virtuelle des chenillards du firmware. Chaque ligne porte au plus une
+ * étiquette et une instruction ; les sauts vers une étiquette définie plus
+ * loin sont résolus à la fin de la compilation. Les contrôles refaits par
+ * le firmware (registres, cibles, masque de SHOW, WAIT, bornes de PERIOD)
+ * sont faits ici avec le numéro de ligne, pour qu'un programme compilé ne
+ * soit pas refusé par la carte.
+ */
+
+/* Constantes privées */
+#define COMPILER_MAX_LABELS     32
+#define COMPILER_LABEL_SIZE     24
+#define COMPILER_LINE_SIZE      256
+#define COMPILER_MAX_OPERANDS   3
+#define COMPILER_CHUNK_BYTES    16      // Octets par ligne PATPROG (ligne < 64 caractères)
+
+/* Instruction du langage : les opérandes sont décrits par une chaîne, un
+ * caractère par opérande : r registre, i immédiat, x registre (code op) ou
+ * immédiat (code opImm), l étiquette */
+typedef struct {
+    const char *name;
+    uint8_t op;
+    uint8_t opImm;
+    const char *operands;
+} Compiler_Mnemonic;
+
+/* Étiquette définie, ou saut en attente de sa cible */
+typedef struct {
+    char name[COMPILER_LABEL_SIZE];
+    unsigned int index;             // Instruction étiquetée, ou instruction du saut
+    unsigned int line;              // Ligne du source (saut en attente)
+} Compiler_Label;
+
+/* Variables privées */
+static const Compiler_Mnemonic MNEMONICS[] = {
+    { "set",    COMPILER_OP_SET,    0,                   "ri"  },
+    { "mov",    COMPILER_OP_MOV,    0,                   "rr"  },
+    { "add",    COMPILER_OP_ADD,    COMPILER_OP_ADDI,    "rx"  },
+    { "and",    COMPILER_OP_ANDI,   0,                   "ri"  },
+    { "xor",    COMPILER_OP_XORI,   0,                   "ri"  },
+    { "shl",    COMPILER_OP_SHLI,   0,                   "ri"  },
+    { "shr",    COMPILER_OP_SHRI,   0,                   "ri"  },
+    { "rand",   COMPILER_OP_RAND,   0,                   "ri"  },
+    { "leds",   COMPILER_OP_LEDS,   0,                   "r"   },
+    { "show",   COMPILER_OP_SHOW,   COMPILER_OP_SHOWI,   "x"   },
+    { "wait",   COMPILER_OP_WAIT,   0,                   "i"   },
+    { "period", COMPILER_OP_PERIOD, COMPILER_OP_PERIODI, "x"   },
+    { "jmp",    COMPILER_OP_JMP,    0,                   "l"   },
+    { "jz",     COMPILER_OP_JZ,     0,                   "rl"  },
+    { "jnz",    COMPILER_OP_JNZ,    0,                   "rl"  },
+    { "jlt",    COMPILER_OP_JLT,    0,                   "rrl" },
+    { "djnz",   COMPILER_OP_DJNZ,   0,                   "rl"  },
+    { "halt",   COMPILER_OP_HALT,   0,                   ""    },
+};
+#define MNEMONIC_COUNT (sizeof(MNEMONICS) / sizeof(MNEMONICS[0]))
+
+static Compiler_Label labels[COMPILER_MAX_LABELS];
+static size_t labelCount;
+static Compiler_Label fixups[COMPILER_PROGRAM_SIZE / COMPILER_INSN_SIZE];
+static size_t fixupCount;
+
+/* Prototypes de fonctions privées */
+static bool Compiler_Line(char *text, unsigned int line, uint8_t *code, size_t size, size_t *length,
+                          char *error, size_t errorSize);
+static bool Compiler_Instruction(const Compiler_Mnemonic *mnemonic, char **operands, size_t count,
+                                 unsigned int line, uint8_t *insn, size_t index,
+                                 char *error, size_t errorSize);
+static bool Compiler_CheckImmediate(uint8_t op, long value, unsigned int line, char *error, size_t errorSize);
+static const Compiler_Mnemonic* Compiler_FindMnemonic(const char *name);
+static int Compiler_Register(const char *text);
+static bool Compiler_Number(const char *text, long *value);
+static bool Compiler_IsLabelName(const char *text);
+static const Compiler_Label* Compiler_FindLabel(const char *name);
+
+/**
+ * @brief Compilation d'un programme de chenillard
+ * @param source Texte du programme (terminé par un caractère nul)
+ * @param code Bytecode produit
+ * @param size Taille de code (octets)
+ * @param length Octets de bytecode produits
+ * @param error Message d'erreur, avec le numéro de ligne
+ * @param errorSize Taille de error
+ * @return true si le programme est compilé, false sinon
+ */
+bool Compiler_Compile(const char *source, uint8_t *code, size_t size, size_t *length,
+                      char *error, size_t errorSize)
+{
+    char text[COMPILER_LINE_SIZE];
+    unsigned int line = 0;
+    const char *cursor = source;
+
+    labelCount = 0;
+    fixupCount = 0;
+    *length = 0;
+    if (size > COMPILER_PROGRAM_SIZE) {
+        size = COMPILER_PROGRAM_SIZE;
+    }
+
+    while (*cursor != '\0') {
+        const char *end = strchr(cursor, '\n');
+        size_t textLength = (end != NULL) ? (size_t)(end - cursor) : strlen(cursor);
+
+        line++;
+        if (textLength >= sizeof(text)) {
+            snprintf(error, errorSize, "ligne %u: ligne trop longue", line);
+            return false;
+        }
+        memcpy(text, cursor, textLength);
+        text[textLength] = '\0';
+        if (!Compiler_Line(text, line, code, size, length, error, errorSize)) {
+            return false;
+        }
+        cursor += textLength + ((end != NULL) ? 1 : 0);
+    }
+
+    if (*length == 0) {
+        snprintf(error, errorSize, "programme vide");
+        return false;
+    }
+
+    /* Sauts vers les étiquettes définies après eux */
+    for (size_t i = 0; i < fixupCount; i++) {
+        const Compiler_Label *label = Compiler_FindLabel(fixups[i].name);
+        if (label == NULL) {
+            snprintf(error, errorSize, "ligne %u: etiquette inconnue '%s'", fixups[i].line, fixups[i].name);
+            return false;
+        }
+        if (label->index >= *length / COMPILER_INSN_SIZE) {
+            snprintf(error, errorSize, "ligne %u: etiquette '%s' apres la derniere instruction",
+                     fixups[i].line, fixups[i].name);
+            return false;
+        }
+        code[fixups[i].index * COMPILER_INSN_SIZE + 3] = (uint8_t)label->index;
+    }
+    return true;
+}
+
+/**
+ * @brief Découpage du bytecode en commandes PATPROG
+ * @note Les morceaux font COMPILER_CHUNK_BYTES octets : une ligne numérotée
+ *       ("#n PATPROG7 112 <32 chiffres>") tient dans le tampon de commande
+ *       du firmware. Après END, offset dépasse length.
+ * @param slot Emplacement visé (PAT4 à PAT7)
+ * @param code Bytecode compilé
+ * @param length Octets de bytecode
+ * @param offset Octets déjà émis (0 pour la première ligne), avancé
+ * @param line Commande produite
+ * @param lineSize Taille de line
+ * @return false quand toutes les commandes ont été produites
+ */
+bool Compiler_NextCommand(unsigned int slot, const uint8_t *code, size_t length, size_t *offset,
+                          char *line, size_t lineSize)
+{
+    if (*offset > length) {
+        return false;
+    }
+    if (*offset == length) {
+        snprintf(line, lineSize, "PATPROG%u END", slot);
+        (*offset)++;
+        return true;
+    }
+
+    size_t chunk = length - *offset;
+    if (chunk > COMPILER_CHUNK_BYTES) {
+        chunk = COMPILER_CHUNK_BYTES;
+    }
+    int written = snprintf(line, lineSize, "PATPROG%u %zu ", slot, *offset);
+    for (size_t i = 0; i < chunk && written > 0 && (size_t)written + 2 < lineSize; i++) {
+        written += snprintf(line + written, lineSize - (size_t)written, "%02X", code[*offset + i]);
+    }
+    *offset += chunk;
+    return true;
+}
+
+/**
+ * @brief Compilation d'une ligne : étiquette et/ou instruction
+ * @param text Ligne du source (modifiée)
+ * @param line Numéro de la ligne
+ * @param code Bytecode produit
+ * @param size Taille de code
+ * @param length Octets déjà produits, avancé de l'instruction compilée
+ * @param error Message d'erreur
+ * @param errorSize Taille de error
+ * @return true si la ligne est valide
+ */
+static bool Compiler_Line(char *text, unsigned int line, uint8_t *code, size_t size, size_t *length,
+                          char *error, size_t errorSize)
+{
+    char *operands[COMPILER_MAX_OPERANDS + 1];
+    size_t count = 0;
+    char *comment = strchr(text, '#');
+    char *colon;
+    char *save = NULL;
+
+    if (comment != NULL) {
+        *comment = '\0';
+    }
+
+    /* Étiquette en tête de ligne */
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    colon = strchr(text, ':');
+    if (colon != NULL) {
+        char *end = colon;
+        *colon = '\0';
+        while (end > text && isspace((unsigned char)end[-1])) {
+            *--end = '\0';
+        }
+        if (!Compiler_IsLabelName(text)) {
+            snprintf(error, errorSize, "ligne %u: nom d'etiquette invalide '%s'", line, text);
+            return false;
+        }
+        if (Compiler_FindLabel(text) != NULL) {
+            snprintf(error, errorSize, "ligne %u: etiquette '%s' deja definie", line, text);
+            return false;
+        }
+        if (labelCount == COMPILER_MAX_LABELS) {
+            snprintf(error, errorSize, "ligne %u: trop d'etiquettes (%d au plus)", line, COMPILER_MAX_LABELS);
+            return false;
+        }
+        memcpy(labels[labelCount].name, text, strlen(text) + 1);     // Longueur vérifiée
+        labels[labelCount].index = (unsigned int)(*length / COMPILER_INSN_SIZE);
+        labels[labelCount].line = line;
+        labelCount++;
+        text = colon + 1;
+    }
+
+    char *name = strtok_r(text, " \t\r", &save);
+    if (name == NULL) {
+        return true;
+    }
+    const Compiler_Mnemonic *mnemonic = Compiler_FindMnemonic(name);
+    if (mnemonic == NULL) {
+        snprintf(error, errorSize, "ligne %u: instruction inconnue '%s'", line, name);
+        return false;
+    }
+
+    char *operand;
+    while ((operand = strtok_r(NULL, ", \t\r", &save)) != NULL) {
+        if (count == COMPILER_MAX_OPERANDS + 1) {
+            break;
+        }
+        operands[count++] = operand;
+    }
+
+    if (*length + COMPILER_INSN_SIZE > size) {
+        snprintf(error, errorSize, "ligne %u: programme trop long (%zu instructions au plus)",
+                 line, size / COMPILER_INSN_SIZE);
+        return false;
+    }
+    if (!Compiler_Instruction(mnemonic, operands, count, line, &code[*length],
+                              *length / COMPILER_INSN_SIZE, error, errorSize)) {
+        return false;
+    }
+    *length += COMPILER_INSN_SIZE;
+    return true;
+}
+
+/**
+ * @brief Codage d'une instruction
+ * @param mnemonic Instruction reconnue
+ * @param operands Opérandes de la ligne
+ * @param count Nombre d'opérandes
+ * @param line Numéro de la ligne
+ * @param insn Instruction produite (COMPILER_INSN_SIZE octets)
+ * @param index Numéro de l'instruction (sauts en attente)
+ * @param error Message d'erreur
+ * @param errorSize Taille de error
+ * @return true si les opérandes conviennent
+ */
+static bool Compiler_Instruction(const Compiler_Mnemonic *mnemonic, char **operands, size_t count,
+                                 unsigned int line, uint8_t *insn, size_t index,
+                                 char *error, size_t errorSize)
+{
+    size_t expected = strlen(mnemonic->operands);
+    size_t registers = 0;
+
+    if (count != expected) {
+        snprintf(error, errorSize, "ligne %u: %s attend %zu operande(s)", line, mnemonic->name, expected);
+        return false;
+    }
+
+    memset(insn, 0, COMPILER_INSN_SIZE);
+    insn[0] = mnemonic->op;
+
+    for (size_t i = 0; i < count; i++) {
+        char kind = mnemonic->operands[i];
+        int reg = Compiler_Register(operands[i]);
+        long value;
+
+        if (kind == 'l') {
+            const Compiler_Label *label = Compiler_FindLabel(operands[i]);
+            if (!Compiler_IsLabelName(operands[i])) {
+                snprintf(error, errorSize, "ligne %u: etiquette attendue, '%s'", line, operands[i]);
+                return false;
+            }
+            if (label != NULL) {
+                insn[3] = (uint8_t)label->index;
+            } else {
+                Compiler_Label *fixup = &fixups[fixupCount++];
+                memcpy(fixup->name, operands[i], strlen(operands[i]) + 1);
+                fixup->index = (unsigned int)index;
+                fixup->line = line;
+            }
+        } else if (reg >= 0 && (kind == 'r' || kind == 'x')) {
+            insn[1 + registers++] = (uint8_t)reg;
+        } else if (kind == 'r') {
+            snprintf(error, errorSize, "ligne %u: registre r0 a r%d attendu, '%s'",
+                     line, COMPILER_REGISTERS - 1, operands[i]);
+            return false;
+        } else if (!Compiler_Number(operands[i], &value) || value < 0 || value > 0xFFFF) {
+            snprintf(error, errorSize, "ligne %u: valeur de 0 a 65535 attendue, '%s'", line, operands[i]);
+            return false;
+        } else {
+            if (kind == 'x') {
+                insn[0] = mnemonic->opImm;
+            }
+            if (!Compiler_CheckImmediate(insn[0], value, line, error, errorSize)) {
+                return false;
+            }
+            insn[2] = (uint8_t)(value >> 8);
+            insn[3] = (uint8_t)value;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Bornes des valeurs immédiates contrôlées par le firmware
+ * @param op Code de l'instruction
+ * @param value Valeur immédiate
+ * @param line Numéro de la ligne
+ * @param error Message d'erreur
+ * @param errorSize Taille de error
+ * @return true si la valeur est acceptée
+ */
+static bool Compiler_CheckImmediate(uint8_t op, long value, unsigned int line, char *error, size_t errorSize)
+{
+    if (op == COMPILER_OP_SHOWI && value > COMPILER_LED_MASK) {
+        snprintf(error, errorSize, "ligne %u: masque de LED de 0 a %d", line, COMPILER_LED_MASK);
+        return false;
+    }
+    if (op == COMPILER_OP_WAIT && value < 1) {
+        snprintf(error, errorSize, "ligne %u: wait attend au moins 1 etape", line);
+        return false;
+    }
+    if (op == COMPILER_OP_PERIODI && (value < COMPILER_PERIOD_MIN_MS || value > COMPILER_PERIOD_MAX_MS)) {
+        snprintf(error, errorSize, "ligne %u: periode de %d a %d ms", line,
+                 COMPILER_PERIOD_MIN_MS, COMPILER_PERIOD_MAX_MS);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Recherche d'une instruction par son nom (insensible à la casse)
+ * @param name Nom lu
+ * @return Instruction, NULL si elle n'existe pas
+ */
+static const Compiler_Mnemonic* Compiler_FindMnemonic(const char *name)
+{
+    for (size_t i = 0; i < MNEMONIC_COUNT; i++) {
+        if (strcasecmp(name, MNEMONICS[i].name) == 0) {
+            return &MNEMONICS[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Lecture d'un registre (r0 à r7)
+ * @param text Opérande
+ * @return Numéro du registre, -1 si ce n'en est pas un
+ */
+static int Compiler_Register(const char *text)
+{
+    if ((text[0] == 'r' || text[0] == 'R') && text[1] >= '0' &&
+        text[1] < '0' + COMPILER_REGISTERS && text[2] == '\0') {
+        return text[1] - '0';
+    }
+    return -1;
+}
+
+/**
+ * @brief Lecture d'un nombre : décimal, 0x hexadécimal ou 0b binaire
+ * @param text Opérande
+ * @param value Valeur lue
+ * @return true si l'opérande est un nombre complet
+ */
+static bool Compiler_Number(const char *text, long *value)
+{
+    int base = 10;
+    char *end;
+
+    if (text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base = 16;
+        text += 2;
+    } else if (text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+        base = 2;
+        text += 2;
+    }
+    if (!isxdigit((unsigned char)text[0])) {
+        return false;
+    }
+    *value = strtol(text, &end, base);
+    return *end == '\0';
+}
+
+/**
+ * @brief Vérification d'un nom d'étiquette (lettre ou _, puis lettres,
+ *        chiffres ou _ ; pas un nom de registre)
+ * @param text Nom lu
+ * @return true si le nom est valide
+ */
+static bool Compiler_IsLabelName(const char *text)
+{
+    size_t length = strlen(text);
+
+    if (length == 0 || length >= COMPILER_LABEL_SIZE || Compiler_Register(text) >= 0 ||
+        !(isalpha((unsigned char)text[0]) || text[0] == '_')) {
+        return false;
+    }
+    for (size_t i = 1; i < length; i++) {
+        if (!(isalnum((unsigned char)text[i]) || text[i] == '_')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Recherche d'une étiquette définie
+ * @param name Nom de l'étiquette
+ * @return Étiquette, NULL si elle n'est pas (encore) définie
+ */
+static const Compiler_Label* Compiler_FindLabel(const char *name)
+{
+    for (size_t i = 0; i < labelCount; i++) {
+        if (strcmp(labels[i].name, name) == 0) {
+            return &labels[i];
+        }
+    }
+    return NULL;
+}
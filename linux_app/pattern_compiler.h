@@ -0,0 +1,83 @@
+#ifndef PATTERN_COMPILER_H
+#define PATTERN_COMPILER_H
+
+/**
+ * @file pattern_compiler.h
+ * @brief En-tête du compilateur de programmes de chenillard
+ * @author
+ * @date 07-04-2025
+ *
+ * Un programme de chenillard est écrit en texte (une instruction par ligne)
+ * et compilé en bytecode pour la machine virtuelle du firmware, chargé par
+ * la commande PATPROG. Le jeu d'instructions est défini à l'identique de
+ * pattern_controller.h côté firmware.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Taille du bytecode (PATTERN_PROGRAM_SIZE, PATTERN_VM_INSN_SIZE, PATTERN_VM_REGISTERS) */
+#define COMPILER_PROGRAM_SIZE   128
+#define COMPILER_INSN_SIZE      4       // [code, a, b, c], immédiat sur b et c
+#define COMPILER_REGISTERS      8
+
+/* Codes des instructions (Pattern_VmOpcode) */
+#define COMPILER_OP_SET         0x01    // set rA, imm
+#define COMPILER_OP_MOV         0x02    // mov rA, rB
+#define COMPILER_OP_ADD         0x03    // add rA, rB
+#define COMPILER_OP_ADDI        0x04    // add rA, imm
+#define COMPILER_OP_ANDI        0x05    // and rA, imm
+#define COMPILER_OP_XORI        0x06    // xor rA, imm
+#define COMPILER_OP_SHLI        0x07    // shl rA, imm
+#define COMPILER_OP_SHRI        0x08    // shr rA, imm
+#define COMPILER_OP_RAND        0x09    // rand rA, imm
+#define COMPILER_OP_LEDS        0x0A    // leds rA
+#define COMPILER_OP_SHOW        0x0B    // show rA
+#define COMPILER_OP_SHOWI       0x0C    // show imm
+#define COMPILER_OP_WAIT        0x0D    // wait imm
+#define COMPILER_OP_PERIOD      0x0E    // period rA
+#define COMPILER_OP_PERIODI     0x0F    // period imm
+#define COMPILER_OP_JMP         0x10    // jmp label
+#define COMPILER_OP_JZ          0x11    // jz rA, label
+#define COMPILER_OP_JNZ         0x12    // jnz rA, label
+#define COMPILER_OP_JLT         0x13    // jlt rA, rB, label
+#define COMPILER_OP_DJNZ        0x14    // djnz rA, label
+#define COMPILER_OP_HALT        0x15    // halt
+
+/* Bornes vérifiées par le firmware (masque des LED, PATTERN_PERIOD_*_MS) */
+#define COMPILER_LED_MASK       0x07
+#define COMPILER_PERIOD_MIN_MS  1
+#define COMPILER_PERIOD_MAX_MS  60000
+
+/**
+ * @brief Compilation d'un programme de chenillard
+ * @note Une instruction par ligne ; "nom:" définit une étiquette, "#"
+ *       commence un commentaire. Registres r0 à r7, nombres en décimal,
+ *       0x (hexadécimal) ou 0b (binaire).
+ * @param source Texte du programme (terminé par un caractère nul)
+ * @param code Bytecode produit
+ * @param size Taille de code (octets)
+ * @param length Octets de bytecode produits
+ * @param error Message d'erreur, avec le numéro de ligne
+ * @param errorSize Taille de error
+ * @return true si le programme est compilé, false sinon
+ */
+bool Compiler_Compile(const char *source, uint8_t *code, size_t size, size_t *length,
+                      char *error, size_t errorSize);
+
+/**
+ * @brief Découpage du bytecode en commandes PATPROG
+ * @param slot Emplacement visé (PAT4 à PAT7)
+ * @param code Bytecode compilé
+ * @param length Octets de bytecode
+ * @param offset Octets déjà émis (0 pour la première ligne), avancé
+ * @param line Commande produite ("PATPROG<n> <offset> <hex>" ou
+ *        "PATPROG<n> END" après le dernier morceau)
+ * @param lineSize Taille de line
+ * @return false quand toutes les commandes ont été produites
+ */
+bool Compiler_NextCommand(unsigned int slot, const uint8_t *code, size_t length, size_t *offset,
+                          char *line, size_t lineSize);
+
+#endif /* PATTERN_COMPILER_H */
@@ -18,12 +18,22 @@
  * 
  * Ce fichier implémente les fonctions pour la gestion de la communication
  * série avec le microcontrôleur STM32F756ZG.
+ *
+ * Deux modes d'échange partagent le même buffer de réception : la console
+ * ASCII (lignes terminées par [END]) et le mode binaire tramé, plus
+ * compact, destiné à l'automatisation (Serial_SendFrame/Serial_ReceiveFrame).
  */
 
 /* Variables privées */
 static int serialFd = -1;
 static struct termios oldtio;
 static const int DEFAULT_BAUDRATE = B115200;
+static char rxBuffer[1024];         // Octets reçus pas encore découpés en lignes
+static size_t rxLength = 0;
+
+/* Prototypes de fonctions privées */
+static int Serial_WaitReadable(const struct timeval *start);
+static bool Serial_ExtractFrame(uint8_t *opcode, uint8_t *payload, size_t size, size_t *length);
 
 /**
  * @brief Initialisation du module de communication série
@@ -31,6 +41,7 @@ static const int DEFAULT_BAUDRATE = B115200;
 void Serial_Init(void)
 {
     serialFd = -1;
+    rxLength = 0;
 }
 
 /**
@@ -69,6 +80,7 @@ bool Serial_Open(const char *port)
     
     // Vidage des buffers
     tcflush(serialFd, TCIOFLUSH);
+    rxLength = 0;
     
     return true;
 }
@@ -120,7 +132,7 @@ bool Serial_SendCommand(const char *command)
  * @brief Réception d'une réponse du microcontrôleur
  * @param response Buffer pour stocker la réponse
  * @param size Taille du buffer
- * @return true si la réception a réussi, false sinon
+ * @return true si une réponse complète a été reçue, false sinon
  */
 bool Serial_ReceiveResponse(char *response, size_t size)
 {
@@ -129,58 +141,334 @@ bool Serial_ReceiveResponse(char *response, size_t size)
     }
 
     memset(response, 0, size);
-    size_t totalBytesRead = 0;
-    ssize_t bytesReadNow = 0;
-    fd_set readfds;
-    struct timeval timeout;
-    bool keepReading = true;
+    size_t totalLength = 0;
+    char line[256];
+    struct timeval start;
+    gettimeofday(&start, NULL);
 
-    while (keepReading && totalBytesRead < size - 1) {
-        FD_ZERO(&readfds);
-        FD_SET(serialFd, &readfds);
+    while (true) {
+        // Découpage de ce qui est déjà reçu
+        SerialLineType type;
+        while ((type = Serial_NextLine(line, sizeof(line))) != SERIAL_LINE_NONE) {
+            if (type == SERIAL_LINE_END) {
+                return true;
+            }
+            if (type == SERIAL_LINE_TEXT && totalLength < size - 1) {
+                int written = snprintf(response + totalLength, size - totalLength, "%s%s",
+                                       (totalLength > 0) ? "\n" : "", line);
+                if (written > 0) {
+                    totalLength += (size_t)written;
+                    if (totalLength > size - 1) {
+                        totalLength = size - 1;
+                    }
+                }
+            }
+        }
 
-        // Timeout court (ex: 50ms) pour détecter la fin de la transmission
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 50 * 1000; // 50 ms
+        // Attente de nouveaux octets jusqu'au délai d'abandon
+        if (Serial_WaitReadable(&start) <= 0 || Serial_Poll() < 0) {
+            return false;
+        }
+    }
+}
 
-        int selectResult = select(serialFd + 1, &readfds, NULL, NULL, &timeout);
+/**
+ * @brief Calcul du CRC-16/CCITT d'une suite d'octets
+ * @param data Octets
+ * @param length Nombre d'octets
+ * @return CRC (valeur initiale 0xFFFF)
+ */
+uint16_t Serial_Crc16(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
 
-        if (selectResult < 0) { // Erreur select
-            perror("Erreur select() en lecture série");
+/**
+ * @brief Passage du microcontrôleur en mode binaire
+ * @return true si le microcontrôleur est passé en mode binaire
+ */
+bool Serial_EnterBinaryMode(void)
+{
+    char response[256];
+
+    if (!Serial_SendCommand(SERIAL_BINARY_COMMAND) ||
+        !Serial_ReceiveResponse(response, sizeof(response))) {
+        return false;
+    }
+    return strncmp(response, "[OK]", 4) == 0;
+}
+
+/**
+ * @brief Retour du microcontrôleur à la console ASCII (trame SERIAL_OP_ASCII)
+ * @return true si le microcontrôleur a confirmé le retour
+ */
+bool Serial_LeaveBinaryMode(void)
+{
+    uint8_t opcode;
+    uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+    size_t length;
+
+    if (!Serial_SendFrame(SERIAL_OP_ASCII, NULL, 0) ||
+        !Serial_ReceiveFrame(&opcode, payload, sizeof(payload), &length)) {
+        return false;
+    }
+    return opcode == (SERIAL_OP_ASCII | SERIAL_FRAME_REPLY_FLAG) &&
+           length > 0 && payload[0] == SERIAL_STATUS_OK;
+}
+
+/**
+ * @brief Envoi d'une trame binaire
+ * @param opcode Code d'opération
+ * @param payload Données (NULL si length vaut 0)
+ * @param length Nombre d'octets de données
+ * @return true si l'envoi a réussi, false sinon
+ */
+bool Serial_SendFrame(uint8_t opcode, const uint8_t *payload, size_t length)
+{
+    uint8_t frame[SERIAL_FRAME_MAX_PAYLOAD + SERIAL_FRAME_OVERHEAD];
+
+    if (serialFd < 0 || length > SERIAL_FRAME_MAX_PAYLOAD || (length > 0 && payload == NULL)) {
+        return false;
+    }
+
+    frame[0] = SERIAL_FRAME_SYNC;
+    frame[1] = opcode;
+    frame[2] = (uint8_t)length;
+    if (length > 0) {
+        memcpy(frame + 3, payload, length);
+    }
+    uint16_t crc = Serial_Crc16(frame + 1, length + 2);
+    frame[3 + length] = (uint8_t)(crc >> 8);
+    frame[4 + length] = (uint8_t)(crc & 0xFF);
+
+    size_t size = length + SERIAL_FRAME_OVERHEAD;
+    ssize_t bytesWritten = write(serialFd, frame, size);
+    if (bytesWritten < 0 || (size_t)bytesWritten != size) {
+        perror("Erreur lors de l'envoi de la trame");
+        return false;
+    }
+
+    tcdrain(serialFd);
+    return true;
+}
+
+/**
+ * @brief Réception d'une trame binaire
+ * @param opcode Code d'opération reçu
+ * @param payload Buffer pour les données
+ * @param size Taille du buffer
+ * @param length Nombre d'octets de données reçus
+ * @return true si une trame valide a été reçue, false sinon
+ */
+bool Serial_ReceiveFrame(uint8_t *opcode, uint8_t *payload, size_t size, size_t *length)
+{
+    if (serialFd < 0 || opcode == NULL || payload == NULL || length == NULL) {
+        return false;
+    }
+
+    struct timeval start;
+    gettimeofday(&start, NULL);
+
+    while (!Serial_ExtractFrame(opcode, payload, size, length)) {
+        if (Serial_WaitReadable(&start) <= 0 || Serial_Poll() < 0) {
             return false;
-        } else if (selectResult == 0) { // Timeout -> Fin de la réponse
-            keepReading = false;
-        } else { // Données disponibles
-            bytesReadNow = read(serialFd, response + totalBytesRead, size - 1 - totalBytesRead);
-
-            if (bytesReadNow < 0) { // Erreur lecture
-                // EAGAIN ou EWOULDBLOCK signifie juste pas de données maintenant, mais select dit qu'il y en a?
-                // C'est étrange, mais on peut considérer que c'est la fin pour l'instant.
-                if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                    keepReading = false;
-                } else {
-                    perror("Erreur read() en lecture série");
-                    return false;
-                }
-            } else if (bytesReadNow == 0) { // EOF (port fermé?)
-                 keepReading = false; // Probablement la fin
-            } else { // Données lues
-                totalBytesRead += bytesReadNow;
-                // On continue de lire tant que select trouve des données rapidement
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Descripteur du port série (pour la boucle d'événements)
+ * @return Descripteur ouvert, ou -1 si le port est fermé
+ */
+int Serial_GetFd(void)
+{
+    return serialFd;
+}
+
+/**
+ * @brief Lecture non bloquante des octets disponibles sur le port
+ * @return Nombre d'octets lus, 0 si rien n'est disponible, -1 si le port
+ *         est fermé ou en erreur
+ */
+int Serial_Poll(void)
+{
+    if (serialFd < 0) {
+        return -1;
+    }
+
+    int total = 0;
+    while (rxLength < sizeof(rxBuffer)) {
+        ssize_t bytesRead = read(serialFd, rxBuffer + rxLength, sizeof(rxBuffer) - rxLength);
+        if (bytesRead < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                break;
             }
+            perror("Erreur read() en lecture série");
+            return -1;
         }
+        if (bytesRead == 0) {
+            // Port fermé (carte débranchée) : signalé seulement si rien n'a été lu
+            return (total > 0) ? total : -1;
+        }
+        rxLength += (size_t)bytesRead;
+        total += (int)bytesRead;
     }
 
-    // Assurer la terminaison nulle
-    response[totalBytesRead] = '\0';
+    return total;
+}
+
+/**
+ * @brief Extraction du prochain élément complet du flux reçu
+ * @note  Une ligne se termine par \n (le \r éventuel est retiré). Le prompt
+ *        n'étant pas suivi d'un retour à la ligne, il est reconnu dès qu'il
+ *        se trouve en tête du buffer. La ligne SERIAL_REPLY_END (ou sa
+ *        forme numérotée "[END#n]") est rendue comme SERIAL_LINE_END.
+ * @param line Buffer pour stocker la ligne (vide pour un prompt)
+ * @param size Taille du buffer
+ * @return Type de l'élément extrait, SERIAL_LINE_NONE si rien n'est complet
+ */
+SerialLineType Serial_NextLine(char *line, size_t size)
+{
+    if (line == NULL || size == 0 || rxLength == 0) {
+        return SERIAL_LINE_NONE;
+    }
+    line[0] = '\0';
 
-    // Nettoyer les \r ou \n finaux si présents (optionnel, mais propre)
-    while (totalBytesRead > 0 && (response[totalBytesRead - 1] == '\n' || response[totalBytesRead - 1] == '\r')) {
-        response[--totalBytesRead] = '\0';
+    // Prompt en tête du buffer
+    size_t promptLen = strlen(SERIAL_PROMPT);
+    if (rxLength >= promptLen && memcmp(rxBuffer, SERIAL_PROMPT, promptLen) == 0) {
+        memmove(rxBuffer, rxBuffer + promptLen, rxLength - promptLen);
+        rxLength -= promptLen;
+        return SERIAL_LINE_PROMPT;
     }
 
-    // Retourner true si on a lu au moins quelque chose
-    return (totalBytesRead > 0);
+    // Recherche de la fin de ligne ; un buffer plein est rendu tel quel
+    char *newline = memchr(rxBuffer, '\n', rxLength);
+    size_t consumed;
+    size_t lineLen;
+    if (newline != NULL) {
+        lineLen = (size_t)(newline - rxBuffer);
+        consumed = lineLen + 1;
+    } else if (rxLength == sizeof(rxBuffer)) {
+        lineLen = rxLength;
+        consumed = rxLength;
+    } else {
+        return SERIAL_LINE_NONE;
+    }
+
+    while (lineLen > 0 && rxBuffer[lineLen - 1] == '\r') {
+        lineLen--;
+    }
+    if (lineLen > size - 1) {
+        lineLen = size - 1;
+    }
+    memcpy(line, rxBuffer, lineLen);
+    line[lineLen] = '\0';
+
+    memmove(rxBuffer, rxBuffer + consumed, rxLength - consumed);
+    rxLength -= consumed;
+    // "[END]" ou "[END#n]" pour une commande numérotée
+    size_t endLen = strlen(SERIAL_REPLY_END) - 1;
+    if (strncmp(line, SERIAL_REPLY_END, endLen) == 0 && (line[endLen] == ']' || line[endLen] == '#')) {
+        return SERIAL_LINE_END;
+    }
+    return SERIAL_LINE_TEXT;
+}
+
+/**
+ * @brief Attente d'octets sur le port jusqu'au délai d'abandon
+ * @param start Instant de début de l'attente
+ * @return 1 si des octets sont disponibles, 0 si le délai
+ *         SERIAL_RESPONSE_TIMEOUT_MS est écoulé, -1 en cas d'erreur
+ */
+static int Serial_WaitReadable(const struct timeval *start)
+{
+    while (true) {
+        // Temps restant avant abandon
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        long elapsedMs = (now.tv_sec - start->tv_sec) * 1000L + (now.tv_usec - start->tv_usec) / 1000L;
+        if (elapsedMs >= SERIAL_RESPONSE_TIMEOUT_MS) {
+            return 0;
+        }
+
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(serialFd, &readfds);
+        struct timeval timeout;
+        timeout.tv_sec = (SERIAL_RESPONSE_TIMEOUT_MS - elapsedMs) / 1000;
+        timeout.tv_usec = ((SERIAL_RESPONSE_TIMEOUT_MS - elapsedMs) % 1000) * 1000;
+
+        int selectResult = select(serialFd + 1, &readfds, NULL, NULL, &timeout);
+        if (selectResult < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("Erreur select() en lecture série");
+            return -1;
+        }
+        if (selectResult > 0) {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief Extraction d'une trame complète du buffer de réception
+ * @note  Les octets qui précèdent un SYNC sont abandonnés ; sur une
+ *        longueur impossible ou un CRC faux, seul le SYNC est abandonné et
+ *        la recherche reprend à l'octet suivant.
+ * @param opcode Code d'opération reçu
+ * @param payload Buffer pour les données
+ * @param size Taille du buffer
+ * @param length Nombre d'octets de données reçus
+ * @return true si une trame valide a été extraite, false sinon
+ */
+static bool Serial_ExtractFrame(uint8_t *opcode, uint8_t *payload, size_t size, size_t *length)
+{
+    while (rxLength > 0) {
+        const uint8_t *bytes = (const uint8_t *)rxBuffer;
+        const uint8_t *sync = memchr(bytes, SERIAL_FRAME_SYNC, rxLength);
+        size_t skip = (sync != NULL) ? (size_t)(sync - bytes) : rxLength;
+        if (skip > 0) {
+            memmove(rxBuffer, rxBuffer + skip, rxLength - skip);
+            rxLength -= skip;
+            continue;
+        }
+
+        if (rxLength < 3) {
+            return false;
+        }
+        size_t frameLength = bytes[2];
+        size_t frameSize = frameLength + SERIAL_FRAME_OVERHEAD;
+        if (frameLength <= SERIAL_FRAME_MAX_PAYLOAD) {
+            if (rxLength < frameSize) {
+                return false;
+            }
+            uint16_t crc = ((uint16_t)bytes[3 + frameLength] << 8) | bytes[4 + frameLength];
+            if (crc == Serial_Crc16(bytes + 1, frameLength + 2) && frameLength <= size) {
+                *opcode = bytes[1];
+                *length = frameLength;
+                memcpy(payload, bytes + 3, frameLength);
+                memmove(rxBuffer, rxBuffer + frameSize, rxLength - frameSize);
+                rxLength -= frameSize;
+                return true;
+            }
+        }
+
+        // Faux SYNC ou trame corrompue
+        memmove(rxBuffer, rxBuffer + 1, rxLength - 1);
+        rxLength--;
+    }
+    return false;
 }
 
 /**
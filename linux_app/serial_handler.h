@@ -12,6 +12,58 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Prompt envoyé par le microcontrôleur après chaque réponse (pour un terminal) */
+#define SERIAL_PROMPT "STM32> "
+
+/* Ligne qui termine chaque réponse du microcontrôleur ("[END#n]" pour une
+ * commande numérotée, voir command_pipeline.h) */
+#define SERIAL_REPLY_END "[END]"
+
+/* Délai maximal d'attente d'une réponse complète */
+#define SERIAL_RESPONSE_TIMEOUT_MS 1000
+
+/* Mode binaire : trames SYNC | OPCODE | LONGUEUR | DONNEES | CRC16 (MSB en
+ * premier), CRC-16/CCITT (0x1021, init 0xFFFF) sur OPCODE, LONGUEUR et
+ * DONNEES. Doit rester identique à frame_protocol.h côté firmware. */
+#define SERIAL_BINARY_COMMAND   "BINARY"    // Poignée de main (console ASCII)
+#define SERIAL_FRAME_SYNC       0xA5
+#define SERIAL_FRAME_MAX_PAYLOAD 32
+#define SERIAL_FRAME_OVERHEAD   5           // SYNC, OPCODE, LONGUEUR et CRC
+#define SERIAL_FRAME_REPLY_FLAG 0x80        // Bit ajouté à l'opcode des réponses
+
+/* Codes d'opération */
+#define SERIAL_OP_LED       0x01    // [led (1-3), état (0/1)]
+#define SERIAL_OP_PATTERN   0x02    // [chenillard (1-3)]
+#define SERIAL_OP_FREQ      0x03    // [fréquence (1-3)] ou [période ms (16 bits)]
+#define SERIAL_OP_STOP      0x04    // []
+#define SERIAL_OP_STATUS    0x05    // [] -> [statut, LED1, LED2, LED3, chenillard, fréquence (0 : libre), période ms (16 bits)]
+#define SERIAL_OP_LEDS      0x06    // [masque (bit 0 : LED1)]
+#define SERIAL_OP_PATDEF    0x07    // [chenillard, masque étape 1, ...]
+#define SERIAL_OP_PLAYBACK  0x08    // [lecture (0 : CPU, 1 : DMA)]
+#define SERIAL_OP_DIM       0x09    // [led (1-3), niveau (0-255)]
+#define SERIAL_OP_FADE      0x0A    // [led (1-3), niveau (0-255), durée ms (16 bits)]
+#define SERIAL_OP_PATFADE   0x0B    // [fondu des étapes (0/1)]
+#define SERIAL_OP_ASCII     0x7F    // [] : retour à la console ASCII
+#define SERIAL_OP_NAK       0x80    // Réponse à une trame corrompue (code 0x00 réservé)
+
+/* Codes de statut (premier octet des réponses) */
+#define SERIAL_STATUS_OK        0x00
+#define SERIAL_STATUS_CRC       0x01
+#define SERIAL_STATUS_OPCODE    0x02
+#define SERIAL_STATUS_LENGTH    0x03
+#define SERIAL_STATUS_ARGUMENT  0x04
+#define SERIAL_STATUS_FAILED    0x05
+
+/* Type d'élément extrait du flux reçu */
+typedef enum {
+    SERIAL_LINE_NONE = 0,   // Aucune ligne complète disponible
+    SERIAL_LINE_TEXT,       // Ligne de texte (sans \r\n final)
+    SERIAL_LINE_END,        // Marqueur de fin de réponse
+    SERIAL_LINE_PROMPT      // Prompt du microcontrôleur
+} SerialLineType;
 
 /**
  * @brief Initialisation du module de communication série
@@ -39,12 +91,81 @@ bool Serial_SendCommand(const char *command);
 
 /**
  * @brief Réception d'une réponse du microcontrôleur
+ * @note  La réception se termine dès la ligne SERIAL_REPLY_END ; le délai
+ *        SERIAL_RESPONSE_TIMEOUT_MS ne sert qu'en cas d'absence de réponse.
+ *        Les lignes sont séparées par \n dans le buffer.
  * @param response Buffer pour stocker la réponse
  * @param size Taille du buffer
  * @return true si la réception a réussi, false sinon
  */
 bool Serial_ReceiveResponse(char *response, size_t size);
 
+/**
+ * @brief Descripteur du port série (pour la boucle d'événements)
+ * @return Descripteur ouvert, ou -1 si le port est fermé
+ */
+int Serial_GetFd(void);
+
+/**
+ * @brief Lecture non bloquante des octets disponibles sur le port
+ * @note  Les octets sont accumulés dans un buffer interne et découpés
+ *        ensuite par Serial_NextLine().
+ * @return Nombre d'octets lus, 0 si rien n'est disponible, -1 si le port
+ *         est fermé ou en erreur
+ */
+int Serial_Poll(void);
+
+/**
+ * @brief Extraction du prochain élément complet du flux reçu
+ * @param line Buffer pour stocker la ligne (vide pour un prompt)
+ * @param size Taille du buffer
+ * @return Type de l'élément extrait, SERIAL_LINE_NONE si rien n'est complet
+ */
+SerialLineType Serial_NextLine(char *line, size_t size);
+
+/**
+ * @brief Calcul du CRC-16/CCITT d'une suite d'octets
+ * @param data Octets
+ * @param length Nombre d'octets
+ * @return CRC (valeur initiale 0xFFFF)
+ */
+uint16_t Serial_Crc16(const uint8_t *data, size_t length);
+
+/**
+ * @brief Passage du microcontrôleur en mode binaire
+ * @note  Envoie SERIAL_BINARY_COMMAND et attend sa réponse [OK] complète :
+ *        les trames ne doivent être envoyées qu'ensuite.
+ * @return true si le microcontrôleur est passé en mode binaire
+ */
+bool Serial_EnterBinaryMode(void);
+
+/**
+ * @brief Retour du microcontrôleur à la console ASCII (trame SERIAL_OP_ASCII)
+ * @return true si le microcontrôleur a confirmé le retour
+ */
+bool Serial_LeaveBinaryMode(void);
+
+/**
+ * @brief Envoi d'une trame binaire
+ * @param opcode Code d'opération
+ * @param payload Données (NULL si length vaut 0)
+ * @param length Nombre d'octets de données (SERIAL_FRAME_MAX_PAYLOAD au plus)
+ * @return true si l'envoi a réussi, false sinon
+ */
+bool Serial_SendFrame(uint8_t opcode, const uint8_t *payload, size_t length);
+
+/**
+ * @brief Réception d'une trame binaire
+ * @note  Les octets précédant le SYNC et les trames dont le CRC est faux
+ *        sont ignorés. Attente limitée à SERIAL_RESPONSE_TIMEOUT_MS.
+ * @param opcode Code d'opération reçu
+ * @param payload Buffer pour les données
+ * @param size Taille du buffer
+ * @param length Nombre d'octets de données reçus
+ * @return true si une trame valide a été reçue, false sinon
+ */
+bool Serial_ReceiveFrame(uint8_t *opcode, uint8_t *payload, size_t size, size_t *length);
+
 /**
  * @brief Configuration du port série
  * @param baudrate Vitesse de communication
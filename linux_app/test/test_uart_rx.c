@@ -0,0 +1,431 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "main.h"
+#include "usart.h"
+#include "Modules/module_wrappers.h"
+#include "Modules/ring_buffer.h"
+#include "Modules/uart_handler.h"
+#include "../vboard/vboard.h"
+
+/**
+ * @file test_uart_rx.c
+ * @brief Rejeu de flux reçus à travers la réception UART du firmware
+ * @author
+ * @date 07-04-2025
+ *
+ * Les modules du firmware sont compilés avec la HAL de la carte virtuelle
+ * (horloge à événements discrets), comme bench_micro. Des flux d'octets
+ * sont envoyés sur la ligne émulée ; le DMA circulaire les écrit dans le
+ * buffer de réception (Ring_Buffer) et la boucle principale est remplacée
+ * par des appels explicites à COMMAND_Process (UART_ProcessReceived puis
+ * Command_Parser_ProcessBuffer et l'exécution). Les réponses émises sont
+ * relues sur un tube : chaque scénario vérifie la suite exacte des
+ * étiquettes [OK#n]/[ERR#n] obtenues.
+ *
+ * Scénarios :
+ * - ring.spans : plages contiguës d'un Ring_Buffer de 8 octets à cheval
+ *   sur la fin de la zone, écriture tronquée, buffer plein ;
+ * - rx.wrap : lignes coupées par la fin du buffer DMA, lues en deux
+ *   plages, sur plusieurs tours ;
+ * - rx.lap : plus d'un tour de retard de la boucle principale (octets
+ *   écrasés), débordement signalé puis reprise sur la ligne suivante ;
+ * - rx.error : erreur de trame avec des octets publiés, puis avec des
+ *   octets encore seulement écrits par le DMA : ils sont analysés avant le
+ *   saut de la fin du tour, et rien de ce qui reste dans le buffer n'est
+ *   relu ;
+ * - rx.error2 : deux erreurs avant le passage de la boucle principale.
+ */
+
+#define TEST_OUTPUT_MAX     16384
+#define TEST_TAGS_MAX       256
+#define TEST_SETTLE_NS      2000000ull      // Détection de la ligne inactive (IDLE)
+
+/* Initialisation de l'UART (uart_handler.c, déclarée comme dans main.c) */
+bool UART_Init(void);
+
+/* Variables privées */
+static int replyFd = -1;
+static char output[TEST_OUTPUT_MAX];
+static size_t outputLength = 0;
+static int failures = 0;
+
+/* Prototypes de fonctions privées */
+static void Test_Check(bool condition, const char *scenario, const char *what);
+static void Test_Advance(uint64_t ns);
+static void Test_Send(const char *text);
+static void Test_Arrive(const char *text);
+static void Test_Process(void);
+static void Test_Collect(void);
+static bool Test_ExpectTags(const char *scenario, const char *expected);
+static void Test_RingSpans(void);
+static void Test_RxWrap(void);
+static void Test_RxLap(void);
+static void Test_RxError(void);
+static void Test_RxDoubleError(void);
+
+/**
+ * @brief Point d'entrée des tests
+ * @return EXIT_FAILURE si un scénario échoue
+ */
+int main(void)
+{
+    int fds[2];
+
+    if (pipe(fds) < 0) {
+        perror("pipe");
+        return EXIT_FAILURE;
+    }
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    replyFd = fds[0];
+
+    /* Même séquence que main.c, sur l'horloge à événements discrets */
+    Vboard_ClockSelect(VBOARD_CLOCK_DISCRETE, 1);
+    Vboard_Init(-1, fds[1], false);
+    CLOCK_Init();
+    EVENT_Init();
+    PROFILE_Init();
+    LED_Init();
+    PATTERN_Init();
+    TIMER_Init();
+    if (!UART_Init()) {
+        fprintf(stderr, "Erreur: initialisation de l'UART\n");
+        return EXIT_FAILURE;
+    }
+    COMMAND_Init();
+
+    /* Bannière et invite de démarrage */
+    Test_Advance(TEST_SETTLE_NS);
+    Test_Collect();
+
+    Test_RingSpans();
+    Test_RxWrap();
+    Test_RxLap();
+    Test_RxError();
+    Test_RxDoubleError();
+
+    if (failures != 0) {
+        fprintf(stderr, "%d échec(s)\n", failures);
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "Tous les scénarios de réception sont passés\n");
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Vérification d'une condition
+ * @param condition Résultat attendu vrai
+ * @param scenario Nom du scénario
+ * @param what Description de la vérification
+ */
+static void Test_Check(bool condition, const char *scenario, const char *what)
+{
+    if (!condition) {
+        fprintf(stderr, "ECHEC %-10s %s\n", scenario, what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Avance du temps virtuel, interruptions servies
+ * @param ns Durée (ns)
+ */
+static void Test_Advance(uint64_t ns)
+{
+    uint64_t target = Vboard_Now() + ns;
+
+    while (Vboard_Now() < target) {
+        HAL_GetTick();
+    }
+}
+
+/**
+ * @brief Envoi d'octets à la carte, sans attendre leur arrivée
+ * @param text Octets envoyés
+ */
+static void Test_Send(const char *text)
+{
+    if (!Vboard_Inject((const uint8_t *)text, strlen(text))) {
+        fprintf(stderr, "Erreur: file de réception pleine\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Envoi d'octets, attente de leur arrivée et de la ligne inactive
+ * @note La boucle principale ne tourne pas : les octets restent dans le
+ *       buffer de réception jusqu'au prochain Test_Process.
+ * @param text Octets envoyés
+ */
+static void Test_Arrive(const char *text)
+{
+    Test_Send(text);
+    while (Vboard_RxPending() != 0) {
+        HAL_GetTick();
+    }
+    Test_Advance(TEST_SETTLE_NS);
+}
+
+/**
+ * @brief Passage de la boucle principale, puis émission des réponses
+ * @note L'émission DMA enchaîne ses transferts depuis HAL_UART_TxCpltCallback :
+ *       l'émetteur libre, toutes les réponses sont sur le tube.
+ */
+static void Test_Process(void)
+{
+    COMMAND_Process();
+    while (huart3.gState != HAL_UART_STATE_READY) {
+        HAL_GetTick();
+    }
+    Test_Collect();
+}
+
+/**
+ * @brief Lecture des réponses émises depuis le dernier appel
+ */
+static void Test_Collect(void)
+{
+    ssize_t result;
+
+    while (outputLength < sizeof(output) - 1 &&
+           (result = read(replyFd, output + outputLength,
+                          sizeof(output) - 1 - outputLength)) > 0) {
+        outputLength += (size_t)result;
+    }
+    output[outputLength] = '\0';
+}
+
+/**
+ * @brief Comparaison des étiquettes reçues avec la suite attendue
+ * @note Seules les étiquettes [OK#n] et [ERR#n] sont relevées ; la sortie
+ *       est vidée après la comparaison.
+ * @param scenario Nom du scénario
+ * @param expected Étiquettes attendues, séparées par des espaces
+ *        ("OK#1 ERR#2")
+ * @return true si les suites sont identiques
+ */
+static bool Test_ExpectTags(const char *scenario, const char *expected)
+{
+    char tags[TEST_TAGS_MAX * 12];
+    size_t length = 0;
+    const char *cursor = output;
+
+    tags[0] = '\0';
+    while ((cursor = strchr(cursor, '[')) != NULL) {
+        unsigned int sequence;
+        char kind[4];
+
+        if (sscanf(cursor, "[%3[A-Z]#%u]", kind, &sequence) == 2 &&
+            (strcmp(kind, "OK") == 0 || strcmp(kind, "ERR") == 0)) {
+            length += (size_t)snprintf(tags + length, sizeof(tags) - length, "%s%s#%u",
+                                       (length != 0) ? " " : "", kind, sequence);
+        }
+        cursor++;
+    }
+
+    bool match = (strcmp(tags, expected) == 0);
+    if (!match) {
+        fprintf(stderr, "ECHEC %-10s attendu \"%s\"\n"
+                        "                 reçu   \"%s\"\n", scenario, expected, tags);
+        failures++;
+    }
+    outputLength = 0;
+    output[0] = '\0';
+    return match;
+}
+
+/**
+ * @brief Plages contiguës d'un buffer circulaire à cheval sur sa fin
+ */
+static void Test_RingSpans(void)
+{
+    static const char *scenario = "ring.spans";
+    uint8_t storage[8];
+    Ring_Buffer ring;
+    const uint8_t *span;
+
+    Test_Check(!Ring_Buffer_Init(&ring, storage, 6), scenario, "taille non puissance de 2 refusée");
+    Test_Check(Ring_Buffer_Init(&ring, storage, sizeof(storage)), scenario, "initialisation");
+
+    Test_Check(Ring_Buffer_Write(&ring, (const uint8_t *)"abcdef", 6) == 6, scenario, "écriture");
+    Ring_Buffer_Consume(&ring, 6);
+    Test_Check(Ring_Buffer_Write(&ring, (const uint8_t *)"ghijk", 5) == 5, scenario, "écriture repliée");
+    Test_Check(Ring_Buffer_Count(&ring) == 5, scenario, "compte après repli");
+
+    Test_Check(Ring_Buffer_PeekSpan(&ring, &span) == 2 && memcmp(span, "gh", 2) == 0,
+               scenario, "première plage jusqu'à la fin de la zone");
+    Ring_Buffer_Consume(&ring, 2);
+    Test_Check(Ring_Buffer_PeekSpan(&ring, &span) == 3 && memcmp(span, "ijk", 3) == 0,
+               scenario, "seconde plage au début de la zone");
+
+    Test_Check(Ring_Buffer_Write(&ring, (const uint8_t *)"lmnopqr", 7) == 5, scenario, "écriture tronquée à la place libre");
+    Test_Check(Ring_Buffer_Space(&ring) == 0 && !Ring_Buffer_Push(&ring, 'x'), scenario, "buffer plein");
+    Ring_Buffer_Consume(&ring, 8);
+    Test_Check(Ring_Buffer_Count(&ring) == 0 && Ring_Buffer_PeekSpan(&ring, &span) == 0,
+               scenario, "buffer vidé");
+
+    /* Publication d'octets écrits directement (producteur DMA) */
+    memcpy(storage, "st", 2);
+    memcpy(storage + 6, "uv", 2);
+    Ring_Buffer_Reset(&ring);
+    Ring_Buffer_Commit(&ring, 6);
+    Ring_Buffer_Consume(&ring, 6);
+    Ring_Buffer_Commit(&ring, 4);
+    Test_Check(Ring_Buffer_PeekSpan(&ring, &span) == 2 && memcmp(span, "uv", 2) == 0,
+               scenario, "octets publiés, fin de la zone");
+    Ring_Buffer_Consume(&ring, 2);
+    Test_Check(Ring_Buffer_PeekSpan(&ring, &span) == 2 && memcmp(span, "st", 2) == 0,
+               scenario, "octets publiés, début de la zone");
+}
+
+/**
+ * @brief Lignes coupées par la fin du buffer DMA
+ * @note Chaque commande est lue par la boucle principale avant la suivante ;
+ *       celles qui franchissent la fin du buffer lui parviennent en deux
+ *       plages (fin du tour, puis début du suivant).
+ */
+static void Test_RxWrap(void)
+{
+    static const char *scenario = "rx.wrap";
+    char expected[TEST_TAGS_MAX * 12];
+    size_t expectedLength = 0;
+    char command[32];
+    UART_RxStats before;
+    UART_RxStats after;
+    uint32_t received = 0;
+    uint32_t straddles = 0;
+
+    UART_GetRxStats(&before);
+    for (unsigned int sequence = 1; sequence <= 100; sequence++) {
+        int length = snprintf(command, sizeof(command), "#%u LED%u ON\r", sequence, 1 + sequence % 3);
+        uint32_t offset = (before.bytes + received) % UART_RX_DMA_BUFFER_SIZE;
+
+        if (offset + (uint32_t)length > UART_RX_DMA_BUFFER_SIZE) {
+            straddles++;
+        }
+        received += (uint32_t)length;
+        Test_Arrive(command);
+        Test_Process();
+        expectedLength += (size_t)snprintf(expected + expectedLength, sizeof(expected) - expectedLength,
+                                           "%sOK#%u", (sequence > 1) ? " " : "", sequence);
+    }
+
+    UART_GetRxStats(&after);
+    Test_Check(straddles >= 2, scenario, "au moins deux lignes à cheval sur la fin du buffer");
+    Test_Check(after.bytes - before.bytes == received, scenario, "tous les octets transmis au parseur");
+    Test_Check(after.lost == before.lost && !UART_HasOverflow(), scenario, "aucune perte");
+    Test_ExpectTags(scenario, expected);
+}
+
+/**
+ * @brief Plus d'un tour de retard de la boucle principale
+ * @note Le DMA écrase les octets non lus : ils sont abandonnés, le
+ *       débordement est signalé et la réception reprend sur la ligne qui
+ *       suit le prochain retour chariot.
+ */
+static void Test_RxLap(void)
+{
+    static const char *scenario = "rx.lap";
+    char command[32];
+    UART_RxStats before;
+    UART_RxStats after;
+    uint32_t sent = 0;
+
+    UART_GetRxStats(&before);
+    for (unsigned int sequence = 200; sent <= UART_RX_DMA_BUFFER_SIZE + 64; sequence++) {
+        sent += (uint32_t)snprintf(command, sizeof(command), "#%u LED1 OFF\r", sequence);
+        Test_Arrive(command);
+    }
+    Test_Process();
+
+    UART_GetRxStats(&after);
+    Test_Check(after.lost - before.lost == sent, scenario, "tour écrasé compté comme perdu");
+    Test_Check(after.bytes == before.bytes, scenario, "rien de l'ancien tour transmis");
+    Test_Check(UART_HasOverflow(), scenario, "débordement signalé");
+    Test_Check(!UART_HasOverflow(), scenario, "débordement remis à zéro par sa lecture");
+    Test_ExpectTags(scenario, "");
+
+    Test_Arrive("#300 LED1 ON\r");
+    Test_Process();
+    Test_ExpectTags(scenario, "OK#300");
+}
+
+/**
+ * @brief Erreur de trame pendant la réception DMA
+ * @note La HAL arrête la réception : les octets reçus avant l'erreur,
+ *       publiés ou seulement écrits par le DMA, sont analysés ; la fin du
+ *       tour, qui contient encore d'anciennes commandes, n'est pas relue.
+ */
+static void Test_RxError(void)
+{
+    static const char *scenario = "rx.error";
+    UART_RxStats before;
+    UART_RxStats after;
+
+    UART_GetRxStats(&before);
+
+    /* Octets publiés (ligne inactive) mais pas encore lus */
+    Test_Arrive("#301 LED1 ON\r#302 LED2 ON\r");
+    Vboard_InjectError(HAL_UART_ERROR_FE);
+    Test_Arrive("#303 LED3 ON\r");
+    Test_Process();
+    Test_ExpectTags(scenario, "OK#301 OK#302 OK#303");
+
+    /* Octets écrits par le DMA, l'erreur survient avant la ligne inactive :
+     * la ligne interrompue se termine après la reprise */
+    Test_Send("#304 LED1 OFF\r#305 LED2");
+    while (Vboard_RxPending() != 0) {
+        HAL_GetTick();
+    }
+    Vboard_InjectError(HAL_UART_ERROR_NE);
+    Test_Arrive(" OFF\r");
+    Test_Process();
+    Test_ExpectTags(scenario, "OK#304 OK#305");
+
+    /* L'erreur arrive après la lecture : seul le saut reste à faire */
+    Test_Arrive("#306 LED3 OFF\r");
+    Test_Process();
+    Vboard_InjectError(HAL_UART_ERROR_PE);
+    Test_Process();
+    Test_Arrive("#307 LED1 ON\r");
+    Test_Process();
+    Test_ExpectTags(scenario, "OK#306 OK#307");
+
+    UART_GetRxStats(&after);
+    Test_Check(after.framing - before.framing == 1 && after.noise - before.noise == 1 &&
+               after.parity - before.parity == 1, scenario, "erreurs comptées");
+    Test_Check(after.lost == before.lost && !UART_HasOverflow(), scenario, "aucune perte");
+}
+
+/**
+ * @brief Deux erreurs avant le passage de la boucle principale
+ * @note Les octets reçus avant la première sont analysés ; ceux reçus
+ *       entre les deux sont abandonnés et signalés, la réception reprend
+ *       ensuite normalement.
+ */
+static void Test_RxDoubleError(void)
+{
+    static const char *scenario = "rx.error2";
+    UART_RxStats before;
+    UART_RxStats after;
+
+    UART_GetRxStats(&before);
+    Test_Arrive("#401 LED1 ON\r");
+    Vboard_InjectError(HAL_UART_ERROR_FE);
+    Test_Arrive("#402 LED2 ON\r");
+    Vboard_InjectError(HAL_UART_ERROR_FE);
+    Test_Process();
+    UART_GetRxStats(&after);
+    Test_Check(after.lost - before.lost == strlen("#402 LED2 ON\r"), scenario, "octets entre les erreurs perdus");
+    Test_Check(UART_HasOverflow(), scenario, "perte signalée");
+    Test_ExpectTags(scenario, "OK#401");
+
+    Test_Arrive("#403 LED3 ON\r");
+    Test_Process();
+    Test_ExpectTags(scenario, "OK#403");
+}
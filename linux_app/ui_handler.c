@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
 #include <termios.h>
 #include "ui_handler.h"
 #include "command_validator.h"
@@ -20,7 +21,9 @@
 static struct termios oldTermios;
 static const char *PROMPT = "STM32> ";
 static const char *APP_NAME = "Application Console STM32F756ZG";
-static const char *APP_VERSION = "1.0";
+static const char *APP_VERSION = "1.1";
+static char inputBuffer[256];      // Caractères saisis pas encore découpés en lignes
+static size_t inputLength = 0;
 
 /* Prototypes de fonctions privées */
 static void UI_SaveTerminalSettings(void);
@@ -64,10 +67,26 @@ void UI_DisplayHelp(void)
 {
     printf("Commandes disponibles:\n");
     printf("  LED<1-3> ON|OFF  : Controle une LED specifique.\n");
-    printf("  PAT<1-3>         : Demarre le chenillard N (utilise la frequence courante).\n");
+    printf("  LEDS <xxx>       : Regle les 3 LEDs en une fois (ex. LEDS 101 : LED1 et LED3).\n");
+    printf("  PAT<N>           : Demarre le chenillard N (utilise la frequence courante).\n");
+    printf("  PATLIST          : Liste les chenillards (1-3 predefinis, suivants charges).\n");
+    printf("  PATDEF<N> <0-7..>: Charge le chenillard N, un masque de LEDs par etape (ex. 1247).\n");
+    printf("  PATPROG<N> <off> <hex> : Charge un programme de chenillard (stm32_patc), PATPROG<N> END l'active.\n");
     printf("  FREQ<1-3>        : Definit la frequence (1:500ms, 2:1s, 3:3s) pour les chenillards.\n");
+    printf("  FREQ <ms>        : Definit une periode quelconque (1 a 60000 ms), sans a-coup en cours.\n");
+    printf("  PLAYBACK CPU|DMA : Chenillards joues par la boucle principale ou par TIM8 et le DMA.\n");
+    printf("  DIM<1-3> <0-255> : Regle la luminosite d'une LED (PWM, correction gamma).\n");
+    printf("  FADE<1-3> <niv> <ms> : Amene une LED a un niveau par un fondu de <ms> (0 a 60000).\n");
+    printf("  PATFADE ON|OFF   : Etapes des chenillards atteintes par un fondu (respiration).\n");
     printf("  STOP             : Arrete le chenillard actif.\n");
     printf("  STATUS           : Affiche l'etat des LEDs, du chenillard et de la frequence.\n");
+    printf("  LOAD             : Charge du STM32 (temps eveille, reveils) depuis le LOAD precedent.\n");
+    printf("  CLOCK [profil]   : Affiche ou change l'horloge du STM32 (LOW 16, BALANCED 96, FULL 216 MHz).\n");
+    printf("  CLOCK BENCH      : Mesure chaque profil (cycles d'analyse, latence IT, debit max).\n");
+    printf("  STATS            : Compteurs du STM32 depuis le demarrage (cle=valeur : octets, erreurs, commandes).\n");
+    printf("  PROFILE [RESET]  : Cycles des sondes du STM32 (appels, min/moy/max, histogramme) ou remise a zero.\n");
+    printf("  AT <t> <commande>: Programme une commande a t ms (absolu), +t (dans t ms) ou @t (apres AT GO).\n");
+    printf("  AT GO|CLEAR      : Declenche les commandes @t ou vide la ligne de temps ; AT l'affiche.\n");
     printf("  HELP             : Affiche cette aide.\n");
     printf("  CLEAR            : Efface l'ecran du terminal.\n");
     printf("  QUIT             : Quitte l'application.\n");
@@ -110,6 +129,75 @@ bool UI_ReadCommand(char *buffer, size_t size)
     return true;
 }
 
+/**
+ * @brief Lecture non bloquante des caractères disponibles sur l'entrée
+ * @return false si l'entrée standard est fermée (fin de fichier), true sinon
+ */
+bool UI_FillInput(void)
+{
+    if (inputLength >= sizeof(inputBuffer)) {
+        // Ligne trop longue : on la tronque pour ne pas bloquer la saisie
+        inputLength = 0;
+    }
+
+    ssize_t bytesRead = read(STDIN_FILENO, inputBuffer + inputLength, sizeof(inputBuffer) - inputLength);
+    if (bytesRead < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+    }
+    if (bytesRead == 0) {
+        return false;
+    }
+
+    inputLength += (size_t)bytesRead;
+    return true;
+}
+
+/**
+ * @brief Extraction de la prochaine commande complète saisie
+ * @param buffer Buffer pour stocker la commande
+ * @param size Taille du buffer
+ * @return true si une commande a été extraite, false sinon
+ */
+bool UI_NextCommand(char *buffer, size_t size)
+{
+    if (buffer == NULL || size == 0) {
+        return false;
+    }
+
+    char *newline = memchr(inputBuffer, '\n', inputLength);
+    if (newline == NULL) {
+        return false;
+    }
+
+    size_t lineLen = (size_t)(newline - inputBuffer);
+    size_t consumed = lineLen + 1;
+    if (lineLen > 0 && inputBuffer[lineLen - 1] == '\r') {
+        lineLen--;
+    }
+    if (lineLen > size - 1) {
+        lineLen = size - 1;
+    }
+    memcpy(buffer, inputBuffer, lineLen);
+    buffer[lineLen] = '\0';
+
+    memmove(inputBuffer, inputBuffer + consumed, inputLength - consumed);
+    inputLength -= consumed;
+    return true;
+}
+
+/**
+ * @brief Affichage d'un message spontané de la carte pendant la saisie
+ * @param message Message reçu hors réponse à une commande
+ */
+void UI_DisplayAsync(const char *message)
+{
+    if (message != NULL) {
+        // Effacement de la ligne du prompt puis réaffichage après le message
+        printf("\r\033[KCarte: %s\n%s", message, PROMPT);
+        fflush(stdout);
+    }
+}
+
 /**
  * @brief Affichage d'une réponse
  * @param response Réponse à afficher
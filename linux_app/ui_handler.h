@@ -12,6 +12,7 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * @brief Initialisation du module d'interface utilisateur
@@ -46,6 +47,31 @@ void UI_DisplayPrompt(void);
  */
 bool UI_ReadCommand(char *buffer, size_t size);
 
+/**
+ * @brief Lecture non bloquante des caractères disponibles sur l'entrée
+ * @note  A appeler quand la boucle d'événements signale l'entrée standard
+ *        prête ; les lignes complètes sont ensuite rendues par
+ *        UI_NextCommand().
+ * @return false si l'entrée standard est fermée (fin de fichier), true sinon
+ */
+bool UI_FillInput(void);
+
+/**
+ * @brief Extraction de la prochaine commande complète saisie
+ * @param buffer Buffer pour stocker la commande
+ * @param size Taille du buffer
+ * @return true si une commande a été extraite, false sinon
+ */
+bool UI_NextCommand(char *buffer, size_t size);
+
+/**
+ * @brief Affichage d'un message spontané de la carte pendant la saisie
+ * @note  La ligne du prompt est effacée, le message affiché, puis le prompt
+ *        est réaffiché.
+ * @param message Message reçu hors réponse à une commande
+ */
+void UI_DisplayAsync(const char *message);
+
 /**
  * @brief Affichage d'une réponse
  * @param response Réponse à afficher
@@ -0,0 +1,15 @@
+#ifndef VBOARD_HAL_GPIO_H
+#define VBOARD_HAL_GPIO_H
+
+/**
+ * @file gpio.h
+ * @brief Remplacement de gpio.h (CubeMX) pour la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Le port GPIOB est initialisé par led_controller.c : rien à configurer ici.
+ */
+
+#include "main.h"
+
+#endif /* VBOARD_HAL_GPIO_H */
@@ -0,0 +1,255 @@
+#ifndef VBOARD_HAL_MAIN_H
+#define VBOARD_HAL_MAIN_H
+
+/**
+ * @file main.h
+ * @brief Couche HAL de la carte virtuelle : cœur, GPIO, timers et UART émulés
+ * @author
+ * @date 07-04-2025
+ *
+ * Les modules du firmware incluent "main.h", qui tire toute la HAL STM32.
+ * La carte virtuelle place ce répertoire avant Core/Inc dans le chemin
+ * d'inclusion : les modules sont compilés sans modification pour Linux, et
+ * les types, registres et fonctions HAL qu'ils utilisent sont fournis ici
+ * et implémentés par vboard_hal.c.
+ *
+ * Les registres sont de simples structures en mémoire. Les accès qui ont
+ * un effet sur le matériel passent par une fonction :
+ * - GPIOB rend le port après avoir appliqué la dernière écriture de BSRR
+ *   sur ODR (mise à 1 et à 0 des sorties) ;
+ * - DWT rend le compteur de cycles recalculé d'après l'horloge virtuelle ;
+ * - __WFI attend la prochaine interruption émulée (tick de TIM2, octet
+ *   reçu, fin d'émission) et l'exécute.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Statut des fonctions HAL */
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+/* Cœur ----------------------------------------------------------------------*/
+extern uint32_t SystemCoreClock;
+
+/* Interruptions : un seul fil d'exécution, les interruptions émulées ne
+ * sont exécutées que dans __WFI et dans les attentes actives (HAL_GetTick) */
+#define __disable_irq()     ((void)0)
+#define __enable_irq()      ((void)0)
+#define __get_PRIMASK()     (0u)
+#define __set_PRIMASK(x)    ((void)(x))
+#define __DMB()             __asm__ volatile ("" ::: "memory")
+#define __DSB()             __asm__ volatile ("" ::: "memory")
+#define __ISB()             __asm__ volatile ("" ::: "memory")
+#define __CLZ(x)            ((uint8_t)((x) != 0 ? __builtin_clz(x) : 32))
+#define __WFI()             Vboard_WaitForInterrupt()
+
+void Vboard_WaitForInterrupt(void);
+
+/* Compteur de cycles (DWT) et déverrouillage (CoreDebug) */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+    volatile uint32_t LAR;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk        (1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk    (1u << 24)
+
+DWT_Type *Vboard_Dwt(void);
+extern CoreDebug_Type vboardCoreDebug;
+#define DWT         (Vboard_Dwt())
+#define CoreDebug   (&vboardCoreDebug)
+
+/* Interruptions (NVIC) : acceptées, sans effet */
+typedef enum {
+    USART3_IRQn = 39,
+    TIM2_IRQn = 28
+} IRQn_Type;
+
+#define HAL_NVIC_SetPriority(irq, pre, sub)  ((void)(irq), (void)(pre), (void)(sub))
+#define HAL_NVIC_EnableIRQ(irq)              ((void)(irq))
+
+/* Base de temps de la HAL (millisecondes de l'horloge virtuelle) */
+uint32_t HAL_GetTick(void);
+#define HAL_SuspendTick()   ((void)0)
+#define HAL_ResumeTick()    ((void)0)
+
+/* GPIO ----------------------------------------------------------------------*/
+typedef struct {
+    volatile uint32_t MODER;
+    volatile uint32_t OTYPER;
+    volatile uint32_t OSPEEDR;
+    volatile uint32_t PUPDR;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t LCKR;
+    volatile uint32_t AFR[2];
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0              ((uint16_t)0x0001)
+#define GPIO_PIN_7              ((uint16_t)0x0080)
+#define GPIO_PIN_14             ((uint16_t)0x4000)
+#define GPIO_MODE_OUTPUT_PP     0x00000001u
+#define GPIO_NOPULL             0x00000000u
+#define GPIO_SPEED_FREQ_LOW     0x00000000u
+#define GPIO_AF2_TIM3           ((uint8_t)0x02)
+#define GPIO_AF2_TIM4           ((uint8_t)0x02)
+#define GPIO_AF9_TIM12          ((uint8_t)0x09)
+
+GPIO_TypeDef *Vboard_GpioB(void);
+#define GPIOB   (Vboard_GpioB())
+
+#define __HAL_RCC_GPIOB_CLK_ENABLE()  ((void)0)
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+
+/* Timers --------------------------------------------------------------------*/
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t DIER;
+    volatile uint32_t SR;
+    volatile uint32_t EGR;
+    volatile uint32_t CNT;
+    volatile uint32_t PSC;
+    volatile uint32_t ARR;
+    volatile uint32_t CCR1;
+    volatile uint32_t CCR2;
+    volatile uint32_t CCR3;
+    volatile uint32_t CCR4;
+} TIM_TypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+} TIM_HandleTypeDef;
+
+extern TIM_TypeDef vboardTimers[5];
+#define TIM2    (&vboardTimers[0])
+#define TIM3    (&vboardTimers[1])
+#define TIM4    (&vboardTimers[2])
+#define TIM8    (&vboardTimers[3])
+#define TIM12   (&vboardTimers[4])
+
+#define TIM_CHANNEL_1   0x00000000u
+#define TIM_CHANNEL_2   0x00000004u
+#define TIM_CHANNEL_3   0x00000008u
+#define TIM_CHANNEL_4   0x0000000Cu
+#define TIM_EGR_UG      (1u << 0)
+
+#define __HAL_TIM_SET_COMPARE(handle, channel, compare) \
+    (((channel) == TIM_CHANNEL_1) ? ((handle)->Instance->CCR1 = (compare)) : \
+     ((channel) == TIM_CHANNEL_2) ? ((handle)->Instance->CCR2 = (compare)) : \
+     ((channel) == TIM_CHANNEL_3) ? ((handle)->Instance->CCR3 = (compare)) : \
+                                    ((handle)->Instance->CCR4 = (compare)))
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+
+/* DMA -----------------------------------------------------------------------*/
+/* Seul le compteur du flux de réception de l'UART est émulé */
+typedef struct {
+    uint32_t Reserved;
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(handle)   Vboard_DmaCounter(handle)
+
+uint32_t Vboard_DmaCounter(const DMA_HandleTypeDef *hdma);
+
+/* UART ----------------------------------------------------------------------*/
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t BRR;
+    volatile uint32_t ISR;
+} USART_TypeDef;
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    volatile uint32_t gState;
+    volatile uint32_t RxState;
+    volatile uint32_t ErrorCode;
+    DMA_HandleTypeDef *hdmarx;
+} UART_HandleTypeDef;
+
+extern USART_TypeDef vboardUsart3;
+#define USART3  (&vboardUsart3)
+
+#define UART_WORDLENGTH_8B      0x00000000u
+#define UART_STOPBITS_1         0x00000000u
+#define UART_PARITY_NONE        0x00000000u
+#define UART_MODE_TX_RX         0x0000000Cu
+#define UART_HWCONTROL_NONE     0x00000000u
+#define UART_OVERSAMPLING_16    0x00000000u
+#define UART_OVERSAMPLING_8     0x00008000u
+
+#define HAL_UART_STATE_RESET    0x00000000u
+#define HAL_UART_STATE_READY    0x00000020u
+#define HAL_UART_STATE_BUSY_TX  0x00000021u
+#define HAL_UART_STATE_BUSY_RX  0x00000022u
+
+#define HAL_UART_ERROR_NONE     0x00000000u
+#define HAL_UART_ERROR_PE       0x00000001u
+#define HAL_UART_ERROR_NE       0x00000002u
+#define HAL_UART_ERROR_FE       0x00000004u
+#define HAL_UART_ERROR_ORE      0x00000008u
+#define HAL_UART_ERROR_DMA      0x00000010u
+
+#define UART_FLAG_TC            (1u << 6)
+#define USART_CR1_UE            (1u << 0)
+
+#define UART_DIV_SAMPLING8(pclk, baud)   ((((pclk) * 2u) + ((baud) / 2u)) / (baud))
+#define UART_DIV_SAMPLING16(pclk, baud)  (((pclk) + ((baud) / 2u)) / (baud))
+
+#define __HAL_UART_ENABLE(handle)        ((handle)->Instance->CR1 |= USART_CR1_UE)
+#define __HAL_UART_DISABLE(handle)       ((handle)->Instance->CR1 &= ~USART_CR1_UE)
+#define __HAL_UART_GET_FLAG(handle, flag) (Vboard_UartFlags(handle) & (flag))
+
+uint32_t Vboard_UartFlags(const UART_HandleTypeDef *huart);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+#endif /* VBOARD_HAL_MAIN_H */
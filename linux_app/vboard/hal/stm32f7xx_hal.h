@@ -0,0 +1,15 @@
+#ifndef VBOARD_HAL_STM32F7XX_HAL_H
+#define VBOARD_HAL_STM32F7XX_HAL_H
+
+/**
+ * @file stm32f7xx_hal.h
+ * @brief Remplacement de l'en-tête HAL pour la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Les types et fonctions émulés sont fournis par le main.h de ce répertoire.
+ */
+
+#include "main.h"
+
+#endif /* VBOARD_HAL_STM32F7XX_HAL_H */
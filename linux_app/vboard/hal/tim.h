@@ -0,0 +1,21 @@
+#ifndef VBOARD_HAL_TIM_H
+#define VBOARD_HAL_TIM_H
+
+/**
+ * @file tim.h
+ * @brief Remplacement de tim.h (CubeMX) pour la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Les handles sont définis par vboard_hal.c avec leurs instances.
+ */
+
+#include "main.h"
+
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim4;
+extern TIM_HandleTypeDef htim8;
+extern TIM_HandleTypeDef htim12;
+
+#endif /* VBOARD_HAL_TIM_H */
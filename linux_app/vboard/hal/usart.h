@@ -0,0 +1,18 @@
+#ifndef VBOARD_HAL_USART_H
+#define VBOARD_HAL_USART_H
+
+/**
+ * @file usart.h
+ * @brief Remplacement de usart.h (CubeMX) pour la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Le handle est défini par vboard_hal.c ; la liaison série est émulée sur
+ * un pseudo-terminal.
+ */
+
+#include "main.h"
+
+extern UART_HandleTypeDef huart3;
+
+#endif /* VBOARD_HAL_USART_H */
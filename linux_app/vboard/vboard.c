@@ -0,0 +1,310 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#undef CR1      /* Délai de sortie de <termios.h>, homonyme du registre CR1 */
+#include "main.h"
+#include "Modules/command_parser.h"
+#include "Modules/event_flags.h"
+#include "Modules/module_wrappers.h"
+#include "Modules/uart_handler.h"
+#include "vboard.h"
+
+/**
+ * @file vboard.c
+ * @brief Carte virtuelle : le firmware exécuté sur l'hôte derrière un pseudo-terminal
+ * @author
+ * @date 07-04-2025
+ *
+ * Les modules du firmware (parseur de commandes, LED, chenillards, timers,
+ * UART, événements, profilage) sont compilés sans modification avec la HAL
+ * émulée de vboard/hal et vboard_hal.c. Ce fichier remplace main.c : il
+ * ouvre un pseudo-terminal, affiche le nom de son côté esclave (à donner à
+ * stm32_console) puis exécute la même initialisation et la même boucle
+ * principale que la carte.
+ *
+ * Le temps peut être accéléré (-x) ou remplacé par des événements discrets
+ * (-d, voir vboard_clock.c). Avec -b, la carte s'exécute sans
+ * pseudo-terminal : elle reçoit les commandes données par -c et écrit ses
+ * réponses sur la sortie standard. Les commandes -c sont envoyées comme
+ * par la console en mode pipeline : au plus VBOARD_COMMAND_WINDOW sans
+ * réponse complète ([END), pour ne jamais remplir la file du parseur
+ * (une commande de plus y serait perdue). Avec -t, elle s'arrête après
+ * une durée virtuelle : un chenillard de plusieurs minutes se vérifie
+ * ainsi en quelques millisecondes, toujours avec la même trace.
+ *
+ * Les deux modules propres au matériel (profils d'horloge, lecteur DMA des
+ * chenillards) sont remplacés par vboard_stubs.c.
+ */
+
+/* Constantes privées */
+#define VBOARD_MAX_COMMANDS 32      // Commandes données par -c
+#define VBOARD_COMMAND_WINDOW (COMMAND_QUEUE_DEPTH - 1) // Commandes -c sans réponse
+
+/* Fin d'une réponse, [END] ou [END#n] (les lignes vides n'en ont pas) */
+static const char REPLY_END[] = "[END";
+
+/* Initialisation de l'UART (uart_handler.c, déclarée comme dans main.c) */
+bool UART_Init(void);
+
+/* Variables privées */
+static char *linkPath = NULL;       // Lien symbolique vers le côté esclave
+static const char *commands[VBOARD_MAX_COMMANDS]; // Commandes -c
+static int commandCount = 0;
+static int commandsSent = 0;        // Commandes envoyées à la carte
+static int commandsPending = 0;     // Commandes envoyées sans réponse complète
+static size_t replyMatched = 0;     // Caractères de REPLY_END déjà reconnus
+
+/* Prototypes de fonctions privées */
+static void usage(const char *program);
+static int Vboard_OpenPty(int *slave);
+static void Vboard_RemoveLink(void);
+static void OnStopSignal(int signal);
+static void Vboard_SendCommands(void);
+static void Vboard_OnReply(const uint8_t *data, size_t length);
+
+/**
+ * @brief Point d'entrée de la carte virtuelle
+ * @param argc Nombre d'arguments
+ * @param argv Tableau des arguments
+ * @return Code de retour du programme
+ */
+int main(int argc, char *argv[])
+{
+    static const int STOP_SIGNALS[] = { SIGINT, SIGTERM, SIGHUP };
+    Vboard_ClockMode clockMode = VBOARD_CLOCK_REALTIME;
+    long factor = 1;
+    long durationMs = -1;
+    bool batch = false;
+    bool trace = false;
+    int master = -1;
+    int slave = -1;
+    int option;
+
+    while ((option = getopt(argc, argv, "l:vx:dt:bc:h")) != -1) {
+        switch (option) {
+            case 'l':
+                linkPath = optarg;
+                break;
+            case 'v':
+                trace = true;
+                break;
+            case 'x':
+                factor = atol(optarg);
+                if (factor < 1 || factor > 1000000) {
+                    fprintf(stderr, "Erreur: facteur entre 1 et 1000000\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'd':
+                clockMode = VBOARD_CLOCK_DISCRETE;
+                break;
+            case 't':
+                durationMs = atol(optarg);
+                if (durationMs < 0) {
+                    fprintf(stderr, "Erreur: duree invalide\n");
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b':
+                batch = true;
+                break;
+            case 'c':
+                if (commandCount == VBOARD_MAX_COMMANDS) {
+                    fprintf(stderr, "Erreur: au plus %d commandes\n", VBOARD_MAX_COMMANDS);
+                    return EXIT_FAILURE;
+                }
+                if (strlen(optarg) >= COMMAND_BUFFER_SIZE) {
+                    fprintf(stderr, "Erreur: commande de plus de %d caracteres\n", COMMAND_BUFFER_SIZE - 1);
+                    return EXIT_FAILURE;
+                }
+                commands[commandCount++] = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (!batch && (master = Vboard_OpenPty(&slave)) < 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (!batch && linkPath != NULL) {
+        unlink(linkPath);
+        if (symlink(ptsname(master), linkPath) != 0) {
+            fprintf(stderr, "Erreur: lien %s: %s\n", linkPath, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        atexit(Vboard_RemoveLink);
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = OnStopSignal;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < sizeof(STOP_SIGNALS) / sizeof(STOP_SIGNALS[0]); i++) {
+        sigaction(STOP_SIGNALS[i], &action, NULL);
+    }
+
+    if (!batch) {
+        printf("%s\n", (linkPath != NULL) ? linkPath : ptsname(master));
+        fflush(stdout);
+    }
+
+    Vboard_ClockSelect(clockMode, (uint32_t)factor);
+    Vboard_Init(master, batch ? STDOUT_FILENO : master, trace);
+    if (durationMs >= 0) {
+        Vboard_SetStopTime((uint64_t)durationMs * 1000000u);
+    }
+
+    /* Même séquence que main.c (USER CODE 2) */
+    CLOCK_Init();
+    EVENT_Init();
+    PROFILE_Init();
+    LED_Init();
+    PATTERN_Init();
+    TIMER_Init();
+    if (!UART_Init()) {
+        fprintf(stderr, "Erreur: initialisation de l'UART\n");
+        return EXIT_FAILURE;
+    }
+    COMMAND_Init();
+
+    UART_SendString("\r\n\r\n--- Console Serie STM32F756ZG ---\r\n");
+    UART_SendString("Tapez HELP pour la liste des commandes.\r\n");
+    UART_SendString("STM32> ");
+
+    /* Commandes -c : les premières dès le démarrage, les suivantes au fil
+     * des réponses */
+    Vboard_SetTxObserver(Vboard_OnReply);
+    Vboard_SendCommands();
+
+    /* Boucle principale ; un signal d'arrêt termine le programme dans
+     * l'attente (Vboard_WaitForInterrupt) */
+    (void)slave;
+    for (;;) {
+        uint32_t events = EVENT_Wait();
+
+        TIMER_Process();
+        if (events & EVENT_UART_RX) {
+            COMMAND_Process();
+        }
+        PATTERN_Process();
+    }
+}
+
+/**
+ * @brief Affichage de l'aide de la ligne de commande
+ * @param program Nom du programme
+ */
+static void usage(const char *program)
+{
+    printf("Usage: %s [-l lien] [-v] [-x facteur | -d] [-t ms] [-b] [-c commande]...\n", program);
+    printf("  -l lien     : lien symbolique vers le port série virtuel\n");
+    printf("  -v          : trace des LED sur la sortie d'erreur\n");
+    printf("  -x facteur  : temps réel accéléré (1 par défaut)\n");
+    printf("  -d          : événements discrets (temps virtuel, exécution reproductible)\n");
+    printf("  -t ms       : arrêt après cette durée virtuelle\n");
+    printf("  -b          : sans pseudo-terminal, réponses sur la sortie standard\n");
+    printf("  -c commande : commande envoyée au démarrage (répétable)\n");
+}
+
+/**
+ * @brief Création du pseudo-terminal de la liaison série
+ * @note Le côté esclave reste ouvert par la carte, en mode brut : le côté
+ *       maître ne voit pas de raccrochage entre deux sessions de la
+ *       console.
+ * @param slave Descripteur du côté esclave ouvert
+ * @return Descripteur du côté maître (non bloquant), -1 en cas d'erreur
+ */
+static int Vboard_OpenPty(int *slave)
+{
+    struct termios tio;
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("Erreur création pseudo-terminal");
+        return -1;
+    }
+
+    *slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (*slave < 0) {
+        perror("Erreur ouverture pseudo-terminal");
+        close(master);
+        return -1;
+    }
+    if (tcgetattr(*slave, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(*slave, TCSANOW, &tio);
+    }
+
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    return master;
+}
+
+/**
+ * @brief Suppression du lien symbolique à la sortie
+ */
+static void Vboard_RemoveLink(void)
+{
+    unlink(linkPath);
+}
+
+/**
+ * @brief Envoi des commandes -c tant que la fenêtre n'est pas pleine
+ * @note Une ligne vide n'a pas de réponse : elle n'occupe pas la fenêtre.
+ *       Les commandes tiennent dans la file de réception (au plus
+ *       VBOARD_COMMAND_WINDOW de moins de COMMAND_BUFFER_SIZE octets).
+ */
+static void Vboard_SendCommands(void)
+{
+    while (commandsSent < commandCount && commandsPending < VBOARD_COMMAND_WINDOW) {
+        const char *command = commands[commandsSent++];
+
+        Vboard_Inject((const uint8_t *)command, strlen(command));
+        Vboard_Inject((const uint8_t *)"\r", 1);
+        if (command[0] != '\0') {
+            commandsPending++;
+        }
+    }
+}
+
+/**
+ * @brief Lecture des réponses de la carte : chaque fin de réponse libère
+ *        une place de la fenêtre des commandes -c
+ * @param data Octets émis
+ * @param length Nombre d'octets
+ */
+static void Vboard_OnReply(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] == (uint8_t)REPLY_END[replyMatched]) {
+            replyMatched++;
+        } else {
+            replyMatched = (data[i] == (uint8_t)REPLY_END[0]) ? 1 : 0;
+        }
+        if (replyMatched == sizeof(REPLY_END) - 1) {
+            replyMatched = 0;
+            if (commandsPending > 0) {
+                commandsPending--;
+            }
+        }
+    }
+    Vboard_SendCommands();
+}
+
+/**
+ * @brief Gestionnaire des signaux d'arrêt
+ * @param signal Signal reçu
+ */
+static void OnStopSignal(int signal)
+{
+    (void)signal;
+    Vboard_RequestStop();
+}
@@ -0,0 +1,59 @@
+#ifndef VBOARD_H
+#define VBOARD_H
+
+/**
+ * @file vboard.h
+ * @brief En-tête interne de la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * La carte virtuelle exécute les modules du firmware sur l'hôte. Les
+ * périphériques utilisés (GPIOB, TIM2, USART3 et ses DMA) sont émulés par
+ * vboard_hal.c sur une horloge virtuelle (vboard_clock.c) ; la liaison
+ * série est le côté maître d'un pseudo-terminal, ouvert par vboard.c, ou
+ * la sortie standard en exécution sans pseudo-terminal.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define VBOARD_NS_PER_S     1000000000ull
+
+/* Durée d'un tick de TIM2 (base de temps du firmware) */
+#define VBOARD_TICK_NS      1000000ull
+
+/* Octets reçus en attente de leur instant d'arrivée sur la ligne */
+#define VBOARD_RX_QUEUE     4096
+
+/* Horloges virtuelles (vboard_clock.c) */
+typedef enum {
+    VBOARD_CLOCK_REALTIME = 0,  // Temps réel, multiplié par un facteur d'accélération
+    VBOARD_CLOCK_DISCRETE       // Événements discrets : saut à l'échéance suivante
+} Vboard_ClockMode;
+
+bool Vboard_ClockSelect(Vboard_ClockMode mode, uint32_t factor);
+uint64_t Vboard_Now(void);
+bool Vboard_ClockWait(uint64_t due, int fd);
+void Vboard_ClockSpin(uint64_t due);
+
+/* Raccordement de la liaison série émulée et trace des LED (stderr) */
+void Vboard_Init(int inFd, int outFd, bool traceLeds);
+
+/* Octets envoyés à la carte sans passer par le pseudo-terminal */
+bool Vboard_Inject(const uint8_t *data, size_t length);
+size_t Vboard_RxPending(void);
+
+/* Erreur signalée par l'UART pendant la réception (HAL_UART_ERROR_*) */
+void Vboard_InjectError(uint32_t errors);
+
+/* Octets émis par la carte, à la fin de chaque transfert (interruption) */
+typedef void (*Vboard_TxObserver)(const uint8_t *data, size_t length);
+void Vboard_SetTxObserver(Vboard_TxObserver observer);
+
+/* Fin de l'exécution à un instant virtuel, ou sur demande (signal) :
+ * prises en compte à la prochaine attente */
+void Vboard_SetStopTime(uint64_t ns);
+void Vboard_RequestStop(void);
+
+#endif /* VBOARD_H */
@@ -0,0 +1,179 @@
+#define _GNU_SOURCE
+#include <poll.h>
+#include <stddef.h>
+#include <time.h>
+#include "vboard.h"
+
+/**
+ * @file vboard_clock.c
+ * @brief Horloges virtuelles de la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Toutes les sources de temps vues par le firmware (HAL_GetTick, ticks de
+ * TIM2 qui alimentent HAL_TIM_PeriodElapsedCallback, compteur de cycles,
+ * durée des octets sur la ligne) sont calculées par vboard_hal.c à partir
+ * de Vboard_Now. L'horloge choisie au démarrage décide comment ce temps
+ * avance :
+ * - temps réel, éventuellement accéléré d'un facteur : le temps virtuel est
+ *   le temps écoulé multiplié par le facteur, les attentes sont réelles
+ *   (divisées par le facteur) ;
+ * - événements discrets : le temps virtuel ne bouge que lorsque le firmware
+ *   attend (__WFI, attente active sur HAL_GetTick), et saute alors
+ *   directement à l'échéance suivante. Le code du firmware s'exécute en un
+ *   temps nul ; une exécution ne dépend que de ses entrées et se reproduit
+ *   à l'identique, aussi vite que l'hôte peut enchaîner les échéances.
+ */
+
+/* Opérations d'une horloge */
+typedef struct {
+    uint64_t (*now)(void);                  // Temps virtuel (ns)
+    bool (*wait)(uint64_t due, int fd);     // Sommeil (__WFI)
+    void (*spin)(uint64_t due);             // Attente active (HAL_GetTick)
+} Vboard_ClockOps;
+
+/* Prototypes de fonctions privées */
+static uint64_t Clock_WallNs(void);
+static uint64_t Realtime_Now(void);
+static bool Realtime_Wait(uint64_t due, int fd);
+static void Realtime_Spin(uint64_t due);
+static uint64_t Discrete_Now(void);
+static bool Discrete_Wait(uint64_t due, int fd);
+static void Discrete_Spin(uint64_t due);
+
+/* Variables privées */
+static const Vboard_ClockOps realtimeClock = { Realtime_Now, Realtime_Wait, Realtime_Spin };
+static const Vboard_ClockOps discreteClock = { Discrete_Now, Discrete_Wait, Discrete_Spin };
+static const Vboard_ClockOps *clockOps = &realtimeClock;
+static uint64_t startNs = 0;                // Temps réel du démarrage
+static uint32_t speedFactor = 1;            // Accélération du temps réel
+static uint64_t virtualNs = 0;              // Temps des événements discrets
+
+/**
+ * @brief Choix et démarrage de l'horloge virtuelle (temps virtuel nul)
+ * @param mode Temps réel (accéléré) ou événements discrets
+ * @param factor Accélération du temps réel (1 : temps réel), ignorée en
+ *        événements discrets
+ * @return false si le facteur est nul
+ */
+bool Vboard_ClockSelect(Vboard_ClockMode mode, uint32_t factor)
+{
+    if (factor == 0) {
+        return false;
+    }
+
+    clockOps = (mode == VBOARD_CLOCK_DISCRETE) ? &discreteClock : &realtimeClock;
+    speedFactor = factor;
+    startNs = Clock_WallNs();
+    virtualNs = 0;
+    return true;
+}
+
+/**
+ * @brief Horloge virtuelle
+ * @return Nanosecondes de temps virtuel depuis Vboard_ClockSelect
+ */
+uint64_t Vboard_Now(void)
+{
+    return clockOps->now();
+}
+
+/**
+ * @brief Sommeil jusqu'à une échéance ou l'arrivée d'octets
+ * @param due Échéance (ns, UINT64_MAX : aucune)
+ * @param fd Descripteur surveillé en lecture (-1 : aucun)
+ * @return true si des octets sont lisibles sur fd
+ */
+bool Vboard_ClockWait(uint64_t due, int fd)
+{
+    return clockOps->wait(due, fd);
+}
+
+/**
+ * @brief Attente active du firmware (boucle sur HAL_GetTick)
+ * @param due Prochaine échéance, seule à pouvoir faire sortir la boucle
+ */
+void Vboard_ClockSpin(uint64_t due)
+{
+    clockOps->spin(due);
+}
+
+/**
+ * @brief Temps réel monotone
+ * @return Nanosecondes
+ */
+static uint64_t Clock_WallNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * VBOARD_NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t Realtime_Now(void)
+{
+    return (Clock_WallNs() - startNs) * speedFactor;
+}
+
+/**
+ * @brief Sommeil réel, raccourci du facteur d'accélération
+ */
+static bool Realtime_Wait(uint64_t due, int fd)
+{
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    struct timespec timeout;
+    uint64_t now = Realtime_Now();
+
+    if (due == UINT64_MAX) {
+        return ppoll(&pfd, 1, NULL, NULL) > 0;
+    }
+
+    uint64_t wait = (due > now) ? (due - now + speedFactor - 1) / speedFactor : 0;
+    timeout.tv_sec = (time_t)(wait / VBOARD_NS_PER_S);
+    timeout.tv_nsec = (long)(wait % VBOARD_NS_PER_S);
+    return ppoll(&pfd, 1, &timeout, NULL) > 0;
+}
+
+/**
+ * @brief Attente active : le temps réel avance de lui-même
+ */
+static void Realtime_Spin(uint64_t due)
+{
+    (void)due;
+}
+
+static uint64_t Discrete_Now(void)
+{
+    return virtualNs;
+}
+
+/**
+ * @brief Sommeil discret : saut à l'échéance
+ * @note Des octets déjà lisibles sont pris en compte au temps courant. Sans
+ *       échéance, seul un octet (ou un signal) peut faire avancer la carte.
+ */
+static bool Discrete_Wait(uint64_t due, int fd)
+{
+    struct pollfd pfd = { fd, POLLIN, 0 };
+
+    if (fd >= 0 && poll(&pfd, 1, 0) > 0) {
+        return true;
+    }
+    if (due == UINT64_MAX) {
+        return ppoll(&pfd, 1, NULL, NULL) > 0;
+    }
+    if (due > virtualNs) {
+        virtualNs = due;
+    }
+    return false;
+}
+
+/**
+ * @brief Attente active discrète : la boucle tournerait jusqu'à l'échéance
+ */
+static void Discrete_Spin(uint64_t due)
+{
+    if (due != UINT64_MAX && due > virtualNs) {
+        virtualNs = due;
+    }
+}
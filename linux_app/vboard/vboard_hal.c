@@ -0,0 +1,742 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "main.h"
+#include "tim.h"
+#include "usart.h"
+#include "Modules/clock_profile.h"
+#include "Modules/led_controller.h"
+#include "vboard.h"
+
+/**
+ * @file vboard_hal.c
+ * @brief Émulation des périphériques de la carte virtuelle
+ * @author
+ * @date 07-04-2025
+ *
+ * Les interruptions émulées ne sont exécutées qu'à deux endroits : dans
+ * __WFI (Event_Wait) et dans HAL_GetTick (attentes actives de
+ * UART_Flush). Le firmware garde donc un seul fil d'exécution, et une
+ * interruption n'est jamais servie au milieu d'une section que le firmware
+ * protège en masquant les interruptions.
+ *
+ * Chaque source d'interruption a une échéance sur l'horloge virtuelle ; les
+ * échéances atteintes sont servies dans l'ordre chronologique :
+ * - TIM2 : un tick par milliseconde (HAL_TIM_PeriodElapsedCallback) ;
+ * - USART3 en réception : chaque octet lu sur le pseudo-terminal arrive
+ *   sur la ligne un temps-octet (10 bits) après le précédent, puis est
+ *   écrit dans le buffer du DMA (événements mi-buffer, fin de buffer et
+ *   ligne inactive un temps-octet après le dernier octet), ou remis par
+ *   interruption avec UART_RX_USE_DMA à 0 ;
+ * - USART3 en émission : un transfert DMA dure sa longueur en temps-octets,
+ *   les octets sont écrits sur le pseudo-terminal à la fin du transfert.
+ *
+ * Le temps virtuel est fourni par l'horloge choisie au démarrage (voir
+ * vboard_clock.c) : temps réel, temps réel accéléré ou événements
+ * discrets.
+ */
+
+/* Constantes privées */
+#define VBOARD_BITS_PER_BYTE  10u           // Start, 8 bits de données, stop
+#define VBOARD_TX_MAX         65536u        // Plus long transfert DMA (16 bits)
+
+/* Sources d'interruption émulées */
+typedef enum {
+    SOURCE_NONE = 0,
+    SOURCE_TICK,        // Débordement de TIM2
+    SOURCE_RX_BYTE,     // Octet reçu complet sur la ligne
+    SOURCE_RX_IDLE,     // Ligne de réception inactive
+    SOURCE_TX_DONE      // Fin du transfert DMA d'émission
+} Vboard_Source;
+
+/* Octet en cours de réception et instant de sa fin sur la ligne */
+typedef struct {
+    uint8_t byte;
+    uint64_t doneNs;
+} Vboard_RxByte;
+
+/* Broche d'une LED et canal PWM associé (voir led_controller.c) */
+typedef struct {
+    const char *name;
+    uint32_t position;          // Numéro de broche sur GPIOB
+    volatile uint32_t *ccr;     // Rapport cyclique en fonction alternative
+} Vboard_Led;
+
+/* Registres et handles des périphériques */
+uint32_t SystemCoreClock = 16000000u;
+CoreDebug_Type vboardCoreDebug;
+TIM_TypeDef vboardTimers[5];
+USART_TypeDef vboardUsart3;
+
+TIM_HandleTypeDef htim2 = { TIM2 };
+TIM_HandleTypeDef htim3 = { TIM3 };
+TIM_HandleTypeDef htim4 = { TIM4 };
+TIM_HandleTypeDef htim8 = { TIM8 };
+TIM_HandleTypeDef htim12 = { TIM12 };
+UART_HandleTypeDef huart3;
+
+/* Variables privées */
+static int rxFd = -1;                       // Octets envoyés à la carte (-1 : aucun)
+static int txFd = -1;                       // Octets émis par la carte
+static bool traceLeds = false;              // Trace des LED sur stderr
+static volatile sig_atomic_t stopRequested = 0;
+static uint64_t stopNs = UINT64_MAX;        // Fin de l'exécution (temps virtuel)
+static bool inInterrupt = false;            // Interruption émulée en cours
+
+static DWT_Type dwt;
+static uint64_t dwtStampNs = 0;             // Dernière mise à jour de CYCCNT
+static uint64_t dwtRemainder = 0;           // Fraction de cycle reportée
+
+static GPIO_TypeDef gpioB;
+
+static Vboard_Led leds[] = {
+    { "LED1", 0,  &vboardTimers[1].CCR3 },  // PB0 : TIM3_CH3
+    { "LED2", 7,  &vboardTimers[2].CCR2 },  // PB7 : TIM4_CH2
+    { "LED3", 14, &vboardTimers[4].CCR1 },  // PB14 : TIM12_CH1
+};
+#define VBOARD_LED_COUNT (sizeof(leds) / sizeof(leds[0]))
+static int tracedLevels[VBOARD_LED_COUNT] = { -1, -1, -1 }; // Dernier état affiché
+
+static bool tickRunning = false;
+static uint64_t nextTickNs = 0;
+
+static Vboard_RxByte rxQueue[VBOARD_RX_QUEUE]; // Octets lus pas encore arrivés
+static uint32_t rxQueueHead = 0;            // Index libres (modulo la taille)
+static uint32_t rxQueueTail = 0;
+static uint64_t rxLineFreeNs = 0;           // Fin du dernier octet en réception
+static uint8_t *rxData = NULL;              // Buffer de la réception armée
+static uint16_t rxSize = 0;
+static uint16_t rxPosition = 0;             // Position d'écriture du DMA
+static bool rxCircular = false;             // DMA circulaire (sinon interruption)
+static bool rxIdlePending = false;
+static uint64_t rxIdleNs = 0;
+
+static uint8_t txData[VBOARD_TX_MAX];       // Copie du transfert en cours
+static uint16_t txLength = 0;
+static uint64_t txDoneNs = 0;
+static uint64_t txLineFreeNs = 0;           // Fin du dernier octet émis
+static Vboard_TxObserver txObserver = NULL; // Lecteur des octets émis
+
+/* Prototypes de fonctions privées */
+static uint64_t Vboard_ByteNs(void);
+static Vboard_Source Vboard_NextEvent(uint64_t *due);
+static bool Vboard_ServiceInterrupts(void);
+static void Vboard_Fire(Vboard_Source source, uint64_t due);
+static void Vboard_ReceiveByte(uint8_t byte, uint64_t doneNs);
+static void Vboard_FinishTransmit(void);
+static void Vboard_PollUart(void);
+static void Vboard_QueueRx(const uint8_t *data, size_t length);
+static void Vboard_TraceLeds(void);
+
+/**
+ * @brief Raccordement de la liaison série émulée
+ * @note L'horloge virtuelle doit être choisie avant (Vboard_ClockSelect).
+ * @param inFd Octets reçus par la carte, lu sans bloquer (-1 : aucun)
+ * @param outFd Octets émis par la carte
+ * @param trace true pour tracer chaque changement des LED sur stderr
+ */
+void Vboard_Init(int inFd, int outFd, bool trace)
+{
+    rxFd = inFd;
+    txFd = outFd;
+    traceLeds = trace;
+}
+
+/**
+ * @brief Envoi d'octets à la carte, à partir du temps virtuel courant
+ * @note Les octets arrivent au rythme de la liaison, après ceux déjà en
+ *       cours de réception.
+ * @param data Octets
+ * @param length Nombre d'octets (au plus la place de la file de réception)
+ * @return false si la file de réception est pleine
+ */
+bool Vboard_Inject(const uint8_t *data, size_t length)
+{
+    if (length > VBOARD_RX_QUEUE - (rxQueueHead - rxQueueTail)) {
+        return false;
+    }
+    Vboard_QueueRx(data, length);
+    return true;
+}
+
+/**
+ * @brief Octets envoyés à la carte et pas encore arrivés sur la ligne
+ * @return Nombre d'octets en attente
+ */
+size_t Vboard_RxPending(void)
+{
+    return (size_t)(rxQueueHead - rxQueueTail);
+}
+
+/**
+ * @brief Erreur de réception (bruit, trame, parité, débordement)
+ * @note Comme la HAL en réception DMA, la réception est arrêtée puis
+ *       HAL_UART_ErrorCallback est appelé ; les octets déjà écrits par le
+ *       DMA restent dans le buffer et le compteur garde sa valeur.
+ * @param errors Combinaison de HAL_UART_ERROR_*
+ */
+void Vboard_InjectError(uint32_t errors)
+{
+    huart3.ErrorCode = errors;
+    if (rxData != NULL && rxCircular) {
+        HAL_UART_AbortReceive(&huart3);
+    }
+    HAL_UART_ErrorCallback(&huart3);
+    huart3.ErrorCode = HAL_UART_ERROR_NONE;
+}
+
+/**
+ * @brief Lecteur des octets émis par la carte
+ * @note Appelé à la fin de chaque transfert, dans l'interruption émulée :
+ *       il peut envoyer d'autres octets à la carte (Vboard_Inject).
+ * @param observer Lecteur (NULL : aucun)
+ */
+void Vboard_SetTxObserver(Vboard_TxObserver observer)
+{
+    txObserver = observer;
+}
+
+/**
+ * @brief Fin de l'exécution à un instant virtuel
+ * @param ns Temps virtuel (UINT64_MAX : jamais)
+ */
+void Vboard_SetStopTime(uint64_t ns)
+{
+    stopNs = ns;
+}
+
+/**
+ * @brief Demande d'arrêt, appelable depuis un gestionnaire de signal
+ */
+void Vboard_RequestStop(void)
+{
+    stopRequested = 1;
+}
+
+/**
+ * @brief Sommeil jusqu'à la prochaine interruption émulée (__WFI)
+ * @note Sert les interruptions échues ; s'il n'y en a aucune, laisse
+ *       l'horloge attendre la prochaine échéance ou l'arrivée d'octets. Une
+ *       demande d'arrêt ou l'instant de fin (Vboard_SetStopTime) termine le
+ *       programme.
+ */
+void Vboard_WaitForInterrupt(void)
+{
+    Vboard_TraceLeds();
+
+    for (;;) {
+        if (stopRequested || Vboard_Now() >= stopNs) {
+            exit(EXIT_SUCCESS);
+        }
+
+        Vboard_PollUart();
+        if (Vboard_ServiceInterrupts()) {
+            Vboard_TraceLeds();
+            return;
+        }
+
+        uint64_t due;
+        bool queueFull = (rxQueueHead - rxQueueTail) >= VBOARD_RX_QUEUE;
+
+        Vboard_NextEvent(&due);
+        if (due > stopNs) {
+            due = stopNs;
+        }
+        Vboard_ClockWait(due, queueFull ? -1 : rxFd);
+    }
+}
+
+/**
+ * @brief Base de temps de la HAL
+ * @note Seules les attentes actives du firmware (UART_Flush) l'appellent :
+ *       l'horloge avance jusqu'à la prochaine échéance (événements
+ *       discrets) et les interruptions échues sont servies, l'attente voit
+ *       l'émission progresser.
+ * @return Millisecondes de l'horloge virtuelle
+ */
+uint32_t HAL_GetTick(void)
+{
+    uint64_t due;
+
+    if (!inInterrupt && Vboard_NextEvent(&due) != SOURCE_NONE) {
+        Vboard_ClockSpin(due);
+    }
+    Vboard_ServiceInterrupts();
+    return (uint32_t)(Vboard_Now() / 1000000u);
+}
+
+/**
+ * @brief Compteur de cycles, avancé d'après l'horloge virtuelle
+ * @note CYCCNT compte à SystemCoreClock tant que CYCCNTENA est actif ; le
+ *       firmware peut l'écrire (remise à zéro par Event_Init).
+ * @return Registres du DWT
+ */
+DWT_Type *Vboard_Dwt(void)
+{
+    uint64_t now = Vboard_Now();
+
+    if (dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) {
+        uint64_t delta = now - dwtStampNs;
+        uint64_t fraction = (delta % VBOARD_NS_PER_S) * SystemCoreClock + dwtRemainder;
+        uint64_t cycles = (delta / VBOARD_NS_PER_S) * SystemCoreClock + fraction / VBOARD_NS_PER_S;
+
+        dwt.CYCCNT += (uint32_t)cycles;
+        dwtRemainder = fraction % VBOARD_NS_PER_S;
+    }
+    dwtStampNs = now;
+    return &dwt;
+}
+
+/**
+ * @brief Port GPIOB
+ * @note L'écriture précédente dans BSRR est d'abord appliquée à ODR (la
+ *       mise à 1 l'emporte sur la mise à 0, comme sur le STM32).
+ * @return Registres du port
+ */
+GPIO_TypeDef *Vboard_GpioB(void)
+{
+    uint32_t bsrr = gpioB.BSRR;
+
+    if (bsrr != 0) {
+        gpioB.ODR = (gpioB.ODR & ~(bsrr >> 16)) | (bsrr & 0xFFFFu);
+        gpioB.BSRR = 0;
+    }
+    return &gpioB;
+}
+
+/**
+ * @brief Configuration de broches (mode seulement)
+ */
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+{
+    for (uint32_t position = 0; position < 16; position++) {
+        if (init->Pin & (1u << position)) {
+            uint32_t shift = position * 2u;
+            port->MODER = (port->MODER & ~(3u << shift)) | ((init->Mode & 3u) << shift);
+        }
+    }
+}
+
+/**
+ * @brief Lecture d'une broche (une sortie relit son état ODR)
+ */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin)
+{
+    (void)Vboard_GpioB();
+    return (port->ODR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+ * @brief Démarrage d'un timer avec interruption de mise à jour
+ * @note Seul TIM2 (base de temps de timer_handler.c) produit des ticks.
+ */
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 |= 1u;
+    if (htim->Instance == TIM2 && !tickRunning) {
+        tickRunning = true;
+        nextTickNs = Vboard_Now() + VBOARD_TICK_NS;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Démarrage d'un canal PWM (le rapport cyclique est lu dans CCRx)
+ */
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+    (void)channel;
+    htim->Instance->CR1 |= 1u;
+    return HAL_OK;
+}
+
+/**
+ * @brief Drapeaux de l'UART lus par le firmware
+ * @return UART_FLAG_TC si aucun transfert n'est en cours
+ */
+uint32_t Vboard_UartFlags(const UART_HandleTypeDef *huart)
+{
+    return (huart->gState == HAL_UART_STATE_BUSY_TX) ? 0 : UART_FLAG_TC;
+}
+
+/**
+ * @brief Compteur du DMA de réception (NDTR)
+ * @note Comme sur le STM32, le compteur garde sa valeur après l'arrêt de la
+ *       réception.
+ * @return Octets restants avant la fin du tour en cours
+ */
+uint32_t Vboard_DmaCounter(const DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    return (uint32_t)(rxSize - rxPosition);
+}
+
+/**
+ * @brief Horloge du bus APB1 (USART3) du profil actif
+ */
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return Clock_GetInfo(Clock_GetProfile())->pclk1Hz;
+}
+
+/**
+ * @brief Initialisation de l'UART
+ */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+    if (huart == NULL || huart->Instance == NULL || huart->Init.BaudRate == 0) {
+        return HAL_ERROR;
+    }
+
+    huart->Instance->CR1 |= USART_CR1_UE;
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    return HAL_OK;
+}
+
+/**
+ * @brief Réception par DMA circulaire avec détection de ligne inactive
+ */
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    if (huart->RxState != HAL_UART_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (data == NULL || size == 0) {
+        return HAL_ERROR;
+    }
+
+    rxData = data;
+    rxSize = size;
+    rxPosition = 0;
+    rxCircular = true;
+    rxIdlePending = false;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+/**
+ * @brief Réception d'un bloc par interruption
+ */
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    if (huart->RxState != HAL_UART_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (data == NULL || size == 0) {
+        return HAL_ERROR;
+    }
+
+    rxData = data;
+    rxSize = size;
+    rxPosition = 0;
+    rxCircular = false;
+    rxIdlePending = false;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    return HAL_OK;
+}
+
+/**
+ * @brief Émission par DMA
+ * @note Le transfert commence à la fin du précédent sur la ligne et dure sa
+ *       longueur en temps-octets.
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+    if (huart->gState != HAL_UART_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (data == NULL || size == 0) {
+        return HAL_ERROR;
+    }
+
+    uint64_t now = Vboard_Now();
+    uint64_t start = (txLineFreeNs > now) ? txLineFreeNs : now;
+
+    memcpy(txData, data, size);
+    txLength = size;
+    txDoneNs = start + (uint64_t)size * Vboard_ByteNs();
+    txLineFreeNs = txDoneNs;
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    return HAL_OK;
+}
+
+/**
+ * @brief Arrêt de la réception
+ */
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
+{
+    rxData = NULL;
+    rxIdlePending = false;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+/**
+ * @brief Callbacks par défaut (faibles, comme dans la HAL) : le firmware ne
+ *        définit que ceux du mode de réception compilé
+ */
+__attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size)
+{
+    (void)huart;
+    (void)size;
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+/**
+ * @brief Durée d'un octet sur la ligne au débit configuré
+ * @return Nanosecondes
+ */
+static uint64_t Vboard_ByteNs(void)
+{
+    uint32_t baud = huart3.Init.BaudRate ? huart3.Init.BaudRate : 115200u;
+    return (VBOARD_BITS_PER_BYTE * VBOARD_NS_PER_S + baud / 2) / baud;
+}
+
+/**
+ * @brief Prochaine interruption émulée
+ * @param due Échéance (ns) de l'interruption trouvée
+ * @return Source, SOURCE_NONE si aucune interruption n'est prévue
+ */
+static Vboard_Source Vboard_NextEvent(uint64_t *due)
+{
+    Vboard_Source source = SOURCE_NONE;
+
+    *due = UINT64_MAX;
+    if (tickRunning && nextTickNs < *due) {
+        *due = nextTickNs;
+        source = SOURCE_TICK;
+    }
+    if (rxQueueHead != rxQueueTail && rxQueue[rxQueueTail % VBOARD_RX_QUEUE].doneNs < *due) {
+        *due = rxQueue[rxQueueTail % VBOARD_RX_QUEUE].doneNs;
+        source = SOURCE_RX_BYTE;
+    }
+    if (rxIdlePending && rxIdleNs < *due) {
+        *due = rxIdleNs;
+        source = SOURCE_RX_IDLE;
+    }
+    if (huart3.gState == HAL_UART_STATE_BUSY_TX && txDoneNs < *due) {
+        *due = txDoneNs;
+        source = SOURCE_TX_DONE;
+    }
+    return source;
+}
+
+/**
+ * @brief Exécution des interruptions échues, dans l'ordre chronologique
+ * @return true si au moins une interruption a été servie
+ */
+static bool Vboard_ServiceInterrupts(void)
+{
+    bool fired = false;
+    uint64_t now;
+    uint64_t due;
+    Vboard_Source source;
+
+    if (inInterrupt) {
+        return false;
+    }
+
+    inInterrupt = true;
+    now = Vboard_Now();
+    while ((source = Vboard_NextEvent(&due)) != SOURCE_NONE && due <= now) {
+        Vboard_Fire(source, due);
+        fired = true;
+    }
+    inInterrupt = false;
+    return fired;
+}
+
+/**
+ * @brief Exécution d'une interruption
+ * @param source Source de l'interruption
+ * @param due Échéance de l'interruption
+ */
+static void Vboard_Fire(Vboard_Source source, uint64_t due)
+{
+    switch (source) {
+    case SOURCE_TICK:
+        nextTickNs = due + VBOARD_TICK_NS;
+        HAL_TIM_PeriodElapsedCallback(&htim2);
+        break;
+
+    case SOURCE_RX_BYTE: {
+        Vboard_RxByte *entry = &rxQueue[rxQueueTail % VBOARD_RX_QUEUE];
+        rxQueueTail++;
+        Vboard_ReceiveByte(entry->byte, entry->doneNs);
+        break;
+    }
+
+    case SOURCE_RX_IDLE:
+        rxIdlePending = false;
+        if (rxData != NULL && rxCircular && rxPosition != 0) {
+            HAL_UARTEx_RxEventCallback(&huart3, rxPosition);
+        }
+        break;
+
+    case SOURCE_TX_DONE:
+        Vboard_FinishTransmit();
+        break;
+
+    case SOURCE_NONE:
+        break;
+    }
+}
+
+/**
+ * @brief Arrivée d'un octet complet dans le registre de réception
+ * @note Sans réception armée, l'octet est perdu (interruptions de
+ *       réception désactivées par la HAL).
+ * @param byte Octet reçu
+ * @param doneNs Fin de l'octet sur la ligne
+ */
+static void Vboard_ReceiveByte(uint8_t byte, uint64_t doneNs)
+{
+    if (rxData == NULL || huart3.RxState != HAL_UART_STATE_BUSY_RX) {
+        return;
+    }
+
+    rxData[rxPosition++] = byte;
+
+    if (!rxCircular) {
+        if (rxPosition == rxSize) {
+            rxData = NULL;
+            huart3.RxState = HAL_UART_STATE_READY;
+            HAL_UART_RxCpltCallback(&huart3);
+        }
+        return;
+    }
+
+    rxIdlePending = true;
+    rxIdleNs = doneNs + Vboard_ByteNs();
+    if (rxPosition == rxSize / 2) {
+        HAL_UARTEx_RxEventCallback(&huart3, rxPosition);
+    } else if (rxPosition == rxSize) {
+        rxPosition = 0;
+        HAL_UARTEx_RxEventCallback(&huart3, rxSize);
+    }
+}
+
+/**
+ * @brief Fin du transfert DMA d'émission
+ * @note Les octets sont écrits sur le pseudo-terminal ; si personne ne les
+ *       lit et que le pseudo-terminal est plein, ils sont perdus comme sur
+ *       une ligne série sans contrôle de flux.
+ */
+static void Vboard_FinishTransmit(void)
+{
+    size_t written = 0;
+
+    while (written < txLength) {
+        ssize_t result = write(txFd, txData + written, txLength - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        written += (size_t)result;
+    }
+    if (txObserver != NULL) {
+        txObserver(txData, txLength);
+    }
+
+    huart3.gState = HAL_UART_STATE_READY;
+    HAL_UART_TxCpltCallback(&huart3);
+}
+
+/**
+ * @brief Lecture des octets envoyés à la carte (pseudo-terminal)
+ */
+static void Vboard_PollUart(void)
+{
+    uint8_t buffer[256];
+    uint32_t space = VBOARD_RX_QUEUE - (rxQueueHead - rxQueueTail);
+
+    while (rxFd >= 0 && space > 0) {
+        size_t request = (space < sizeof(buffer)) ? space : sizeof(buffer);
+        ssize_t count = read(rxFd, buffer, request);
+        if (count <= 0) {
+            break;
+        }
+        Vboard_QueueRx(buffer, (size_t)count);
+        space -= (uint32_t)count;
+    }
+}
+
+/**
+ * @brief Mise en file d'octets reçus
+ * @note Chaque octet reçoit l'instant de sa fin sur la ligne : au plus tôt
+ *       un temps-octet après le temps courant, et après l'octet précédent.
+ * @param data Octets
+ * @param length Nombre d'octets (la place est vérifiée par l'appelant)
+ */
+static void Vboard_QueueRx(const uint8_t *data, size_t length)
+{
+    uint64_t now = Vboard_Now();
+    uint64_t byteNs = Vboard_ByteNs();
+
+    for (size_t i = 0; i < length; i++) {
+        uint64_t start = (rxLineFreeNs > now) ? rxLineFreeNs : now;
+        Vboard_RxByte *entry = &rxQueue[rxQueueHead % VBOARD_RX_QUEUE];
+        entry->byte = data[i];
+        entry->doneNs = start + byteNs;
+        rxLineFreeNs = entry->doneNs;
+        rxQueueHead++;
+    }
+}
+
+/**
+ * @brief Trace des changements d'état des LED (option -v)
+ * @note Une broche en sortie est allumée ou éteinte ; une broche en
+ *       fonction alternative affiche le rapport cyclique de son canal PWM.
+ */
+static void Vboard_TraceLeds(void)
+{
+    if (!traceLeds) {
+        return;
+    }
+
+    GPIO_TypeDef *port = Vboard_GpioB();
+    bool changed = false;
+    int levels[VBOARD_LED_COUNT];
+
+    for (size_t i = 0; i < VBOARD_LED_COUNT; i++) {
+        uint32_t mode = (port->MODER >> (leds[i].position * 2u)) & 3u;
+        if (mode == 2u) {
+            uint32_t ccr = *leds[i].ccr;
+            levels[i] = (int)(((ccr > LED_PWM_MAX) ? LED_PWM_MAX : ccr) * 100u / LED_PWM_MAX);
+        } else {
+            levels[i] = (port->ODR & (1u << leds[i].position)) ? 100 : 0;
+        }
+        if (levels[i] != tracedLevels[i]) {
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+
+    uint64_t now = Vboard_Now();
+    fprintf(stderr, "[%6llu.%06llu]", (unsigned long long)(now / VBOARD_NS_PER_S),
+            (unsigned long long)((now % VBOARD_NS_PER_S) / 1000u));
+    for (size_t i = 0; i < VBOARD_LED_COUNT; i++) {
+        tracedLevels[i] = levels[i];
+        uint32_t mode = (port->MODER >> (leds[i].position * 2u)) & 3u;
+        if (mode == 2u) {
+            fprintf(stderr, " %s %3d%%", leds[i].name, levels[i]);
+        } else {
+            fprintf(stderr, " %s %s", leds[i].name, levels[i] ? " ON " : " OFF");
+        }
+    }
+    fprintf(stderr, "\n");
+}
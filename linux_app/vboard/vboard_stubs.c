@@ -0,0 +1,140 @@
+#include <string.h>
+#include "main.h"
+#include "Modules/clock_profile.h"
+#include "Modules/dma_player.h"
+#include "Modules/event_flags.h"
+#include "Modules/uart_handler.h"
+
+/**
+ * @file vboard_stubs.c
+ * @brief Remplacements des modules du firmware propres au matériel
+ * @author
+ * @date 07-04-2025
+ *
+ * Deux modules restent propres au matériel et sont remplacés ici, pour la
+ * carte virtuelle comme pour le banc bench_micro :
+ * - clock_profile.c : les profils ne changent que SystemCoreClock (compteur
+ *   de cycles) et le diviseur de l'UART ; CLOCK BENCH n'est pas disponible ;
+ * - dma_player.c : DMA_Player_Start échoue, les chenillards sont joués par
+ *   le timer logiciel (repli prévu par pattern_controller.c).
+ */
+
+/* Profils d'horloge (fréquences de clock_profile.c) */
+static const Clock_ProfileInfo clockProfiles[CLOCK_PROFILE_COUNT] = {
+    [CLOCK_PROFILE_LOW]      = { "LOW", 16000000u, 16000000u, 16000000u, 0, 3, false },
+    [CLOCK_PROFILE_BALANCED] = { "BALANCED", 96000000u, 48000000u, 96000000u, 3, 3, false },
+    [CLOCK_PROFILE_FULL]     = { "FULL", 216000000u, 54000000u, 108000000u, 7, 1, true },
+};
+
+/* Variables privées */
+static Clock_Profile activeProfile = CLOCK_PROFILE_LOW;
+
+/**
+ * @brief Initialisation des profils d'horloge (profil LOW)
+ */
+void Clock_Init(void)
+{
+    activeProfile = CLOCK_PROFILE_LOW;
+    SystemCoreClock = clockProfiles[activeProfile].sysclkHz;
+}
+
+/**
+ * @brief Changement de profil d'horloge
+ * @note Comme sur la carte : émission vidée, diviseur de l'UART recalculé
+ *       et fenêtre de mesure des événements recommencée.
+ */
+bool Clock_SetProfile(Clock_Profile profile)
+{
+    if (profile >= CLOCK_PROFILE_COUNT) {
+        return false;
+    }
+    if (profile == activeProfile) {
+        return true;
+    }
+
+    UART_Flush();
+    activeProfile = profile;
+    SystemCoreClock = clockProfiles[profile].sysclkHz;
+    UART_UpdateBaudRate();
+    Event_ResetStats();
+    return true;
+}
+
+Clock_Profile Clock_GetProfile(void)
+{
+    return activeProfile;
+}
+
+const Clock_ProfileInfo* Clock_GetInfo(Clock_Profile profile)
+{
+    return (profile < CLOCK_PROFILE_COUNT) ? &clockProfiles[profile] : NULL;
+}
+
+bool Clock_FindProfile(const char *name, Clock_Profile *profile)
+{
+    for (uint32_t i = 0; i < CLOCK_PROFILE_COUNT; i++) {
+        if (strcmp(name, clockProfiles[i].name) == 0) {
+            *profile = (Clock_Profile)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t Clock_GetTimerClock(const TIM_TypeDef *instance)
+{
+    return (instance == TIM8) ? clockProfiles[activeProfile].pclk2Hz
+                              : clockProfiles[activeProfile].pclk1Hz;
+}
+
+/**
+ * @brief Caches et accélérateur ART : absents sur l'hôte
+ */
+uint32_t Clock_GetAccelerators(void)
+{
+    return 0;
+}
+
+/**
+ * @brief CLOCK BENCH : mesures propres au matériel, non disponibles
+ */
+bool Clock_Benchmark(Clock_Workload workload, uint32_t lineLength,
+                     Clock_BenchResult results[CLOCK_PROFILE_COUNT])
+{
+    (void)workload;
+    (void)lineLength;
+    (void)results;
+    return false;
+}
+
+void Clock_IsrProbe(void)
+{
+}
+
+/**
+ * @brief Lecteur DMA des chenillards : absent, repli sur le timer logiciel
+ */
+bool DMA_Player_Start(const uint32_t *words, uint8_t length,
+                      volatile uint32_t *target, uint32_t periodMs)
+{
+    (void)words;
+    (void)length;
+    (void)target;
+    (void)periodMs;
+    return false;
+}
+
+void DMA_Player_Stop(void)
+{
+}
+
+bool DMA_Player_SetPeriod(uint32_t periodMs)
+{
+    (void)periodMs;
+    return false;
+}
+
+bool DMA_Player_IsRunning(void)
+{
+    return false;
+}